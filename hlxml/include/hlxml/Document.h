@@ -14,6 +14,7 @@
 #define HLXML_DOCUMENT_H
 
 #include <hltypes/hltypesUtil.h>
+#include <hltypes/hmappedfile.h>
 #include <hltypes/hsbase.h>
 #include <hltypes/hstring.h>
 #include <hltypes/hmap.h>
@@ -37,10 +38,14 @@ namespace hlxml
 		/// @brief Constructor
 		/// @param[in] filename Filename where to read from.
 		/// @param[in] fromResource Whether the file is a resource or not.
-		Document(chstr filename, bool fromResource = true);
+		/// @param[in] useAtoms Whether Node names and property names are interned as hatom.
+		/// @note With useAtoms, properties are stored in Node::atomProperties instead of Node::properties.
+		Document(chstr filename, bool fromResource = true, bool useAtoms = false);
 		/// @brief Constructor
 		/// @param[in] stream Stream where to read from.
-		Document(hsbase& stream);
+		/// @param[in] useAtoms Whether Node names and property names are interned as hatom.
+		/// @note With useAtoms, properties are stored in Node::atomProperties instead of Node::properties.
+		Document(hsbase& stream, bool useAtoms = false);
 		/// @brief Destructor
 		~Document();
 
@@ -49,18 +54,23 @@ namespace hlxml
 
 		/// @brief Gets the root Node of the Document.
 		/// @param[in] name Optional node name check.
+		/// @note The raw data is released once the Nodes are created, so a mapped file is only kept open until then.
 		/// @note Throws an exception if type is not an empty String and the root Node is not of that type.
 		Node* root(chstr name = "");
 
 	protected:
 		/// @brief Raw data of the Document.
 		char* data;
+		/// @brief Mapped file that data points into when parsing directly from the mapping.
+		hmappedfile* mappedFile;
 		/// @brief Filename of the Document.
 		hstr filename;
 		/// @brief Real filename of the Document, used for exception prints.
 		hstr realFilename;
 		/// @brief Whether data is read from a resource or not.
 		bool fromResource;
+		/// @brief Whether Node names and property names are interned.
+		bool useAtoms;
 		/// @brief The underlying document object.
 		void* document;
 		/// @brief The root Node of the Document.
@@ -70,8 +80,15 @@ namespace hlxml
 		/// @param[in] stream XML data stream.
 		/// @param[in] realFilename The logical filename (used for error printing).
 		void _setup(hsbase& stream, chstr realFilename);
+		/// @brief Maps a file for later parsing.
+		/// @param[in] filename Name of the file.
+		/// @note The pages are mapped copy-on-write, because the XML is parsed in place.
+		void _setupMapped(chstr filename);
 		/// @brief Parses the XML.
 		void _parse();
+		/// @brief Releases the parsed document and the raw data.
+		/// @note The mapped file is closed as well.
+		void _release();
 
 	};
 }
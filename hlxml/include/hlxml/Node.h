@@ -13,6 +13,7 @@
 #ifndef HLXML_NODE_H
 #define HLXML_NODE_H
 
+#include <hltypes/hatom.h>
 #include <hltypes/henum.h>
 #include <hltypes/hmap.h>
 #include <hltypes/hstring.h>
@@ -49,13 +50,13 @@ namespace hlxml
 		));
 
 		/// @brief Name of the Node.
+		/// @note Empty if the Document uses atoms, nameAtom is set instead.
+		/// @see getName
 		hstr name;
 		/// @brief Value of the Node.
 		hstr value;
 		/// @brief Type of the Node.
 		Type type;
-		/// @brief Filename when the Node's Document.
-		hstr filename;
 		/// @brief Line number where the node is located in the Document.
 		int line;
 		/// @brief Properties within the Node.
@@ -64,6 +65,24 @@ namespace hlxml
 		/// @brief Children of this Node.
 		/// @note Exposed for optimized access.
 		harray<Node*> children;
+		/// @brief Interned name of the Node.
+		/// @note Only set if the Document uses atoms, empty otherwise.
+		hatom nameAtom;
+		/// @brief Properties within the Node with interned names.
+		/// @note Only used if the Document uses atoms, properties is empty in that case.
+		/// @note Exposed for optimized access.
+		hmap<hatom, hstr> atomProperties;
+
+		/// @brief Gets the name of the Node.
+		/// @return The name.
+		/// @note Works whether the Document uses atoms or not.
+		inline hstr getName() const
+		{
+			return (this->useAtoms ? this->nameAtom.toString() : this->name);
+		}
+		/// @brief Gets the filename of the Node's Document.
+		/// @return The filename.
+		hstr getFilename() const;
 
 		/// @brief Gets a given property value as bool.
 		/// @param[in] propertyName Name of the property.
@@ -71,11 +90,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline bool pbool(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (bool)this->properties[propertyName];
+			return (bool)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as bool.
 		/// @param[in] propertyName Name of the property.
@@ -83,7 +98,8 @@ namespace hlxml
 		/// @return Bool value of the property.
 		inline bool pbool(chstr propertyName, bool defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (bool)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (bool)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as int8.
 		/// @param[in] propertyName Name of the property.
@@ -91,11 +107,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline char pint8(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (char)(int)this->properties[propertyName];
+			return (char)(int)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as int8.
 		/// @param[in] propertyName Name of the property.
@@ -103,7 +115,8 @@ namespace hlxml
 		/// @return Int8 value of the property.
 		inline char pint8(chstr propertyName, char defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (char)(int)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (char)(int)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as uint8.
 		/// @param[in] propertyName Name of the property.
@@ -111,11 +124,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline unsigned char puint8(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (unsigned char)(int)this->properties[propertyName];
+			return (unsigned char)(int)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as uint8.
 		/// @param[in] propertyName Name of the property.
@@ -123,7 +132,8 @@ namespace hlxml
 		/// @return Uint8 value of the property.
 		inline unsigned char puint8(chstr propertyName, unsigned char defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (unsigned char)(int)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (unsigned char)(int)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as int16.
 		/// @param[in] propertyName Name of the property.
@@ -131,11 +141,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline short pint16(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (short)this->properties[propertyName];
+			return (short)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as int16.
 		/// @param[in] propertyName Name of the property.
@@ -143,7 +149,8 @@ namespace hlxml
 		/// @return Int16 value of the property.
 		inline short pint16(chstr propertyName, short defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (short)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (short)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as uint16.
 		/// @param[in] propertyName Name of the property.
@@ -151,11 +158,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline unsigned short puint16(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (unsigned short)this->properties[propertyName];
+			return (unsigned short)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as uint16.
 		/// @param[in] propertyName Name of the property.
@@ -163,7 +166,8 @@ namespace hlxml
 		/// @return Uint16 value of the property.
 		inline unsigned short puint16(chstr propertyName, unsigned short defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (unsigned short)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (unsigned short)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as int32.
 		/// @param[in] propertyName Name of the property.
@@ -171,11 +175,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline int pint32(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (int)this->properties[propertyName];
+			return (int)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as int32.
 		/// @param[in] propertyName Name of the property.
@@ -183,7 +183,8 @@ namespace hlxml
 		/// @return Int32 value of the property.
 		inline int pint32(chstr propertyName, int defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (int)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (int)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as uint32.
 		/// @param[in] propertyName Name of the property.
@@ -191,11 +192,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline unsigned int puint32(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (unsigned int)this->properties[propertyName];
+			return (unsigned int)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as uint32.
 		/// @param[in] propertyName Name of the property.
@@ -203,7 +200,8 @@ namespace hlxml
 		/// @return Uint32 value of the property.
 		inline unsigned int puint32(chstr propertyName, unsigned int defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (unsigned int)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (unsigned int)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as int64.
 		/// @param[in] propertyName Name of the property.
@@ -211,11 +209,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline int64_t pint64(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (int64_t)this->properties[propertyName];
+			return (int64_t)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as int64.
 		/// @param[in] propertyName Name of the property.
@@ -223,7 +217,8 @@ namespace hlxml
 		/// @return Int64 value of the property.
 		inline int64_t pint64(chstr propertyName, int64_t defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (int64_t)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (int64_t)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as uint64.
 		/// @param[in] propertyName Name of the property.
@@ -231,11 +226,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline uint64_t puint64(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (uint64_t)this->properties[propertyName];
+			return (uint64_t)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as uint64.
 		/// @param[in] propertyName Name of the property.
@@ -243,7 +234,8 @@ namespace hlxml
 		/// @return Uint64 value of the property.
 		inline uint64_t puint64(chstr propertyName, uint64_t defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (uint64_t)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (uint64_t)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as float.
 		/// @param[in] propertyName Name of the property.
@@ -251,11 +243,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline float pfloat(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (float)this->properties[propertyName];
+			return (float)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as float.
 		/// @param[in] propertyName Name of the property.
@@ -263,7 +251,8 @@ namespace hlxml
 		/// @return Float value of the property.
 		inline float pfloat(chstr propertyName, float defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (float)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (float)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as double.
 		/// @param[in] propertyName Name of the property.
@@ -271,11 +260,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline double pdouble(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return (double)this->properties[propertyName];
+			return (double)this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as double.
 		/// @param[in] propertyName Name of the property.
@@ -283,7 +268,8 @@ namespace hlxml
 		/// @return Double value of the property.
 		inline double pdouble(chstr propertyName, double defaultValue)
 		{
-			return (this->properties.hasKey(propertyName) ? (double)this->properties[propertyName] : defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (double)(*value) : defaultValue);
 		}
 		/// @brief Gets a given property value as String.
 		/// @param[in] propertyName Name of the property.
@@ -291,11 +277,7 @@ namespace hlxml
 		/// @note Throws an exception if not found.
 		inline hstr pstr(chstr propertyName)
 		{
-			if (!this->properties.hasKey(propertyName))
-			{
-				throw XMLPropertyNotExistsException(propertyName, this);
-			}
-			return this->properties[propertyName];
+			return this->_getProperty(propertyName);
 		}
 		/// @brief Gets a given property value as String.
 		/// @param[in] propertyName Name of the property.
@@ -303,7 +285,8 @@ namespace hlxml
 		/// @return String value of the property.
 		inline hstr pstr(chstr propertyName, chstr defaultValue)
 		{
-			return this->properties.tryGet(propertyName, defaultValue);
+			const hstr* value = this->_findProperty(propertyName);
+			return (value != NULL ? (*value) : defaultValue);
 		}
 
 		/// @brief Checks if a property exists.
@@ -311,10 +294,26 @@ namespace hlxml
 		/// @return True if the property exists.
 		inline bool pexists(chstr propertyName)
 		{
-			return this->properties.hasKey(propertyName);
+			return (this->_findProperty(propertyName) != NULL);
 		}
 
 	protected:
+		/// @brief The Document this Node belongs to.
+		/// @note The filename is shared through the Document instead of being stored in every Node.
+		Document* document;
+		/// @brief Whether names are stored as atoms.
+		bool useAtoms;
+
+		/// @brief Finds a property value.
+		/// @param[in] propertyName Name of the property.
+		/// @return Pointer to the value or NULL if the property does not exist.
+		const hstr* _findProperty(chstr propertyName);
+		/// @brief Gets a property value.
+		/// @param[in] propertyName Name of the property.
+		/// @return The value.
+		/// @note Throws an exception if not found.
+		const hstr& _getProperty(chstr propertyName);
+
 		/// @brief Constructor.
 		/// @param[in] document The Document this Node belongs to.
 		/// @param[in] node The underlying node object.
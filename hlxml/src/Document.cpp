@@ -8,8 +8,8 @@
 
 #include <hltypes/hdir.h>
 #include <hltypes/hexception.h>
-#include <hltypes/hfile.h>
 #include <hltypes/hlog.h>
+#include <hltypes/hmappedfile.h>
 #include <hltypes/hrdir.h>
 #include <hltypes/hresource.h>
 #include <hltypes/hstring.h>
@@ -27,14 +27,17 @@ namespace hlxml
 {
 	hstr logTag = "hlxml";
 
-	Document::Document(chstr filename, bool fromResource) : data(NULL), document(NULL), rootNode(NULL)
+	Document::Document(chstr filename, bool fromResource, bool useAtoms) : data(NULL), mappedFile(NULL), document(NULL), rootNode(NULL)
 	{
 		this->filename = filename;
 		this->fromResource = fromResource;
+		this->useAtoms = useAtoms;
 	}
 
-	Document::Document(hsbase& stream) : data(NULL), document(NULL), rootNode(NULL)
+	Document::Document(hsbase& stream, bool useAtoms) : data(NULL), mappedFile(NULL), document(NULL), rootNode(NULL)
 	{
+		this->fromResource = false;
+		this->useAtoms = useAtoms;
 		int64_t position = stream.position();
 		this->_setup(stream, "stream");
 		stream.seek(position, hseek::Start);
@@ -46,14 +49,7 @@ namespace hlxml
 		{
 			delete this->rootNode;
 		}
-		if (this->document != NULL)
-		{
-			delete RAPIDXML_DOCUMENT;
-		}
-		if (this->data != NULL)
-		{
-			delete[] this->data;
-		}
+		this->_release();
 	}
 
 	void Document::_setup(hsbase& stream, chstr realFilename)
@@ -65,6 +61,32 @@ namespace hlxml
 		this->realFilename = realFilename;
 	}
 
+	void Document::_setupMapped(chstr filename)
+	{
+		this->mappedFile = new hmappedfile();
+		try
+		{
+			this->mappedFile->open(filename, true);
+		}
+		catch (hexception&)
+		{
+			delete this->mappedFile;
+			this->mappedFile = NULL;
+			throw;
+		}
+		if (this->mappedFile->isNullTerminated())
+		{
+			this->data = (char*)this->mappedFile->getData();
+			this->realFilename = hdir::normalize(filename);
+		}
+		else // rapidxml needs a terminating character, so the data has to be copied after all
+		{
+			this->_setup(*this->mappedFile, hdir::normalize(filename));
+			delete this->mappedFile;
+			this->mappedFile = NULL;
+		}
+	}
+
 	void Document::_parse()
 	{
 		if (this->data == NULL)
@@ -77,9 +99,7 @@ namespace hlxml
 			}
 			else
 			{
-				hfile file;
-				file.open(this->filename);
-				this->_setup(file, hdir::normalize(this->filename));
+				this->_setupMapped(this->filename);
 			}
 		}
 		this->document = new rapidxml::xml_document<char>();
@@ -96,21 +116,42 @@ namespace hlxml
 		}
 	}
 
-	Node* Document::root(chstr name)
+	void Document::_release()
 	{
-		if (this->document == NULL)
+		if (this->document != NULL)
 		{
-			this->_parse();
+			delete RAPIDXML_DOCUMENT;
+			this->document = NULL;
+		}
+		if (this->mappedFile != NULL)
+		{
+			delete this->mappedFile;
+			this->mappedFile = NULL;
 		}
+		else if (this->data != NULL)
+		{
+			delete[] this->data;
+		}
+		this->data = NULL;
+	}
+
+	Node* Document::root(chstr name)
+	{
 		if (this->rootNode == NULL)
 		{
+			if (this->document == NULL)
+			{
+				this->_parse();
+			}
 			rapidxml::xml_node<char>* rapidXmlNode = RAPIDXML_DOCUMENT->first_node();
 			if (rapidXmlNode == NULL)
 			{
 				throw XMLException("No root node found in XML file '" + this->filename + "'!", NULL);
 			}
 			this->rootNode = new Node(this, rapidXmlNode);
-			if (name != "" && this->rootNode->name != name)
+			// the Nodes have their own copies of all data so a mapped file doesn't stay open (and locked on Windows) during the Document's lifetime
+			this->_release();
+			if (name != "" && this->rootNode->getName() != name)
 			{
 				throw XMLException("Root node type is not '" + name + "' in XML file '" + this->filename + "'!", NULL);
 			}
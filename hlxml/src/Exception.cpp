@@ -17,7 +17,7 @@ namespace hlxml
 	_XMLException::_XMLException(chstr message, Node* node, const char* file, int line) :
 		hexception("", file, line)
 	{
-		this->_setInternalMessage((node == NULL ? message : message + ", in file " + node->filename + ", line " + hstr(node->line)), file, line);
+		this->_setInternalMessage((node == NULL ? message : message + ", in file " + node->getFilename() + ", line " + hstr(node->line)), file, line);
 	}
 
 }
@@ -6,6 +6,7 @@
 /// This program is free software; you can redistribute it and/or modify it under
 /// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
 
+#include <hltypes/hatom.h>
 #include <hltypes/hmap.h>
 #include <hltypes/hstring.h>
 
@@ -16,7 +17,6 @@
 #include "Exception.h"
 #include "Node.h"
 
-#define RAPIDXML_DOCUMENT ((rapidxml::xml_document<char>*)this->document)
 #define RAPIDXML_NODE(node) ((rapidxml::xml_node<char>*)node)
 
 namespace hlxml
@@ -28,13 +28,19 @@ namespace hlxml
 		HL_ENUM_DEFINE(Node::Type, Text);
 	));
 
-	Node::Node(Document* document, void* node) : line(0)
+	Node::Node(Document* document, void* node) : line(0), document(document), useAtoms(document->useAtoms)
 	{
 		rapidxml::xml_node<char>* rapidXmlNode = RAPIDXML_NODE(node);
-		this->name = hstr(rapidXmlNode->name(), (int)rapidXmlNode->name_size());
+		if (this->useAtoms)
+		{
+			this->nameAtom = hatom(rapidXmlNode->name(), (int)rapidXmlNode->name_size());
+		}
+		else
+		{
+			this->name = hstr(rapidXmlNode->name(), (int)rapidXmlNode->name_size());
+		}
 		this->value = hstr(rapidXmlNode->value(), (int)rapidXmlNode->value_size());
 		this->type = Type::Element;
-		this->filename = document->getFilename();
 		//this->line = 0;
 		rapidxml::node_type type = rapidXmlNode->type();
 		if (type == rapidxml::node_element && this->value != "")
@@ -45,9 +51,19 @@ namespace hlxml
 		{
 			this->type = Type::Comment;
 		}
-		for (rapidxml::xml_attribute<char>* attr = rapidXmlNode->first_attribute(); attr != NULL; attr = attr->next_attribute())
+		if (this->useAtoms)
+		{
+			for (rapidxml::xml_attribute<char>* attr = rapidXmlNode->first_attribute(); attr != NULL; attr = attr->next_attribute())
+			{
+				this->atomProperties[hatom(attr->name(), (int)attr->name_size())] = hstr(attr->value(), (int)attr->value_size());
+			}
+		}
+		else
 		{
-			this->properties[hstr(attr->name(), (int)attr->name_size())] = hstr(attr->value(), (int)attr->value_size());
+			for (rapidxml::xml_attribute<char>* attr = rapidXmlNode->first_attribute(); attr != NULL; attr = attr->next_attribute())
+			{
+				this->properties[hstr(attr->name(), (int)attr->name_size())] = hstr(attr->value(), (int)attr->value_size());
+			}
 		}
 		for (rapidxml::xml_node<char>* child = rapidXmlNode->first_node(); child != NULL; child = child->next_sibling())
 		{
@@ -63,4 +79,36 @@ namespace hlxml
 		}
 	}
 
+	hstr Node::getFilename() const
+	{
+		return this->document->getFilename();
+	}
+
+	const hstr* Node::_findProperty(chstr propertyName)
+	{
+		if (this->useAtoms)
+		{
+			// find() doesn't intern, names that were never interned can't be a property anyway
+			hatom atom;
+			if (!hatom::find(propertyName, atom))
+			{
+				return NULL;
+			}
+			hmap<hatom, hstr>::iterator_t it = this->atomProperties.find(atom);
+			return (it != this->atomProperties.end() ? &it->second : NULL);
+		}
+		hmap<hstr, hstr>::iterator_t it = this->properties.find(propertyName);
+		return (it != this->properties.end() ? &it->second : NULL);
+	}
+
+	const hstr& Node::_getProperty(chstr propertyName)
+	{
+		const hstr* value = this->_findProperty(propertyName);
+		if (value == NULL)
+		{
+			throw XMLPropertyNotExistsException(propertyName, this);
+		}
+		return (*value);
+	}
+
 }
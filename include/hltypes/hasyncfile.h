@@ -0,0 +1,284 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides asynchronous file reading and writing on background threads.
+
+#ifndef HLTYPES_ASYNC_FILE_H
+#define HLTYPES_ASYNC_FILE_H
+
+#include "harray.h"
+#include "hdeque.h"
+#include "henum.h"
+#include "hltypesUtil.h"
+#include "hmutex.h"
+#include "hstream.h"
+#include "hstring.h"
+
+#include "hltypesExport.h"
+
+/// @brief Default number of AsyncFile I/O threads.
+#define HL_ASYNC_FILE_THREAD_COUNT 4
+
+namespace hltypes
+{
+	class Semaphore;
+	class Thread;
+
+	/// @brief A single asynchronous file operation that works like a future.
+	/// @note Poll isDone() or call wait() and then get the result from getStream().
+	/// @note The AsyncRequest belongs to the caller and has to be deleted. Deleting an unfinished AsyncRequest cancels it or waits for it.
+	/// @note The callback may delete the AsyncRequest. The AsyncRequest is already done while the callback runs, so when a callback is used, it should
+	/// only be deleted in the callback or after the callback has returned.
+	class hltypesExport AsyncRequest
+	{
+	public:
+		friend class AsyncFile;
+
+		/// @class Type
+		/// @brief Defines the type of the operation.
+		HL_ENUM_CLASS_PREFIX_DECLARE(hltypesExport, Type,
+		(
+			/// @var static const Type Type::Read
+			/// @brief Reads a file.
+			HL_ENUM_DECLARE(Type, Read);
+			/// @var static const Type Type::ReadResource
+			/// @brief Reads a resource file.
+			HL_ENUM_DECLARE(Type, ReadResource);
+			/// @var static const Type Type::Write
+			/// @brief Writes a file.
+			HL_ENUM_DECLARE(Type, Write);
+			/// @var static const Type Type::Append
+			/// @brief Appends to a file.
+			HL_ENUM_DECLARE(Type, Append);
+			/// @var static const Type Type::Copy
+			/// @brief Copies a file.
+			HL_ENUM_DECLARE(Type, Copy);
+		));
+
+		/// @class State
+		/// @brief Defines the state of the operation.
+		HL_ENUM_CLASS_PREFIX_DECLARE(hltypesExport, State,
+		(
+			/// @var static const State State::Queued
+			/// @brief Waiting for an I/O thread.
+			HL_ENUM_DECLARE(State, Queued);
+			/// @var static const State State::Running
+			/// @brief Being processed by an I/O thread.
+			HL_ENUM_DECLARE(State, Running);
+			/// @var static const State State::Completed
+			/// @brief Finished successfully.
+			HL_ENUM_DECLARE(State, Completed);
+			/// @var static const State State::Failed
+			/// @brief Finished with an error.
+			HL_ENUM_DECLARE(State, Failed);
+			/// @var static const State State::Cancelled
+			/// @brief Cancelled before it was processed.
+			HL_ENUM_DECLARE(State, Cancelled);
+		));
+
+		/// @brief Destructor.
+		/// @note Cancels the operation if it's still queued or waits for it if it's running.
+		~AsyncRequest();
+
+		/// @brief Gets the type of the operation.
+		HL_DEFINE_GET(Type, type, Type);
+		/// @brief Gets the filename.
+		HL_DEFINE_GET(String, filename, Filename);
+		/// @brief Gets the name of the new file when copying.
+		HL_DEFINE_GET(String, newFilename, NewFilename);
+		/// @brief Gets the error message if the operation failed.
+		HL_DEFINE_GET(String, errorMessage, ErrorMessage);
+		/// @brief Gets the user data.
+		HL_DEFINE_GET(void*, userData, UserData);
+		/// @brief Gets the state of the operation.
+		/// @return The state of the operation.
+		State getState() const;
+		/// @brief Gets the read data or the data that is written.
+		/// @return The read data or the data that is written.
+		/// @note Only safe to access after the operation is done.
+		inline Stream& getStream() { return this->stream; }
+
+		/// @brief Checks whether the operation is done.
+		/// @return True if the operation completed, failed or was cancelled.
+		bool isDone() const;
+		/// @brief Checks whether the operation completed successfully.
+		/// @return True if the operation completed successfully.
+		bool isCompleted() const;
+		/// @brief Waits until the operation is done.
+		/// @param[in] timeout Maximum time to wait in milliseconds. 0 waits indefinitely.
+		/// @return True if the operation is done.
+		bool wait(float timeout = 0.0f);
+		/// @brief Cancels the operation.
+		/// @return True if the operation was still queued and has been cancelled.
+		/// @note Operations that are already running can't be cancelled.
+		bool cancel();
+
+	protected:
+		/// @brief The type of the operation.
+		Type type;
+		/// @brief The filename.
+		String filename;
+		/// @brief The name of the new file when copying.
+		String newFilename;
+		/// @brief Whether an existing file is overwritten when copying.
+		bool overwrite;
+		/// @brief Whether the file times are preserved when copying.
+		bool preserveTimes;
+		/// @brief The state of the operation.
+		State state;
+		/// @brief Whether an I/O thread is still using the AsyncRequest.
+		bool busy;
+		/// @brief Unlocked by the I/O thread when it stops using the AsyncRequest while the destructor waits for it.
+		Semaphore* idleSemaphore;
+		/// @brief The read data or the data that is written.
+		Stream stream;
+		/// @brief The error message if the operation failed.
+		String errorMessage;
+		/// @brief Function called on the I/O thread after the operation completed or failed.
+		void (*callback)(AsyncRequest*);
+		/// @brief User data for the callback.
+		void* userData;
+
+		/// @brief Basic constructor.
+		/// @param[in] type The type of the operation.
+		/// @param[in] filename The filename.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		AsyncRequest(Type type, const String& filename, void (*callback)(AsyncRequest*), void* userData);
+
+		/// @brief Executes the operation.
+		/// @note Called on an I/O thread. The AsyncRequest isn't busy anymore when the callback is called.
+		void _execute();
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		AsyncRequest(const AsyncRequest& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		AsyncRequest& operator=(AsyncRequest& other);
+
+	};
+
+	/// @brief Queues file operations for a pool of I/O threads so the calling thread never blocks on the file system.
+	/// @note The I/O threads are started with the first queued operation and block while there is nothing to do.
+	/// @note Callbacks are called on the I/O threads, not on the thread that queued the operation.
+	class hltypesExport AsyncFile
+	{
+	public:
+		friend class AsyncRequest;
+
+		/// @brief Gets the number of I/O threads.
+		/// @return The number of I/O threads.
+		static int getThreadCount();
+		/// @brief Sets the number of I/O threads.
+		/// @param[in] value The number of I/O threads.
+		/// @note Takes effect when the I/O threads are started the next time.
+		static void setThreadCount(int value);
+		/// @brief Gets the number of operations that are waiting for an I/O thread.
+		/// @return The number of queued operations.
+		static int getQueuedCount();
+
+		/// @brief Queues reading a file.
+		/// @param[in] filename Name of the file.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation.
+		static AsyncRequest* readAsync(const String& filename, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Queues reading multiple files at once.
+		/// @param[in] filenames Names of the files.
+		/// @param[in] callback Function called on the I/O thread when an operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operations in the same order as the filenames.
+		static Array<AsyncRequest*> readAsync(const Array<String>& filenames, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Queues reading a resource file.
+		/// @param[in] filename Name of the resource file.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation.
+		static AsyncRequest* readResourceAsync(const String& filename, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Queues writing a file.
+		/// @param[in] filename Name of the file.
+		/// @param[in] data The data. It is copied so it doesn't have to stay valid.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation.
+		static AsyncRequest* writeAsync(const String& filename, const Stream& data, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Queues appending to a file.
+		/// @param[in] filename Name of the file.
+		/// @param[in] data The data. It is copied so it doesn't have to stay valid.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation.
+		static AsyncRequest* appendAsync(const String& filename, const Stream& data, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Queues copying a file.
+		/// @param[in] oldFilename Name of the file.
+		/// @param[in] newFilename Name of the copy.
+		/// @param[in] overwrite Whether to overwrite an already existing file.
+		/// @param[in] preserveTimes Whether the copy gets the access and modification times of the file.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation.
+		/// @see File::copy
+		static AsyncRequest* copyAsync(const String& oldFilename, const String& newFilename, bool overwrite = false, bool preserveTimes = false, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Queues copying multiple files at once.
+		/// @param[in] oldFilenames Names of the files.
+		/// @param[in] newFilenames Names of the copies in the same order.
+		/// @param[in] overwrite Whether to overwrite already existing files.
+		/// @param[in] preserveTimes Whether the copies get the access and modification times of the files.
+		/// @param[in] callback Function called on the I/O thread when an operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operations in the same order as the filenames.
+		/// @see File::copy
+		static Array<AsyncRequest*> copyAsync(const Array<String>& oldFilenames, const Array<String>& newFilenames, bool overwrite = false, bool preserveTimes = false, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Cancels multiple operations at once.
+		/// @param[in] requests The operations.
+		/// @return Number of operations that were still queued and have been cancelled.
+		static int cancel(const Array<AsyncRequest*>& requests);
+		/// @brief Waits for multiple operations.
+		/// @param[in] requests The operations.
+		static void wait(const Array<AsyncRequest*>& requests);
+		/// @brief Cancels all queued operations, waits for the running ones and stops the I/O threads.
+		static void finalize();
+
+	protected:
+		/// @brief The I/O threads.
+		static Array<Thread*> threads;
+		/// @brief Number of I/O threads.
+		static int threadCount;
+		/// @brief Operations waiting for an I/O thread.
+		static Deque<AsyncRequest*> queue;
+		/// @brief Protects the queue and the states of operations.
+		static Mutex mutex;
+		/// @brief Counts queued operations so idle I/O threads block until there is something to do.
+		static Semaphore* semaphore;
+
+		/// @brief Queues operations and starts the I/O threads if necessary.
+		/// @param[in] requests The operations.
+		static void _enqueue(const Array<AsyncRequest*>& requests);
+		/// @brief Processes queued operations.
+		/// @param[in] thread The I/O thread.
+		static void _process(Thread* thread);
+		/// @brief Basic constructor.
+		/// @note Forces this to be a static class.
+		inline AsyncFile() { }
+		/// @brief Destructor.
+		/// @note Forces this to be a static class.
+		inline ~AsyncFile() { }
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::AsyncRequest hasyncrequest;
+/// @brief Alias for simpler code.
+typedef hltypes::AsyncFile hasyncfile;
+
+#endif
@@ -0,0 +1,113 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides interned strings for repeated identifiers.
+
+#ifndef HLTYPES_ATOM_H
+#define HLTYPES_ATOM_H
+
+#include "hltypesExport.h"
+#include "hstring.h"
+
+namespace hltypes
+{
+	/// @brief Handle to a string stored only once in a global thread-safe table.
+	/// @note Atoms with equal content always share the same storage so comparing and hashing them never touches the characters.
+	/// @note Interned data is never released, so Atoms are meant for a limited set of identifiers (e.g. names and keys), not for arbitrary text.
+	class hltypesExport Atom
+	{
+	public:
+		/// @brief Empty constructor.
+		/// @note Creates the empty Atom.
+		Atom();
+		/// @brief Basic constructor.
+		/// @param[in] string C-type string to intern.
+		Atom(const char* string);
+		/// @brief Basic constructor.
+		/// @param[in] string Characters to intern.
+		/// @param[in] length Number of characters.
+		Atom(const char* string, int length);
+		/// @brief Basic constructor.
+		/// @param[in] string String to intern.
+		Atom(const String& string);
+
+		/// @brief Gets the interned C-string.
+		/// @return The C-string.
+		/// @note The pointer stays valid for the lifetime of the process.
+		inline const char* cStr() const { return this->entry->data; }
+		/// @brief Gets the byte length.
+		/// @return The byte length.
+		inline int size() const { return this->entry->size; }
+		/// @brief Gets the hash value.
+		/// @return The hash value.
+		/// @note The value is computed once when the string is interned.
+		inline unsigned int hash() const { return this->entry->hash; }
+		/// @brief Checks if this is the empty Atom.
+		/// @return True if this is the empty Atom.
+		inline bool isEmpty() const { return (this->entry->size == 0); }
+		/// @brief Creates a String from this Atom.
+		/// @return A String.
+		inline String toString() const { return String(this->entry->data, this->entry->size); }
+
+		/// @brief Compares Atoms for equivalency.
+		/// @param[in] other Other Atom.
+		/// @return True if both Atoms contain the same string.
+		inline bool operator==(const Atom& other) const { return (this->entry == other.entry); }
+		/// @brief Compares Atoms for non-equivalency.
+		/// @param[in] other Other Atom.
+		/// @return True if the Atoms contain different strings.
+		inline bool operator!=(const Atom& other) const { return (this->entry != other.entry); }
+		/// @brief Provides an ordering so Atoms can be used as Map keys.
+		/// @param[in] other Other Atom.
+		/// @return True if this Atom is ordered before the other one.
+		/// @note The ordering is consistent during the process lifetime, but it is not alphabetical.
+		inline bool operator<(const Atom& other) const { return (this->entry < other.entry); }
+		/// @brief Casts Atom into String.
+		inline operator String() const { return this->toString(); }
+
+		/// @brief Finds an already interned string without adding it to the table.
+		/// @param[in] string The String.
+		/// @param[out] outAtom The Atom if one exists.
+		/// @return True if the string has been interned before.
+		/// @note Useful for lookups with arbitrary input, because it does not grow the table.
+		static bool find(const String& string, Atom& outAtom);
+		/// @brief Gets the number of interned strings.
+		/// @return The number of interned strings.
+		static int getCount();
+
+	protected:
+		/// @brief Interned data shared by all equal Atoms.
+		struct Entry
+		{
+			/// @brief Precalculated hash value.
+			unsigned int hash;
+			/// @brief Byte length of the string.
+			int size;
+			/// @brief Null-terminated characters, allocated together with the Entry.
+			char data[1];
+		};
+
+		/// @brief The interned data.
+		const Entry* entry;
+
+		/// @brief Finds or adds an Entry in the table.
+		/// @param[in] string The characters.
+		/// @param[in] length Number of characters.
+		/// @param[in] create Whether to add a new Entry if it doesn't exist yet.
+		/// @return The Entry or NULL if it doesn't exist and create is false.
+		static const Entry* _intern(const char* string, int length, bool create);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::Atom hatom;
+
+#endif
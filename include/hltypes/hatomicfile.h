@@ -0,0 +1,142 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides atomic replacement of files through temporary files.
+
+#ifndef HLTYPES_ATOMIC_FILE_H
+#define HLTYPES_ATOMIC_FILE_H
+
+#include <stdint.h>
+
+#include "harray.h"
+#include "henum.h"
+#include "hfbase.h"
+#include "hstring.h"
+
+#include "hltypesExport.h"
+
+namespace hltypes
+{
+	/// @brief Writes a file that replaces another file atomically when it's committed.
+	/// @note Data is written to a temporary file in the same directory which is renamed to the target file on commit().
+	/// @note Readers always see either the complete old or the complete new file, never a partially written one.
+	/// @note If the file isn't committed, the temporary file is removed and the target file stays untouched.
+	class hltypesExport AtomicFile : public FileBase
+	{
+	public:
+		/// @class SyncMode
+		/// @brief Defines how data is made durable before the file is published.
+		HL_ENUM_CLASS_PREFIX_DECLARE(hltypesExport, SyncMode,
+		(
+			/// @var static const SyncMode SyncMode::None
+			/// @brief Nothing is synced. The replacement is still atomic, but may be lost or reverted on a system crash.
+			HL_ENUM_DECLARE(SyncMode, None);
+			/// @var static const SyncMode SyncMode::Data
+			/// @brief The data and the size are synced, other metadata may be lost on a system crash (fdatasync()).
+			HL_ENUM_DECLARE(SyncMode, Data);
+			/// @var static const SyncMode SyncMode::Full
+			/// @brief The data and all metadata are synced (fsync(), F_FULLFSYNC on Apple platforms).
+			HL_ENUM_DECLARE(SyncMode, Full);
+		));
+
+		/// @brief Basic constructor.
+		AtomicFile();
+		/// @brief Constructor that opens a file.
+		/// @param[in] filename Name of the file that will be replaced (may include path).
+		AtomicFile(const String& filename);
+		/// @brief Destructor.
+		/// @note Discards the file if it wasn't committed.
+		~AtomicFile();
+
+		/// @brief Gets the name of the file that will be replaced.
+		HL_DEFINE_GET(String, targetFilename, TargetFilename);
+
+		/// @brief Opens a temporary file for a file that will be replaced.
+		/// @param[in] filename Name of the file that will be replaced (may include path).
+		/// @note If path does not exist, it will be created.
+		/// @note If this instance is already working with an uncommitted file, that file will be discarded.
+		/// @note The temporary file is created exclusively so existing files are never overwritten.
+		void open(const String& filename);
+		/// @brief Discards the file.
+		/// @see discard
+		void close();
+		/// @brief Writes all buffered data to the temporary file.
+		void flush();
+		/// @brief Syncs the data, closes the file and replaces the target file with it.
+		/// @param[in] syncMode How the data and the directory are synced.
+		/// @return True if the target file was replaced. Otherwise the temporary file is removed.
+		/// @note Fails if any data couldn't be written, e.g. because the disk is full.
+		/// @note The directory is synced as well unless syncMode is SyncMode::None, so the rename itself survives a system crash.
+		bool commit(SyncMode syncMode = SyncMode::Data);
+		/// @brief Closes and removes the temporary file without touching the target file.
+		void discard();
+
+		/// @brief Commits multiple files with a single sync of each directory (group commit).
+		/// @param[in] files The files.
+		/// @param[in] syncMode How the data and the directories are synced.
+		/// @return True if all target files were replaced.
+		/// @note All files are synced before any of them is renamed, so a failed sync leaves all target files untouched.
+		/// @note Syncing the directory is the expensive part when persisting many small files and it's done only once per directory here.
+		static bool commit(const Array<AtomicFile*>& files, SyncMode syncMode = SyncMode::Data);
+
+	protected:
+		/// @brief Name of the file that will be replaced.
+		String targetFilename;
+
+		/// @brief Writes the buffered data, syncs it and closes the temporary file.
+		/// @param[in] syncMode How the data is synced.
+		/// @return True if successful and no write since opening the file failed.
+		bool _prepareCommit(SyncMode syncMode);
+		/// @brief Replaces the target file with the closed temporary file.
+		/// @return True if successful.
+		/// @note The permissions of an existing target file are kept.
+		bool _publish();
+
+		/// @brief Reads data from the stream.
+		/// @param[in] buffer Destination data buffer.
+		/// @param[in] count Number of elements to read.
+		/// @return Number of bytes read.
+		int _read(void* buffer, int count);
+		/// @brief Writes data to the stream.
+		/// @param[in] buffer Source data buffer.
+		/// @param[in] count Number of elements contained in buffer.
+		/// @return Number of bytes written.
+		int _write(const void* buffer, int count);
+		/// @brief Checks if file is open.
+		/// @return True if file is open.
+		bool _isOpen() const;
+		/// @brief Gets current position in file.
+		/// @return Current position in file.
+		int64_t _position() const;
+		/// @brief Seeks to position in file.
+		/// @param[in] offset Seeking offset in bytes.
+		/// @param[in] seekMode Seeking mode.
+		bool _seek(int64_t offset, SeekMode seekMode = SeekMode::Current);
+
+		/// @brief Creates a name for a temporary file next to a file.
+		/// @param[in] filename Normalized name of the file.
+		/// @return Name for a temporary file in the same directory.
+		static String _makeTempFilename(const String& filename);
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		AtomicFile(const AtomicFile& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		AtomicFile& operator=(AtomicFile& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::AtomicFile hatomicfile;
+
+#endif
@@ -20,6 +20,7 @@
 #include "hltypesUtil.h"
 #include "hplatform.h"
 #include "hstring.h"
+#include "hstringbuilder.h"
 
 namespace hltypes
 {
@@ -837,17 +838,18 @@ namespace hltypes
 		/// @note Make sure your elements can be cast into String or are already String.
 		inline String joined(const String& separator) const
 		{
-			String result;
+			StringBuilder builder;
 			int size = this->size();
 			if (size > 0)
 			{
-				result += String(this->at(0));
+				builder.add(String(this->at(0)));
 				for_iter (i, 1, size)
 				{
-					result += separator + String(this->at(i));
+					builder.add(separator);
+					builder.add(String(this->at(i)));
 				}
 			}
-			return result;
+			return builder.toString();
 		}
 		/// @brief Finds and returns first occurrence of element that matches the condition.
 		/// @param[in] conditionFunction Function pointer with condition function that takes one element of type T and returns bool.
@@ -29,6 +29,12 @@ namespace hltypes
 		/// @param[in] path The path.
 		/// @return Base filename/directory without the prepended directory path.
 		static String baseName(const String& path);
+		/// @brief Gets the base filename/directory without the prepended directory path and without allocating memory.
+		/// @param[in] path The path.
+		/// @param[in] size Size of the path or -1 if it's null-terminated.
+		/// @param[out] length Length of the base filename/directory.
+		/// @return Pointer to the base filename/directory inside the path. It's not null-terminated.
+		static const char* baseName(const char* path, int size, int& length);
 		/// @brief Gets the base directory name of a filename/directory.
 		/// @param[in] path The path.
 		/// @return Base directory name of the given filename/directory.
@@ -37,17 +43,36 @@ namespace hltypes
 		/// @param[in] path The path.
 		/// @return Path with all platform-specific directory separators changed to /.
 		static String systemize(const String& path);
+		/// @brief Changes all platform-specific directory separators to / and removes duplicate / in place.
+		/// @param[in,out] path The null-terminated path.
+		/// @param[in] size Size of the path or -1 to determine it.
+		/// @return Size of the systemized path.
+		/// @note The result is never longer than the path.
+		static int systemize(char* path, int size);
 		/// @brief Normalizes a file path by converting all platform-specific directory separators into /, removal of duplicate / and proper removal of "." and ".." where necessary.
 		/// @param[in] path The path.
 		/// @return Normalized path.
 		/// @note Calls Dir::systemize() internally.
 		static String normalize(const String& path);
+		/// @brief Normalizes a file path in place and in a single pass, without allocating memory.
+		/// @param[in,out] path The null-terminated path.
+		/// @param[in] size Size of the path or -1 to determine it.
+		/// @return Size of the normalized path.
+		/// @note The result is the same as with normalize(const String&) and it's never longer than the path.
+		static int normalize(char* path, int size);
 		/// @brief Joins two paths taking into consideration slashes at both ends.
 		/// @param[in] path1 First path.
 		/// @param[in] path2 Second path.
 		/// @param[in] systemizeResult Whether to systemize the resulting path as well.
 		/// @return Joined path.
 		static String joinPath(const String& path1, const String& path2, bool systemizeResult = false);
+		/// @brief Joins two paths into a buffer taking into consideration slashes at both ends.
+		/// @param[out] output Destination buffer. It can be the same as path1 to append path2 in place.
+		/// @param[in] capacity Size of the destination buffer including the null-terminator.
+		/// @param[in] path1 First path.
+		/// @param[in] path2 Second path.
+		/// @return Size of the joined path or -1 if it doesn't fit into the destination buffer.
+		static int joinPath(char* output, int capacity, const char* path1, const char* path2);
 		/// @brief Joins an array of paths taking into consideration slashes at both ends.
 		/// @param[in] paths Array of paths.
 		/// @param[in] systemizeResult Whether to systemize the resulting path as well.
@@ -0,0 +1,206 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides streaming deflate compression and decompression on top of other streams.
+
+#ifndef HLTYPES_DEFLATE_STREAM_H
+#define HLTYPES_DEFLATE_STREAM_H
+
+#include <stdint.h>
+
+#include "henum.h"
+#include "hltypesUtil.h"
+#include "hsbase.h"
+#include "hstring.h"
+
+#include "hltypesExport.h"
+
+/// @brief Default compression level of DeflateStream.
+#define HL_DEFLATE_DEFAULT_LEVEL 6
+/// @brief Fastest compression level of DeflateStream.
+#define HL_DEFLATE_FASTEST_LEVEL 1
+/// @brief Best compression level of DeflateStream.
+#define HL_DEFLATE_BEST_LEVEL 9
+/// @brief Default size of the DeflateStream input and output buffers.
+#define HL_DEFLATE_BUFFER_SIZE 65536
+
+namespace hltypes
+{
+	/// @brief Compresses data into or decompresses data from another stream in the zlib format (RFC 1950).
+	/// @note Memory usage is bounded by the buffer size and the compressor state, regardless of the data size.
+	/// @note The size is the number of uncompressed bytes written or decompressed so far.
+	/// @note Requires hltypes to be compiled with _ZIPRESOURCE, otherwise the constructor throws an exception.
+	class hltypesExport DeflateStream : public StreamBase
+	{
+	public:
+		/// @class Mode
+		/// @brief Defines whether data is compressed or decompressed.
+		HL_ENUM_CLASS_PREFIX_DECLARE(hltypesExport, Mode,
+		(
+			/// @var static const Mode Mode::Compress
+			/// @brief Written data is compressed into the other stream.
+			HL_ENUM_DECLARE(Mode, Compress);
+			/// @var static const Mode Mode::Decompress
+			/// @brief Read data is decompressed from the other stream.
+			HL_ENUM_DECLARE(Mode, Decompress);
+		));
+
+		/// @brief Constructor.
+		/// @param[in] stream The stream with the compressed data. It's not owned by the DeflateStream.
+		/// @param[in] mode Whether to compress or decompress.
+		/// @param[in] level Compression level from 0 (no compression) to 9 (best compression). Ignored when decompressing.
+		/// @param[in] bufferSize Size of the input and output buffers.
+		/// @note When decompressing, the first block is decompressed right away.
+		DeflateStream(StreamBase* stream, Mode mode, int level = HL_DEFLATE_DEFAULT_LEVEL, int bufferSize = HL_DEFLATE_BUFFER_SIZE);
+		/// @brief Destructor.
+		/// @note Calls finish() if compressing, errors are only logged.
+		~DeflateStream();
+
+		/// @brief Gets the stream with the compressed data.
+		HL_DEFINE_GET(StreamBase*, stream, Stream);
+		/// @brief Gets the mode.
+		HL_DEFINE_GET(Mode, mode, Mode);
+		/// @brief Gets the compression level.
+		HL_DEFINE_GET(int, level, Level);
+		/// @brief Whether every write is followed by flush().
+		/// @note Use this for logs that have to be readable while they are still being written.
+		HL_DEFINE_ISSET(autoFlush, AutoFlush);
+		/// @brief Whether compressed data that ends before its proper end is treated as the end of the data instead of an error.
+		/// @note Use this for reading logs that are still being written. The trailer isn't checked in that case.
+		HL_DEFINE_ISSET(allowTruncated, AllowTruncated);
+		/// @brief Checks whether the end of the compressed data was written or reached.
+		HL_DEFINE_IS(finished, Finished);
+
+		/// @brief Writes all pending compressed data to the other stream so it can be decompressed up to this point.
+		/// @param[in] full Whether the compressor state is reset so decompression can also start from this point.
+		/// @note A flush adds a few bytes and a full flush makes the compression worse, so they shouldn't be used too often.
+		/// @note Does nothing when decompressing.
+		void flush(bool full = false);
+		/// @brief Writes the remaining compressed data and the end of the compressed data to the other stream.
+		/// @note Nothing can be written afterwards. Does nothing when decompressing.
+		void finish();
+
+	protected:
+		/// @brief The stream with the compressed data.
+		StreamBase* stream;
+		/// @brief Whether data is compressed or decompressed.
+		Mode mode;
+		/// @brief Compression level.
+		int level;
+		/// @brief Whether every write is followed by flush().
+		bool autoFlush;
+		/// @brief Whether compressed data that ends before its proper end is treated as the end of the data.
+		bool allowTruncated;
+		/// @brief Whether the end of the compressed data was written or reached.
+		bool finished;
+		/// @brief The compressor or decompressor state.
+		void* zStream;
+		/// @brief Size of the buffers.
+		int bufferSize;
+		/// @brief Compressed data read from the other stream.
+		unsigned char* inputBuffer;
+		/// @brief Compressed data that is written to the other stream or a window of decompressed data.
+		unsigned char* outputBuffer;
+		/// @brief Position of the first byte of the decompressed window.
+		int64_t windowPosition;
+		/// @brief Number of decompressed bytes in the window.
+		int windowSize;
+		/// @brief Current position in the uncompressed data.
+		int64_t streamPosition;
+		/// @brief Position in the other stream where the compressed data starts.
+		int64_t startPosition;
+
+		/// @brief Constructor for derived classes that call _initialize() on their own.
+		/// @param[in] stream The stream with the compressed data.
+		/// @param[in] mode Whether to compress or decompress.
+		/// @param[in] level Compression level.
+		/// @param[in] bufferSize Size of the input and output buffers.
+		/// @param[in] initialize Whether to call _initialize().
+		DeflateStream(StreamBase* stream, Mode mode, int level, int bufferSize, bool initialize);
+
+		/// @brief Sets up the compressor or decompressor.
+		/// @note Has to be called by the most derived constructor, because it uses virtual methods.
+		void _initialize();
+		/// @brief Releases the compressor or decompressor.
+		void _release();
+		/// @brief Starts decompressing from the beginning again.
+		/// @return True if the other stream could be sought back.
+		bool _restart();
+		/// @brief Decompresses more data into the window.
+		/// @note Keeps the end of the old data in the window so seeking back a little doesn't require restarting.
+		virtual void _decompress();
+		/// @brief Compresses data and writes the output to the other stream.
+		/// @param[in] data Uncompressed data.
+		/// @param[in] size Size of the data.
+		/// @param[in] flushMode miniz flush mode.
+		void _compress(const void* data, int size, int flushMode);
+
+		/// @brief Gets the window bits for the compressor and decompressor.
+		/// @return Positive values use the zlib format, negative values produce raw deflate data.
+		virtual int _windowBits() const;
+		/// @brief Writes a header before the compressed data.
+		virtual void _writeHeader();
+		/// @brief Writes a trailer after the compressed data.
+		virtual void _writeTrailer();
+		/// @brief Reads the header before the compressed data.
+		virtual void _readHeader();
+		/// @brief Reads the trailer after the compressed data.
+		/// @note The other stream is positioned right after the end of the compressed data.
+		virtual void _readTrailer();
+		/// @brief Processes uncompressed data for a checksum.
+		/// @param[in] data Uncompressed data.
+		/// @param[in] size Size of the data.
+		virtual void _updateChecksum(const unsigned char* data, int size);
+
+		/// @brief Does nothing, the size is always up to date.
+		void _updateDataSize();
+
+		/// @brief Gets special descriptor.
+		/// @return Special descriptor.
+		inline String _descriptor() const { return "deflate stream"; }
+		/// @brief Reads decompressed data.
+		/// @param[in] buffer Destination data buffer.
+		/// @param[in] count Number of bytes to read.
+		/// @return Number of bytes read.
+		int _read(void* buffer, int count);
+		/// @brief Compresses data.
+		/// @param[in] buffer Source data buffer.
+		/// @param[in] count Number of bytes contained in buffer.
+		/// @return Number of bytes written.
+		int _write(const void* buffer, int count);
+		/// @brief Checks if data is "open".
+		/// @return True if the other stream is set.
+		bool _isOpen() const;
+		/// @brief Gets current position in the uncompressed data.
+		/// @return Current position in the uncompressed data.
+		int64_t _position() const;
+		/// @brief Seeks to position in the uncompressed data.
+		/// @param[in] offset Seeking offset in bytes.
+		/// @param[in] seekMode Seeking mode.
+		/// @return True if successful.
+		/// @note Seeking forward decompresses and skips data, seeking back before the window restarts decompression, seeking from the end decompresses everything.
+		/// @note Seeking isn't possible when compressing.
+		bool _seek(int64_t offset, SeekMode seekMode = SeekMode::Current);
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		DeflateStream(const DeflateStream& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		DeflateStream& operator=(DeflateStream& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::DeflateStream hdeflatestream;
+
+#endif
@@ -13,18 +13,112 @@
 #ifndef HLTYPES_DIR_H
 #define HLTYPES_DIR_H
 
+#include <stdint.h>
+
+#include "harray.h"
 #include "hdbase.h"
+#include "henum.h"
 #include "hstring.h"
 #include "hltypesExport.h"
 
 namespace hltypes
 {
-	template <typename T> class Array;
+	/// @brief Used for information about directory entries.
+	struct hltypesExport DirEntry
+	{
+		/// @class Type
+		/// @brief Defines the type of a directory entry.
+		HL_ENUM_CLASS_PREFIX_DECLARE(hltypesExport, Type,
+		(
+			/// @var static const Type Type::File
+			/// @brief Regular file.
+			HL_ENUM_DECLARE(Type, File);
+			/// @var static const Type Type::Directory
+			/// @brief Directory.
+			HL_ENUM_DECLARE(Type, Directory);
+			/// @var static const Type Type::Other
+			/// @brief Anything else, e.g. a device, a socket or a broken symbolic link.
+			HL_ENUM_DECLARE(Type, Other);
+		));
+
+		/// @brief Entry name without the directory.
+		String name;
+		/// @brief Entry type. Symbolic links are resolved.
+		Type type;
+		/// @brief File size or -1 if it wasn't requested.
+		int64_t size;
+		/// @brief The time the entry was last modified or 0 if it wasn't requested.
+		int64_t modificationTime;
+		/// @brief Whether the entry is a symbolic link. The type is the type of the link target.
+		bool symbolicLink;
+
+		/// @brief Constructor.
+		DirEntry();
+		/// @brief Destructor.
+		~DirEntry();
+
+		/// @brief Checks whether the entry is a regular file.
+		/// @return True if the entry is a regular file.
+		inline bool isFile() const { return (this->type == Type::File); }
+		/// @brief Checks whether the entry is a directory.
+		/// @return True if the entry is a directory.
+		inline bool isDirectory() const { return (this->type == Type::Directory); }
+		/// @brief Checks whether the entry is a symbolic link.
+		/// @return True if the entry is a symbolic link.
+		inline bool isSymbolicLink() const { return this->symbolicLink; }
+
+	};
+
+	/// @brief Used for configuring a recursive directory walk.
+	struct hltypesExport DirWalkOptions
+	{
+		/// @class LinkPolicy
+		/// @brief Defines how symbolic links are handled.
+		HL_ENUM_CLASS_PREFIX_DECLARE(hltypesExport, LinkPolicy,
+		(
+			/// @var static const LinkPolicy LinkPolicy::Skip
+			/// @brief Symbolic links are ignored.
+			HL_ENUM_DECLARE(LinkPolicy, Skip);
+			/// @var static const LinkPolicy LinkPolicy::Report
+			/// @brief Symbolic links are reported like their targets, but linked directories are not entered.
+			HL_ENUM_DECLARE(LinkPolicy, Report);
+			/// @var static const LinkPolicy LinkPolicy::Follow
+			/// @brief Symbolic links are reported and linked directories are entered.
+			/// @note Link cycles are only stopped by maxDepth.
+			HL_ENUM_DECLARE(LinkPolicy, Follow);
+		));
+
+		/// @brief How many directory levels below the root are entered. 0 only lists the root, negative values are unlimited.
+		int maxDepth;
+		/// @brief Whether files are reported.
+		bool files;
+		/// @brief Whether directories are reported.
+		bool directories;
+		/// @brief Glob patterns for file names with "*" and "?" wildcards. If not empty, a file has to match one of them.
+		Array<String> patterns;
+		/// @brief File extensions with or without the leading ".". If not empty, a file has to have one of them. Case insensitive.
+		Array<String> extensions;
+		/// @brief How symbolic links are handled.
+		LinkPolicy linkPolicy;
+		/// @brief Whether size and modification time of the entries are needed.
+		bool withInfo;
+		/// @brief Number of threads that list directories. Values of 1 and less walk on the calling thread only.
+		int threadCount;
+
+		/// @brief Constructor.
+		/// @note By default all files are reported, directories are not reported and symbolic links are not entered.
+		DirWalkOptions();
+		/// @brief Destructor.
+		~DirWalkOptions();
+
+	};
 
 	/// @brief Provides high level directory handling.
 	class hltypesExport Dir : public DirBase
 	{
 	public:
+		friend class PathCache;
+
 		/// @brief Sets flag for creating directories with full access permissions on Win32 (Vista and later).
 		/// @return Flag for creating directories with full access permissions on Win32 (Vista and later).
 		/// @note Not implemented as inline, because optimizer strips it away even if compiled as DLL.
@@ -71,9 +165,33 @@ namespace hltypes
 		/// @brief Copies a directory recursively.
 		/// @param[in] oldDirName Old name of the directory.
 		/// @param[in] newDirName New name of the directory.
-		/// @return True if directory was copied. False if old directory does not exist or directory with the new name already exists.
+		/// @param[in] preserveTimes Whether the copied files get the access and modification times of the original files.
+		/// @return True if directory and all files were copied. False if old directory does not exist, directory with the new name already exists or any file could not be copied.
 		/// @note If path does not exist, it will be created.
-		static bool copy(const String& oldDirName, const String& newDirName);
+		/// @note The directory tree is listed once and the files are copied in parallel by a few threads that only exist during the call.
+		/// @note Files that could not be copied don't stop the copy, the remaining files are still copied.
+		static bool copy(const String& oldDirName, const String& newDirName, bool preserveTimes = false);
+		/// @brief Lists a directory in a single pass and classifies each entry.
+		/// @param[in] dirName Name of the directory.
+		/// @param[in] withInfo Whether the size and modification time of each entry are needed as well.
+		/// @return Array of all directory entries without "." and "..".
+		/// @note The type comes from the directory listing itself where the OS provides it (d_type, Win32 find data), entries are only stat'ed if it doesn't or if withInfo is set.
+		static Array<DirEntry> scan(const String& dirName, bool withInfo = false);
+		/// @brief Recursively walks a directory tree and reports entries to a callback.
+		/// @param[in] dirName Name of the root directory.
+		/// @param[in] options Options of the walk.
+		/// @param[in] callback Function called with the path (including dirName), the entry and userData. Returning false stops the walk.
+		/// @param[in] userData User data for the callback.
+		/// @return False if the walk was stopped by the callback.
+		/// @note With more than one thread the callback is called concurrently from all threads in no particular order and has to be thread-safe.
+		/// @note Directories are listed with scan() so the walk doesn't stat entries unless needed.
+		static bool walk(const String& dirName, const DirWalkOptions& options, bool (*callback)(const String&, const DirEntry&, void*), void* userData = NULL);
+		/// @brief Recursively walks a directory tree.
+		/// @param[in] dirName Name of the root directory.
+		/// @param[in] options Options of the walk.
+		/// @return Paths (including dirName) of all reported entries.
+		/// @note With more than one thread the paths are in no particular order.
+		static Array<String> walk(const String& dirName, const DirWalkOptions& options = DirWalkOptions());
 		/// @brief Gets all directory entries in the given directory.
 		/// @param[in] dirName Name of the directory.
 		/// @param[in] prependDir Whether the same parent path should be appended to the entries.
@@ -114,9 +232,19 @@ namespace hltypes
 		/// @brief Flag for creating directories with full access permissions on Win32 (Vista and later).
 		static bool win32FullDirectoryPermissions;
 
+		/// @brief Lists a directory in a single pass without using the PathCache.
+		/// @param[in] name Normalized name of the directory.
+		/// @param[in] withInfo Whether the size and modification time of each entry are needed as well.
+		/// @return Array of all directory entries without "." and "..".
+		static Array<DirEntry> _scan(const String& name, bool withInfo);
+
 	};
 }
 
+/// @brief Alias for simpler code.
+typedef hltypes::DirEntry hdirentry;
+/// @brief Alias for simpler code.
+typedef hltypes::DirWalkOptions hdirwalkoptions;
 /// @brief Alias for simpler code.
 typedef hltypes::Dir hdir;
 
@@ -0,0 +1,181 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides hex, base64 and percent encoding of binary data and text.
+
+#ifndef HLTYPES_ENCODING_H
+#define HLTYPES_ENCODING_H
+
+#include "hltypesExport.h"
+#include "hstring.h"
+
+namespace hltypes
+{
+	class Stream;
+	class StreamBase;
+}
+
+/// @brief Gets the size of hex encoded data.
+/// @param[in] size Size of the raw data.
+/// @return Number of characters hhexEncode() will write.
+inline int hhexEncodedSize(int size)
+{
+	return (size * 2);
+}
+/// @brief Gets the size of base64 encoded data.
+/// @param[in] size Size of the raw data.
+/// @return Number of characters hbase64Encode() will write, including padding.
+inline int hbase64EncodedSize(int size)
+{
+	return ((size + 2) / 3 * 4);
+}
+/// @brief Gets the maximum size of base64 decoded data.
+/// @param[in] length Number of base64 characters.
+/// @return Upper bound of bytes hbase64Decode() will write.
+inline int hbase64DecodedSize(int length)
+{
+	return ((length + 3) / 4 * 3);
+}
+/// @brief Gets the exact size of percent encoded text.
+/// @param[in] string Raw text.
+/// @param[in] length Byte length of the text.
+/// @return Number of characters hpercentEncode() will write.
+hltypesFnExport int hpercentEncodedSize(const char* string, int length);
+
+/// @brief Hex encodes raw data into a buffer.
+/// @param[in] data Raw data.
+/// @param[in] size Size of the raw data.
+/// @param[out] output Destination buffer with at least hhexEncodedSize(size) bytes.
+/// @return Number of characters written.
+/// @note Uses uppercase digits like the %02X format. The output is not null-terminated.
+hltypesFnExport int hhexEncode(const unsigned char* data, int size, char* output);
+/// @brief Hex encodes the bytes of a String.
+/// @param[in] string The String.
+/// @return Hex encoded String.
+hltypesFnExport hltypes::String hhexEncode(const hltypes::String& string);
+/// @brief Hex encodes data from a StreamBase.
+/// @param[in] stream StreamBase from which to encode.
+/// @param[in] size Number of bytes to encode.
+/// @return Hex encoded String.
+/// @note The stream position is not changed.
+hltypesFnExport hltypes::String hhexEncode(hltypes::StreamBase* stream, int size);
+/// @brief Hex encodes the remaining data of a StreamBase.
+/// @param[in] stream StreamBase from which to encode.
+/// @return Hex encoded String.
+/// @note The stream position is not changed.
+hltypesFnExport hltypes::String hhexEncode(hltypes::StreamBase* stream);
+/// @brief Hex encodes data from a Stream.
+/// @param[in] stream Stream from which to encode.
+/// @param[in] size Number of bytes to encode.
+/// @return Hex encoded String.
+/// @note The stream position is not changed. Data is encoded directly from the Stream's memory.
+hltypesFnExport hltypes::String hhexEncode(hltypes::Stream* stream, int size);
+/// @brief Hex encodes the remaining data of a Stream.
+/// @param[in] stream Stream from which to encode.
+/// @return Hex encoded String.
+/// @note The stream position is not changed. Data is encoded directly from the Stream's memory.
+hltypesFnExport hltypes::String hhexEncode(hltypes::Stream* stream);
+/// @brief Decodes hex characters into a buffer.
+/// @param[in] string Hex characters, case ignored.
+/// @param[in] length Number of characters.
+/// @param[out] output Destination buffer with at least length / 2 bytes.
+/// @return Number of bytes written or -1 if the input is not valid hex data.
+hltypesFnExport int hhexDecode(const char* string, int length, unsigned char* output);
+/// @brief Decodes a hex String.
+/// @param[in] string Hex String, case ignored.
+/// @param[out] output Decoded data.
+/// @return True if the input was valid hex data.
+hltypesFnExport bool hhexDecode(const hltypes::String& string, hltypes::String& output);
+/// @brief Decodes a hex String and writes the data into a Stream.
+/// @param[in] string Hex String, case ignored.
+/// @param[in] stream Stream into which the data is written at the current position.
+/// @return True if the input was valid hex data.
+/// @note If the input is not valid, the Stream's data, size and position stay unchanged.
+hltypesFnExport bool hhexDecode(const hltypes::String& string, hltypes::Stream* stream);
+
+/// @brief Base64 encodes raw data into a buffer.
+/// @param[in] data Raw data.
+/// @param[in] size Size of the raw data.
+/// @param[out] output Destination buffer with at least hbase64EncodedSize(size) bytes.
+/// @return Number of characters written.
+/// @note Uses the standard alphabet with padding. The output is not null-terminated.
+hltypesFnExport int hbase64Encode(const unsigned char* data, int size, char* output);
+/// @brief Base64 encodes the bytes of a String.
+/// @param[in] string The String.
+/// @return Base64 encoded String.
+hltypesFnExport hltypes::String hbase64Encode(const hltypes::String& string);
+/// @brief Base64 encodes data from a StreamBase.
+/// @param[in] stream StreamBase from which to encode.
+/// @param[in] size Number of bytes to encode.
+/// @return Base64 encoded String.
+/// @note The stream position is not changed.
+hltypesFnExport hltypes::String hbase64Encode(hltypes::StreamBase* stream, int size);
+/// @brief Base64 encodes the remaining data of a StreamBase.
+/// @param[in] stream StreamBase from which to encode.
+/// @return Base64 encoded String.
+/// @note The stream position is not changed.
+hltypesFnExport hltypes::String hbase64Encode(hltypes::StreamBase* stream);
+/// @brief Base64 encodes data from a Stream.
+/// @param[in] stream Stream from which to encode.
+/// @param[in] size Number of bytes to encode.
+/// @return Base64 encoded String.
+/// @note The stream position is not changed. Data is encoded directly from the Stream's memory.
+hltypesFnExport hltypes::String hbase64Encode(hltypes::Stream* stream, int size);
+/// @brief Base64 encodes the remaining data of a Stream.
+/// @param[in] stream Stream from which to encode.
+/// @return Base64 encoded String.
+/// @note The stream position is not changed. Data is encoded directly from the Stream's memory.
+hltypesFnExport hltypes::String hbase64Encode(hltypes::Stream* stream);
+/// @brief Decodes base64 characters into a buffer.
+/// @param[in] string Base64 characters.
+/// @param[in] length Number of characters.
+/// @param[out] output Destination buffer with at least hbase64DecodedSize(length) bytes.
+/// @return Number of bytes written or -1 if the input is not valid base64 data.
+/// @note Padding is optional, whitespace is not allowed.
+hltypesFnExport int hbase64Decode(const char* string, int length, unsigned char* output);
+/// @brief Decodes a base64 String.
+/// @param[in] string Base64 String.
+/// @param[out] output Decoded data.
+/// @return True if the input was valid base64 data.
+hltypesFnExport bool hbase64Decode(const hltypes::String& string, hltypes::String& output);
+/// @brief Decodes a base64 String and writes the data into a Stream.
+/// @param[in] string Base64 String.
+/// @param[in] stream Stream into which the data is written at the current position.
+/// @return True if the input was valid base64 data.
+/// @note If the input is not valid, the Stream's data, size and position stay unchanged.
+hltypesFnExport bool hbase64Decode(const hltypes::String& string, hltypes::Stream* stream);
+
+/// @brief Percent encodes text into a buffer.
+/// @param[in] string Raw text.
+/// @param[in] length Byte length of the text.
+/// @param[out] output Destination buffer with at least hpercentEncodedSize(string, length) bytes.
+/// @return Number of characters written.
+/// @note All characters except the RFC 3986 unreserved ones (letters, digits, '-', '.', '_' and '~') are encoded.
+hltypesFnExport int hpercentEncode(const char* string, int length, char* output);
+/// @brief Percent encodes a String.
+/// @param[in] string The String.
+/// @return Percent encoded String.
+/// @note All characters except the RFC 3986 unreserved ones (letters, digits, '-', '.', '_' and '~') are encoded.
+hltypesFnExport hltypes::String hpercentEncode(const hltypes::String& string);
+/// @brief Decodes percent encoded text into a buffer.
+/// @param[in] string Percent encoded text.
+/// @param[in] length Byte length of the text.
+/// @param[out] output Destination buffer with at least length bytes.
+/// @return Number of bytes written or -1 if the input contains an invalid escape sequence.
+/// @note '+' is not decoded as a space.
+hltypesFnExport int hpercentDecode(const char* string, int length, char* output);
+/// @brief Decodes a percent encoded String.
+/// @param[in] string Percent encoded String.
+/// @param[out] output Decoded String.
+/// @return True if the input did not contain invalid escape sequences.
+/// @note '+' is not decoded as a space.
+hltypesFnExport bool hpercentDecode(const hltypes::String& string, hltypes::String& output);
+
+#endif
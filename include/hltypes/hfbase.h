@@ -16,12 +16,16 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "harray.h"
 #include "henum.h"
 #include "hsbase.h"
 #include "hstring.h"
 
 #include "hltypesExport.h"
 
+/// @brief Recommended size for FileBase::setBufferSize().
+#define HL_FILE_BUFFER_SIZE 65536
+
 namespace hltypes
 {
 	/// @brief Used for information about files.
@@ -43,6 +47,25 @@ namespace hltypes
 
 	};
 	
+	/// @brief Describes one buffer of a scatter-gather read or write.
+	struct hltypesExport IoVector
+	{
+		/// @brief The data buffer.
+		void* data;
+		/// @brief Size of the buffer in bytes.
+		int64_t size;
+
+		/// @brief Basic constructor.
+		IoVector();
+		/// @brief Constructor.
+		/// @param[in] data The data buffer.
+		/// @param[in] size Size of the buffer in bytes.
+		IoVector(void* data, int64_t size);
+		/// @brief Destructor.
+		~IoVector();
+
+	};
+
 	/// @brief Provides a base for high level file handling.
 	/// @note When writing, \\r may be used, but \\r will be removed during read.
 	class hltypesExport FileBase : public StreamBase
@@ -89,6 +112,59 @@ namespace hltypes
 		/// @brief Closes resource file.
 		virtual void close() = 0;
 
+		/// @brief Gets the size of the read-ahead and write-behind buffer.
+		HL_DEFINE_GET(int, ioBufferSize, BufferSize);
+		/// @brief Sets the size of the read-ahead and write-behind buffer.
+		/// @param[in] value New buffer size in bytes. 0 disables buffering so only the OS buffering is used.
+		/// @note Buffered data is flushed before the buffer is resized.
+		/// @note Writes are collected in the buffer until it's full or until the file is flushed, sought, read or closed.
+		/// @note Data is read ahead only while reads are sequential, random access reads only read as much as requested.
+		void setBufferSize(int value);
+
+		/// @brief Gets the file information of the opened file from the OS handle.
+		/// @return File information provided by the OS.
+		/// @note This doesn't look up the path again like File::hinfo() and pending buffered data is written first so the size is current.
+		virtual FileInfo info();
+
+		/// @brief Reads data from a position without using or changing the current position.
+		/// @param[in] offset Position in the file.
+		/// @param[out] buffer Destination data buffer.
+		/// @param[in] count Number of bytes to read.
+		/// @return Number of bytes read.
+		/// @note Multiple threads may read from the same file this way at the same time as long as no data written through the current position is pending.
+		/// @note The read-ahead buffer is neither used nor changed.
+		int64_t readAt(int64_t offset, void* buffer, int64_t count);
+		/// @brief Reads data from a position into multiple buffers without using or changing the current position.
+		/// @param[in] offset Position in the file.
+		/// @param[in] vectors The destination buffers, filled in order.
+		/// @return Number of bytes read.
+		/// @see readAt(int64_t offset, void* buffer, int64_t count)
+		int64_t readAt(int64_t offset, const Array<IoVector>& vectors);
+		/// @brief Writes data to a position without using or changing the current position.
+		/// @param[in] offset Position in the file.
+		/// @param[in] buffer Source data buffer.
+		/// @param[in] count Number of bytes to write.
+		/// @return Number of bytes written.
+		/// @note Pending buffered data is written first and read-ahead data is discarded, so this is not thread-safe.
+		/// @note Some OSs ignore the position for files that were opened in an append mode.
+		int64_t writeAt(int64_t offset, const void* buffer, int64_t count);
+		/// @brief Writes data from multiple buffers to a position without using or changing the current position.
+		/// @param[in] offset Position in the file.
+		/// @param[in] vectors The source buffers, written in order.
+		/// @return Number of bytes written.
+		/// @see writeAt(int64_t offset, const void* buffer, int64_t count)
+		int64_t writeAt(int64_t offset, const Array<IoVector>& vectors);
+		/// @brief Reads data from the current position into multiple buffers with a single OS call (scatter read).
+		/// @param[in] vectors The destination buffers, filled in order.
+		/// @return Number of bytes read.
+		/// @note The current position is moved past the read data.
+		int64_t readv(const Array<IoVector>& vectors);
+		/// @brief Writes data from multiple buffers to the current position with a single OS call (gather write).
+		/// @param[in] vectors The source buffers, written in order.
+		/// @return Number of bytes written.
+		/// @note The current position is moved past the written data.
+		int64_t writev(const Array<IoVector>& vectors);
+
 		/// @brief Sets the number of repeated attempts to access a file.
 		/// @param[in] value New value.
 		/// @note Not implemented as inline, because optimizer strips it away even if compiled as DLL.
@@ -112,10 +188,35 @@ namespace hltypes
 		String filename;
 		/// @brief OS file handle.
 		void* cfile;
+		/// @brief Current position in the file, tracked so reads and writes don't have to query the OS.
+		int64_t filePosition;
+		/// @brief Whether all writes go to the end of the file.
+		bool appendMode;
+		/// @brief Read-ahead or write-behind buffer.
+		/// @note Allocated with malloc() so it's never zero-filled.
+		unsigned char* ioBuffer;
+		/// @brief Size of the buffer.
+		int ioBufferSize;
+		/// @brief Start of unread data in the buffer.
+		int ioBufferStart;
+		/// @brief End of read-ahead data or of pending written data in the buffer.
+		int ioBufferEnd;
+		/// @brief Whether the buffer contains pending written data instead of read-ahead data.
+		bool ioBufferWriting;
+		/// @brief Whether the OS file buffer may contain written data that positional reads wouldn't see yet.
+		bool osBufferWriting;
+		/// @brief Position where the last read ended, used to detect sequential reading. -1 if not reading sequentially.
+		int64_t sequentialPosition;
+		/// @brief Whether a write since opening the file wrote less data than requested, e.g. because the disk is full.
+		/// @note Writes from the buffer happen later than the actual write calls so they can't report this directly.
+		bool writeFailed;
 
 		/// @brief Gets special descriptor.
 		/// @return Special descriptor.
 		String _descriptor() const;
+		/// @brief Updates internal data size.
+		/// @note Does nothing, because the size is already tracked by _fwrite() and doesn't require seeking.
+		void _updateDataSize();
 
 		/// @brief Opens an OS file.
 		/// @param[in] filename Name of the file (may include path).
@@ -124,8 +225,21 @@ namespace hltypes
 		/// @param[in] timeout Timeout in miliseconds between repeated attempts to access a file.
 		/// @note If this instance is already working with an opened file handle, that file handle will be closed.
 		void _fopen(const String& filename, AccessMode accessMode, int repeats, float timeout);
+		/// @brief Creates a new file and opens it for writing.
+		/// @param[in] filename Name of the file (may include path).
+		/// @return True if the file was created. False if the file already exists.
+		/// @note Unlike opening with AccessMode::Write, an existing file is never opened and truncated.
+		/// @note If this instance is already working with an opened file handle, that file handle will be closed.
+		bool _fcreate(const String& filename);
+		/// @brief Resets the buffering state after a file handle was opened.
+		/// @param[in] appendMode Whether the file was opened in append mode.
+		void _fprepare(bool appendMode);
 		/// @brief Closes file.
-		void _fclose();
+		/// @return True if the OS could write all remaining data and close the file.
+		bool _fclose();
+		/// @brief Writes buffered data and flushes the OS file buffer.
+		/// @return True if the OS file buffer could be flushed.
+		bool _fflush();
 		/// @brief Reads data from the file.
 		/// @param[in] buffer Destination data buffer.
 		/// @param[in] count Number of elements to read.
@@ -147,6 +261,37 @@ namespace hltypes
 		/// @param[in] seekMode Seeking mode.
 		/// @return True if successful.
 		bool _fseek(int64_t offset, SeekMode seekMode = SeekMode::Current);
+		/// @brief Writes pending data from the buffer or discards read-ahead data.
+		/// @note Afterwards the OS file position is the same as the logical position.
+		void _fdiscardBuffer();
+		/// @brief Reads data from the OS file without buffering.
+		/// @param[in] buffer Destination data buffer.
+		/// @param[in] count Number of bytes to read.
+		/// @return Number of bytes read.
+		int _freadDirect(void* buffer, int count);
+		/// @brief Writes data to the OS file without buffering.
+		/// @param[in] buffer Source data buffer.
+		/// @param[in] count Number of bytes contained in buffer.
+		/// @return Number of bytes written.
+		int _fwriteDirect(const void* buffer, int count);
+		/// @brief Moves the OS file position to the given position.
+		/// @param[in] position The new position.
+		/// @note The C standard requires repositioning when switching between reading and writing.
+		void _freposition(int64_t position);
+		/// @brief Reads data from a position into multiple buffers.
+		/// @param[in] offset Position in the file.
+		/// @param[in] vectors The destination buffers.
+		/// @param[in] count Number of buffers.
+		/// @return Number of bytes read.
+		int64_t _freadAt(int64_t offset, const IoVector* vectors, int count);
+		/// @brief Writes data from multiple buffers to a position.
+		/// @param[in] offset Position in the file.
+		/// @param[in] vectors The source buffers.
+		/// @param[in] count Number of buffers.
+		/// @return Number of bytes written.
+		int64_t _fwriteAt(int64_t offset, const IoVector* vectors, int count);
+		/// @brief Writes all pending data to the OS so positional I/O sees it.
+		void _fprepareDirectAccess();
 
 		/// @brief Checks if a file exists.
 		/// @param[in] filename Name of the file.
@@ -177,6 +322,8 @@ typedef hltypes::FileBase hfbase;
 /// @brief Alias for simpler code.
 typedef hltypes::FileInfo hfinfo;
 /// @brief Alias for simpler code.
+typedef hltypes::IoVector hiovector;
+/// @brief Alias for simpler code.
 typedef hltypes::FileBase::AccessMode hfaccess;
 
 #endif
@@ -15,6 +15,8 @@
 
 #include <stdio.h>
 
+#include "harray.h"
+#include "hatomicfile.h"
 #include "hfbase.h"
 #include "hstring.h"
 
@@ -22,6 +24,8 @@
 
 namespace hltypes
 {
+	class AsyncRequest;
+
 	/// @brief Provides high level file handling.
 	/// @note When writing, \\r may be used, but \\r will be removed during read.
 	class hltypesExport File : public FileBase
@@ -42,6 +46,9 @@ namespace hltypes
 		void open(const String& filename, AccessMode accessMode);
 		/// @brief Closes file.
 		void close();
+		/// @brief Writes all buffered data to the file and flushes the OS file buffer.
+		/// @see setBufferSize()
+		void flush();
 		
 		/// @brief Creates a file.
 		/// @param[in] filename Name of the file.
@@ -83,9 +90,11 @@ namespace hltypes
 		/// @param[in] oldFilename Old name of the file.
 		/// @param[in] newFilename New name of the file.
 		/// @param[in] overwrite Whether to overwrite an already existing file.
+		/// @param[in] preserveTimes Whether the new file gets the access and modification times of the old file.
 		/// @return True if file was copied. False if old file does not exist or file with the new name already exists.
 		/// @note If path does not exist, it will be created.
-		static bool copy(const String& oldFilename, const String& newFilename, bool overwrite = false);
+		/// @note The copy is done by the OS where possible (e.g. copy_file_range() or sendfile() on Linux) and falls back to copying through a large buffer.
+		static bool copy(const String& oldFilename, const String& newFilename, bool overwrite = false, bool preserveTimes = false);
 		/// @brief Opens file, reads data and closes file.
 		/// @see read(int count)
 		static String hread(const String& filename, int count);
@@ -98,10 +107,54 @@ namespace hltypes
 		/// @brief Opens file, appends data and closes file.
 		/// @see write
 		static void happend(const String& filename, const String& text);
+		/// @brief Replaces a file atomically with new text.
+		/// @param[in] filename Name of the file.
+		/// @param[in] text The text.
+		/// @param[in] syncMode How the data and the directory are synced.
+		/// @return True if the file was replaced.
+		/// @see AtomicFile
+		static bool writeAtomic(const String& filename, const String& text, AtomicFile::SyncMode syncMode = AtomicFile::SyncMode::Data);
+		/// @brief Replaces a file atomically with new data.
+		/// @param[in] filename Name of the file.
+		/// @param[in] data The data.
+		/// @param[in] size Size of the data.
+		/// @param[in] syncMode How the data and the directory are synced.
+		/// @return True if the file was replaced.
+		/// @see AtomicFile
+		static bool writeAtomic(const String& filename, const unsigned char* data, int size, AtomicFile::SyncMode syncMode = AtomicFile::SyncMode::Data);
+		/// @brief Reads a file on an I/O thread without blocking.
+		/// @param[in] filename Name of the file.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation. The text can be read from its stream once it's done.
+		/// @see AsyncFile
+		static AsyncRequest* hreadAsync(const String& filename, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Writes a file on an I/O thread without blocking.
+		/// @param[in] filename Name of the file.
+		/// @param[in] text The text.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation.
+		/// @see AsyncFile
+		static AsyncRequest* hwriteAsync(const String& filename, const String& text, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
+		/// @brief Appends to a file on an I/O thread without blocking.
+		/// @param[in] filename Name of the file.
+		/// @param[in] text The text.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation.
+		/// @see AsyncFile
+		static AsyncRequest* happendAsync(const String& filename, const String& text, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
 		/// @brief Gets the file information provided by the OS.
 		/// @param[in] filename The filename of the file.
 		/// @return File information provided by the OS.
 		static FileInfo hinfo(const String& filename);
+		/// @brief Gets the file information provided by the OS for many files at once.
+		/// @param[in] filenames The filenames of the files.
+		/// @param[in] threadCount Maximum number of threads that get the information in parallel.
+		/// @return File information provided by the OS in the same order. Files that don't exist have a size of -1.
+		/// @note Consecutive files in the same directory are looked up relative to that directory, so sorting the filenames helps.
+		static Array<FileInfo> hinfo(const Array<String>& filenames, int threadCount = 1);
 
 	protected:
 		/// @brief Reads data from the stream.
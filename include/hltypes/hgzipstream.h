@@ -0,0 +1,82 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides streaming gzip compression and decompression on top of other streams.
+
+#ifndef HLTYPES_GZIP_STREAM_H
+#define HLTYPES_GZIP_STREAM_H
+
+#include <stdint.h>
+
+#include "hdeflatestream.h"
+#include "hsbase.h"
+#include "hstring.h"
+
+#include "hltypesExport.h"
+
+namespace hltypes
+{
+	/// @brief Compresses data into or decompresses data from another stream in the gzip format (RFC 1952).
+	/// @note Only a single gzip member is read, the other stream is positioned right after it.
+	/// @note The CRC-32 and the size in the trailer are verified when the end of the data is reached.
+	class hltypesExport GzipStream : public DeflateStream
+	{
+	public:
+		/// @brief Constructor.
+		/// @param[in] stream The stream with the compressed data. It's not owned by the GzipStream.
+		/// @param[in] mode Whether to compress or decompress.
+		/// @param[in] level Compression level from 0 (no compression) to 9 (best compression). Ignored when decompressing.
+		/// @param[in] bufferSize Size of the input and output buffers.
+		GzipStream(StreamBase* stream, Mode mode, int level = HL_DEFLATE_DEFAULT_LEVEL, int bufferSize = HL_DEFLATE_BUFFER_SIZE);
+		/// @brief Destructor.
+		/// @note Calls finish() if compressing, errors are only logged.
+		~GzipStream();
+
+	protected:
+		/// @brief CRC-32 of the uncompressed data.
+		unsigned int crc;
+		/// @brief Size of the uncompressed data modulo 2^32.
+		unsigned int uncompressedSize;
+
+		/// @brief Gets special descriptor.
+		/// @return Special descriptor.
+		inline String _descriptor() const { return "gzip stream"; }
+
+		/// @brief Gets the window bits for raw deflate data.
+		/// @return The window bits.
+		int _windowBits() const;
+		/// @brief Writes the gzip header.
+		void _writeHeader();
+		/// @brief Writes the CRC-32 and the size of the uncompressed data.
+		void _writeTrailer();
+		/// @brief Reads and validates the gzip header.
+		void _readHeader();
+		/// @brief Reads and verifies the CRC-32 and the size of the uncompressed data.
+		void _readTrailer();
+		/// @brief Updates the CRC-32 and the size of the uncompressed data.
+		/// @param[in] data Uncompressed data.
+		/// @param[in] size Size of the data.
+		void _updateChecksum(const unsigned char* data, int size);
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		GzipStream(const GzipStream& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		GzipStream& operator=(GzipStream& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::GzipStream hgzipstream;
+
+#endif
@@ -0,0 +1,109 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides buffered line-by-line reading from streams.
+
+#ifndef HLTYPES_LINE_READER_H
+#define HLTYPES_LINE_READER_H
+
+#include <stdint.h>
+
+#include "hltypesExport.h"
+#include "hstring.h"
+
+/// @brief Default size of the LineReader read-ahead buffer.
+#define HL_LINE_READER_BUFFER_SIZE 65536
+
+namespace hltypes
+{
+	class StreamBase;
+
+	/// @brief Reads lines from a StreamBase through an internal read-ahead buffer.
+	/// @note Each byte is read from the stream and searched for the delimiter only once, regardless of the line length.
+	/// @note The stream is read ahead so its position is usually past the last returned line. Use position() for the logical position.
+	class hltypesExport LineReader
+	{
+	public:
+		/// @brief Basic constructor.
+		/// @param[in] stream The StreamBase to read from.
+		/// @param[in] delimiter String that separates lines.
+		/// @param[in] bufferSize Initial size of the read-ahead buffer. The buffer grows if a line doesn't fit.
+		LineReader(StreamBase* stream, const String& delimiter = "\n", int bufferSize = HL_LINE_READER_BUFFER_SIZE);
+		/// @brief Destructor.
+		~LineReader();
+
+		/// @brief Gets the StreamBase.
+		/// @return The StreamBase.
+		inline StreamBase* getStream() const { return this->stream; }
+		/// @brief Gets the delimiter.
+		/// @return The delimiter.
+		inline const String& getDelimiter() const { return this->delimiter; }
+
+		/// @brief Reads the next line without copying it.
+		/// @param[out] outData Pointer to the line's first character inside the internal buffer.
+		/// @param[out] outSize Byte length of the line.
+		/// @return True if a line was read, false if the end of the stream was reached.
+		/// @note The data stays valid only until the next call of next() or reset(). It is not null-terminated.
+		/// @note The delimiter and a trailing \\r character are not included in the line.
+		bool next(const char*& outData, int& outSize);
+		/// @brief Reads the next line into a String.
+		/// @param[out] outLine The line.
+		/// @return True if a line was read, false if the end of the stream was reached.
+		/// @note outLine's storage is reused so iterating with the same String does not allocate for every line.
+		/// @note The delimiter and a trailing \\r character are not included in the line.
+		bool next(String& outLine);
+		/// @brief Gets the stream position right after the last returned line.
+		/// @return The stream position.
+		/// @note Only valid if the stream wasn't used directly since the last reset().
+		int64_t position() const;
+		/// @brief Discards all read-ahead data.
+		/// @note Use this after seeking the stream directly.
+		void reset();
+
+	protected:
+		/// @brief The StreamBase.
+		StreamBase* stream;
+		/// @brief Line delimiter.
+		String delimiter;
+		/// @brief Read-ahead buffer.
+		char* buffer;
+		/// @brief Allocated size of the buffer.
+		int bufferCapacity;
+		/// @brief Start of unreturned data in the buffer.
+		int bufferStart;
+		/// @brief End of read data in the buffer.
+		int bufferEnd;
+		/// @brief Where the next delimiter search starts so already searched bytes aren't searched again.
+		int searchStart;
+		/// @brief Whether the end of the stream was reached.
+		bool streamEnded;
+
+		/// @brief Finds the next delimiter in data that wasn't searched yet.
+		/// @return Pointer to the delimiter or NULL if not found.
+		const char* _findDelimiter();
+		/// @brief Reads more data from the stream.
+		/// @note Moves unreturned data to the front of the buffer and grows the buffer if it's still full.
+		void _fill();
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		LineReader(const LineReader& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		LineReader& operator=(LineReader& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::LineReader hlinereader;
+
+#endif
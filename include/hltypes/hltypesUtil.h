@@ -26,6 +26,7 @@
 
 namespace hltypes
 {
+	class MappedFile;
 	class Stream;
 	class StreamBase;
 
@@ -66,6 +67,10 @@ namespace hltypes
 /// @return atan in degrees.
 /// @note This uses atan2.
 #define hatan(x, y) (atan2(x, y) * __HL_RAD_TO_DEG_RATIO)
+#if __cplusplus >= 201103L || defined(_MSC_VER) && _MSC_VER >= 1600
+/// @brief Defined if the compiler supports rvalue references so move constructors and move assignment operators are available.
+#define HL_RVALUE_REFERENCES
+#endif
 /// @brief hltypes e-tolerance.
 #define HL_E_TOLERANCE 0.0001
 /// @brief Calculates const C-array size.
@@ -471,12 +476,13 @@ hltypesFnExport int64_t hpotFloor(int64_t value);
 /// @param[in] data Data stream.
 /// @param[in] size Size of the data stream.
 /// @return CRC32 value of the stream.
-hltypesFnExport unsigned int hcrc32(const unsigned char* data, unsigned int size);
+hltypesFnExport unsigned int hcrc32(const unsigned char* data, int64_t size);
 /// @brief Calculates CRC32 from a StreamBase.
 /// @param[in] stream StreamBase from which to calculate the CRC32.
 /// @param[in] size Number of bytes to read for CRC32.
 /// @return CRC32 value of the StreamBase.
-hltypesFnExport unsigned int hcrc32(hltypes::StreamBase* stream, unsigned int size);
+/// @note The data is read in blocks, so the StreamBase may be larger than the available memory.
+hltypesFnExport unsigned int hcrc32(hltypes::StreamBase* stream, int64_t size);
 /// @brief Calculates CRC32 from a StreamBase.
 /// @param[in] stream StreamBase from which to calculate the CRC32.
 /// @return CRC32 value of the StreamBase.
@@ -485,11 +491,22 @@ hltypesFnExport unsigned int hcrc32(hltypes::StreamBase* stream);
 /// @param[in] stream Stream from which to calculate the CRC32.
 /// @param[in] size Number of bytes to read for CRC32.
 /// @return CRC32 value of the Stream.
-hltypesFnExport unsigned int hcrc32(hltypes::Stream* stream, unsigned int size);
+hltypesFnExport unsigned int hcrc32(hltypes::Stream* stream, int64_t size);
 /// @brief Calculates CRC32 from a Stream.
 /// @param[in] stream Stream from which to calculate the CRC32.
 /// @return CRC32 value of the Stream.
 hltypesFnExport unsigned int hcrc32(hltypes::Stream* stream);
+/// @brief Calculates CRC32 from a MappedFile.
+/// @param[in] file MappedFile from which to calculate the CRC32.
+/// @param[in] size Number of bytes to read for CRC32.
+/// @return CRC32 value of the MappedFile.
+/// @note The CRC32 is calculated directly from the mapped data.
+hltypesFnExport unsigned int hcrc32(hltypes::MappedFile* file, int64_t size);
+/// @brief Calculates CRC32 from a MappedFile.
+/// @param[in] file MappedFile from which to calculate the CRC32.
+/// @return CRC32 value of the MappedFile.
+/// @note The CRC32 is calculated directly from the mapped data.
+hltypesFnExport unsigned int hcrc32(hltypes::MappedFile* file);
 
 /// @brief Returns the lesser of two elements.
 /// @param[in] a First element.
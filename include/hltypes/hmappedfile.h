@@ -0,0 +1,121 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides read-only access to files mapped into memory.
+
+#ifndef HLTYPES_MAPPED_FILE_H
+#define HLTYPES_MAPPED_FILE_H
+
+#include <stdint.h>
+
+#include "hltypesUtil.h"
+#include "hsbase.h"
+#include "hstring.h"
+
+#include "hltypesExport.h"
+
+namespace hltypes
+{
+	/// @brief Provides read-only access to a file that is mapped into memory.
+	/// @note Reading and seeking behave like with File, but the data can also be accessed directly without copying it.
+	/// @note If the platform can't map the file (e.g. empty files or WinRT), the whole file is read into memory instead.
+	class hltypesExport MappedFile : public StreamBase
+	{
+	public:
+		/// @brief Basic constructor.
+		MappedFile();
+		/// @brief Destructor.
+		~MappedFile();
+		/// @brief Opens and maps a file.
+		/// @param[in] filename Name of the file (may include path).
+		/// @param[in] privateCopy Whether pages are mapped copy-on-write so the data may be modified in memory without changing the file.
+		/// @note If this instance is already working with a mapped file, that file will be closed.
+		void open(const String& filename, bool privateCopy = false);
+		/// @brief Unmaps and closes the file.
+		void close();
+
+		/// @brief Gets the filename.
+		HL_DEFINE_GET(String, filename, Filename);
+		/// @brief Gets the mapped data.
+		/// @return Pointer to the first byte of the file or NULL if not open.
+		/// @note The data must not be modified unless the file was opened with privateCopy.
+		inline unsigned char* getData() const { return this->data; }
+		/// @brief Checks whether a 0 byte directly follows the mapped data.
+		/// @return True if the data can be used as a null-terminated string.
+		/// @note Mappings are zero-padded to the page size, so this is only false if the file size is a multiple of the page size.
+		bool isNullTerminated() const;
+
+		/// @brief Gets a byte at a position.
+		/// @param[in] index Position of the byte.
+		/// @return The byte.
+		const unsigned char& operator[](int index) const;
+		/// @brief Casts MappedFile into a const unsigned char pointer.
+		/// @return The mapped data.
+		inline operator const unsigned char*() const { return this->data; }
+		/// @brief Casts MappedFile into a const char pointer.
+		/// @return The mapped data.
+		inline operator const char*() const { return (const char*)this->data; }
+
+	protected:
+		/// @brief Filename of the file.
+		String filename;
+		/// @brief The mapped data.
+		unsigned char* data;
+		/// @brief Platform mapping handle. NULL if the data was read into memory instead.
+		void* handle;
+		/// @brief Whether the data is mapped or was read into memory.
+		bool mapped;
+		/// @brief Current position in the data.
+		int64_t streamPosition;
+
+		/// @brief Does nothing, the size of the mapping never changes.
+		void _updateDataSize();
+
+		/// @brief Gets special descriptor.
+		/// @return Special descriptor.
+		inline String _descriptor() const { return this->filename; }
+		/// @brief Reads data from the mapping.
+		/// @param[in] buffer Destination data buffer.
+		/// @param[in] count Number of bytes to read.
+		/// @return Number of bytes read.
+		int _read(void* buffer, int count);
+		/// @brief Writing is not supported.
+		/// @param[in] buffer Source data buffer.
+		/// @param[in] count Number of bytes contained in buffer.
+		/// @return Never returns, always throws an exception.
+		int _write(const void* buffer, int count);
+		/// @brief Checks if a file is mapped.
+		/// @return True if a file is mapped.
+		bool _isOpen() const;
+		/// @brief Gets current position in the data.
+		/// @return Current position in the data.
+		int64_t _position() const;
+		/// @brief Seeks to position in the data.
+		/// @param[in] offset Seeking offset in bytes.
+		/// @param[in] seekMode Seeking mode.
+		/// @return True if successful.
+		/// @note Like with File, seeking past the end is allowed.
+		bool _seek(int64_t offset, SeekMode seekMode = SeekMode::Current);
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		MappedFile(const MappedFile& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		MappedFile& operator=(MappedFile& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::MappedFile hmappedfile;
+
+#endif
@@ -0,0 +1,168 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides an optional cache for file and directory existence checks and directory listings.
+
+#ifndef HLTYPES_PATH_CACHE_H
+#define HLTYPES_PATH_CACHE_H
+
+#include <stdint.h>
+
+#include "harray.h"
+#include "hdir.h"
+#include "hmap.h"
+#include "hmutex.h"
+#include "hstring.h"
+
+#include "hltypesExport.h"
+
+/// @brief Default time in seconds after which PathCache entries expire.
+#define HL_PATH_CACHE_TIME_TO_LIVE 1.0f
+
+namespace hltypes
+{
+	class Thread;
+
+	/// @brief Caches the results of File::exists(), Dir::exists() and Dir::scan() (and everything built on it).
+	/// @note The cache is disabled by default. Changes done through File and Dir invalidate the affected paths automatically.
+	/// @note Changes done by other processes or without hltypes are only noticed when entries expire or, if watching is enabled, when the OS reports them.
+	/// @note Directory removal, clearing and copying always list directories directly and never use cached listings.
+	class hltypesExport PathCache
+	{
+	public:
+		friend class Dir;
+		friend class FileBase;
+
+		/// @brief Checks whether the cache is used.
+		/// @return True if the cache is used.
+		static bool isEnabled();
+		/// @brief Sets whether the cache is used.
+		/// @param[in] value Whether the cache is used.
+		/// @note Disabling the cache clears it and stops watching.
+		static void setEnabled(bool value);
+		/// @brief Gets the time in seconds after which entries expire.
+		/// @return The time in seconds after which entries expire.
+		static float getTimeToLive();
+		/// @brief Sets the time in seconds after which entries expire.
+		/// @param[in] value The time in seconds after which entries expire. 0 or less means entries only expire through invalidation.
+		static void setTimeToLive(float value);
+		/// @brief Checks whether directories of cached entries are watched for changes.
+		/// @return True if directories are watched for changes.
+		static bool isWatching();
+		/// @brief Sets whether directories of cached entries are watched for changes.
+		/// @param[in] value Whether directories are watched for changes.
+		/// @return True if watching is supported on this platform (inotify on Linux).
+		/// @note A background thread invalidates entries as soon as the OS reports changes in their directories.
+		static bool setWatching(bool value);
+		/// @brief Gets the number of lookups that were answered from the cache.
+		/// @return The number of cache hits.
+		static int64_t getHits();
+		/// @brief Gets the number of lookups that had to access the file system.
+		/// @return The number of cache misses.
+		static int64_t getMisses();
+		/// @brief Resets the hit and miss counters.
+		static void resetCounters();
+
+		/// @brief Invalidates a path, everything below it and the listing of its parent directory.
+		/// @param[in] path The path.
+		static void invalidate(const String& path);
+		/// @brief Removes all entries.
+		static void clear();
+
+	protected:
+		/// @brief A cached existence check.
+		struct StatEntry
+		{
+			/// @brief Whether the path exists.
+			bool exists;
+			/// @brief The type of the path if it exists.
+			DirEntry::Type type;
+			/// @brief The tick count when the entry was created.
+			int64_t time;
+		};
+
+		/// @brief A cached directory listing.
+		struct ListingEntry
+		{
+			/// @brief The directory entries.
+			Array<DirEntry> entries;
+			/// @brief The tick count when the entry was created.
+			int64_t time;
+		};
+
+		/// @brief Whether the cache is used.
+		static volatile bool enabled;
+		/// @brief The time in seconds after which entries expire.
+		static float timeToLive;
+		/// @brief Number of cache hits.
+		static int64_t hits;
+		/// @brief Number of cache misses.
+		static int64_t misses;
+		/// @brief Cached existence checks.
+		static Map<String, StatEntry> stats;
+		/// @brief Cached directory listings.
+		static Map<String, ListingEntry> listings;
+		/// @brief Incremented by every invalidation so results that were read during an invalidation aren't cached.
+		static int64_t generation;
+		/// @brief Protects all cache data.
+		static Mutex mutex;
+		/// @brief The thread that processes change notifications.
+		static Thread* watchThread;
+		/// @brief The OS handle for change notifications.
+		static int watchHandle;
+		/// @brief Watched directories by watch ID.
+		static Map<int, String> watchedDirectories;
+		/// @brief Watch IDs by watched directory.
+		static Map<String, int> watchIds;
+
+		/// @brief Basic constructor.
+		/// @note Forces this to be a static class.
+		inline PathCache() { }
+
+		/// @brief Checks whether a file exists.
+		/// @param[in] name Normalized name of the file.
+		/// @return True if the file exists.
+		static bool _fileExists(const String& name);
+		/// @brief Checks whether a directory exists.
+		/// @param[in] name Normalized name of the directory.
+		/// @return True if the directory exists.
+		static bool _directoryExists(const String& name);
+		/// @brief Lists a directory or gets its cached listing.
+		/// @param[in] name Normalized name of the directory.
+		/// @return Array of all directory entries without "." and "..".
+		static Array<DirEntry> _scan(const String& name);
+		/// @brief Gets the cached existence check of a path.
+		/// @param[in] name Normalized path.
+		/// @return The cached existence check.
+		static StatEntry _getStat(const String& name);
+		/// @brief Checks whether an entry created at some time has expired.
+		/// @param[in] time The tick count when the entry was created.
+		/// @return True if the entry has expired.
+		static bool _isExpired(int64_t time);
+		/// @brief Invalidates a path without locking the mutex.
+		/// @param[in] path Normalized path.
+		/// @param[in] parent Whether the listing of the parent directory is invalidated as well.
+		static void _invalidate(const String& path, bool parent);
+		/// @brief Starts watching a directory without locking the mutex.
+		/// @param[in] dirName Normalized name of the directory.
+		static void _watch(const String& dirName);
+		/// @brief Stops watching all directories and stops the watch thread.
+		static void _stopWatching();
+		/// @brief Processes change notifications.
+		/// @param[in] thread The watch thread.
+		static void _processChanges(Thread* thread);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::PathCache hpathcache;
+
+#endif
@@ -21,10 +21,12 @@
 
 namespace hltypes
 {
+	class AsyncRequest;
 	class ResourceDir;
 
 	/// @brief Provides high level resource file handling.
 	/// @note When writing, \\r may be used, but \\r will be removed during read.
+	/// @note Files in ZIP archives are decompressed while they are read, so memory usage doesn't depend on the file size. Seeking back continues from periodically saved decompressor states.
 	class hltypesExport Resource : public FileBase
 	{
 	public:
@@ -40,6 +42,10 @@ namespace hltypes
 		void open(const String& filename);
 		/// @brief Closes resource file.
 		void close();
+		/// @brief Gets the file information of the opened resource file.
+		/// @return File information provided by the implementation.
+		/// @note Uses the archive entry if resources are read from an archive.
+		FileInfo info();
 		
 		/// @brief Checks if a resource file exists.
 		/// @param[in] filename Name of the resource file.
@@ -53,6 +59,13 @@ namespace hltypes
 		/// @brief Opens file, reads data and closes file.
 		/// @see read
 		static String hread(const String& filename, const String& delimiter = "");
+		/// @brief Reads a resource file on an I/O thread without blocking.
+		/// @param[in] filename Name of the resource file.
+		/// @param[in] callback Function called on the I/O thread when the operation completed or failed.
+		/// @param[in] userData User data for the callback.
+		/// @return The queued operation. The text can be read from its stream once it's done.
+		/// @see AsyncFile
+		static AsyncRequest* hreadAsync(const String& filename, void (*callback)(AsyncRequest*) = NULL, void* userData = NULL);
 		/// @brief Gets the file information provided by the implementation.
 		/// @param[in] filename The filename of the file.
 		/// @return File information provided by the implementation.
@@ -21,6 +21,9 @@
 #include "hltypesExport.h"
 #include "hstring.h"
 
+/// @brief Size of the blocks in which StreamBase::loadArray() allocates memory for Arrays.
+#define HL_STREAM_ARRAY_BLOCK_SIZE 65536
+
 namespace hltypes
 {
 	class Stream;
@@ -80,7 +83,7 @@ namespace hltypes
 		/// @brief Reads n bytes from the stream.
 		/// @param[in] count Number of bytes to read.
 		/// @return The read string.
-		String read(int count);
+		String read(int64_t count);
 		/// @brief Reads one line from the stream.
 		/// @return The read line.
 		/// @note \\n is not included in the returned String.
@@ -110,31 +113,34 @@ namespace hltypes
 		/// @param[in] count Number of bytes to read.
 		/// @return Number of bytes read.
 		/// @note If return value differs from parameter count, it can indicate a reading error or that end of file has been reached.
-		int readRaw(void* buffer, int count);
+		/// @note Counts over 2 GB are read in chunks, because the underlying OS calls are limited.
+		int64_t readRaw(void* buffer, int64_t count);
 		/// @brief Writes raw data to the stream.
 		/// @param[in] buffer Pointer to raw data buffer.
 		/// @param[in] count Number of bytes to write.
 		/// @return Number of bytes written.
 		/// @note If return value differs from parameter count, it can indicate a writing error.
-		virtual int writeRaw(void* buffer, int count);
+		/// @note Counts over 2 GB are written in chunks, because the underlying OS calls are limited.
+		virtual int64_t writeRaw(void* buffer, int64_t count);
 		/// @brief Writes raw data to the stream from another stream.
 		/// @param[in] stream Another stream.
 		/// @param[in] count Number of bytes to write.
 		/// @return Number of bytes written.
-		virtual int writeRaw(StreamBase& stream, int count);
+		/// @note The data is copied in blocks through a buffer that only exists during the call.
+		virtual int64_t writeRaw(StreamBase& stream, int64_t count);
 		/// @brief Writes raw data to the stream from another stream.
 		/// @param[in] stream Another stream.
 		/// @return Number of bytes written.
-		virtual int writeRaw(StreamBase& stream);
+		virtual int64_t writeRaw(StreamBase& stream);
 		/// @brief Writes raw data to the stream from another stream.
 		/// @param[in] stream Another stream.
 		/// @param[in] count Number of bytes to write.
 		/// @return Number of bytes written.
-		virtual int writeRaw(Stream& stream, int count);
+		virtual int64_t writeRaw(Stream& stream, int64_t count);
 		/// @brief Writes raw data to the stream from another stream.
 		/// @param[in] stream Another stream.
 		/// @return Number of bytes written.
-		virtual int writeRaw(Stream& stream);
+		virtual int64_t writeRaw(Stream& stream);
 
 		/// @brief Dumps data to file in a platform-aware format.
 		/// @param c char to dump.
@@ -178,6 +184,89 @@ namespace hltypes
 		/// @param c C-type string to dump.
 		virtual void dump(const char* c);
 
+		/// @brief Dumps an array of char values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const char* data, int64_t count);
+		/// @brief Dumps an array of unsigned char values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const unsigned char* data, int64_t count);
+		/// @brief Dumps an array of short values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const short* data, int64_t count);
+		/// @brief Dumps an array of unsigned short values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const unsigned short* data, int64_t count);
+		/// @brief Dumps an array of int values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const int* data, int64_t count);
+		/// @brief Dumps an array of unsigned int values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const unsigned int* data, int64_t count);
+		/// @brief Dumps an array of int64 values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const int64_t* data, int64_t count);
+		/// @brief Dumps an array of unsigned int64 values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const uint64_t* data, int64_t count);
+		/// @brief Dumps an array of float values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const float* data, int64_t count);
+		/// @brief Dumps an array of double values in a platform-aware format with a single write.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements written.
+		int64_t dumpArray(const double* data, int64_t count);
+		/// @brief Dumps an Array in a platform-aware format with a single write.
+		/// @param[in] data The Array.
+		/// @note The number of elements is dumped first, the same way dump(const String&) does it.
+		/// @note Only Arrays of types supported by dumpArray(const T*, int64_t) can be dumped this way.
+		template <typename T>
+		inline void dumpArray(const Array<T>& data)
+		{
+			int size = data.size();
+			this->dump(size);
+			if (size > 0)
+			{
+				this->dumpArray((const T*)data, size);
+			}
+		}
+
+		/// @brief Dumps an unsigned integer as LEB128 varint.
+		/// @param[in] value The value.
+		/// @note Uses 1 byte for values below 128 and at most 10 bytes for the full 64-bit range.
+		void dumpVarint(uint64_t value);
+		/// @brief Dumps a signed integer as zigzag-encoded LEB128 varint.
+		/// @param[in] value The value.
+		/// @note Zigzag encoding keeps small negative values small, e.g. -1 uses only 1 byte.
+		void dumpSignedVarint(int64_t value);
+		/// @brief Dumps a String with a varint length prefix.
+		/// @param[in] string String to dump.
+		/// @note Strings shorter than 128 bytes use only 1 byte for the length instead of the 4 bytes used by dump(const String&).
+		void dumpCompactString(const String& string);
+		/// @brief Dumps bool values packed as bits.
+		/// @param[in] values Pointer to the first value.
+		/// @param[in] count Number of values.
+		/// @note Uses (count + 7) / 8 bytes. The first value is stored in the lowest bit of the first byte.
+		void dumpBitfield(const bool* values, int count);
+
 		/// @brief Loads data from file in a platform-aware format.
 		/// @return Loaded char.
 		virtual char loadInt8();
@@ -214,6 +303,99 @@ namespace hltypes
 		/// @brief Loads data from file in a platform-aware format.
 		/// @return Loaded String.
 		virtual String loadString();
+		/// @brief Loads an unsigned LEB128 varint.
+		/// @return Loaded value.
+		/// @note Throws an exception if the stream ends within the varint or if it's longer than 10 bytes.
+		uint64_t loadVarint();
+		/// @brief Loads a zigzag-encoded signed LEB128 varint.
+		/// @return Loaded value.
+		int64_t loadSignedVarint();
+		/// @brief Loads a String with a varint length prefix.
+		/// @return Loaded String.
+		String loadCompactString();
+		/// @brief Loads bool values packed as bits.
+		/// @param[out] values Pointer to the first value of the destination.
+		/// @param[in] count Number of values.
+		/// @return Number of values loaded.
+		int loadBitfield(bool* values, int count);
+		/// @brief Loads an array of char values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(char* data, int64_t count);
+		/// @brief Loads an array of unsigned char values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(unsigned char* data, int64_t count);
+		/// @brief Loads an array of short values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(short* data, int64_t count);
+		/// @brief Loads an array of unsigned short values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(unsigned short* data, int64_t count);
+		/// @brief Loads an array of int values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(int* data, int64_t count);
+		/// @brief Loads an array of unsigned int values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(unsigned int* data, int64_t count);
+		/// @brief Loads an array of int64 values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(int64_t* data, int64_t count);
+		/// @brief Loads an array of unsigned int64 values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(uint64_t* data, int64_t count);
+		/// @brief Loads an array of float values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(float* data, int64_t count);
+		/// @brief Loads an array of double values in a platform-aware format with a single read.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @return Number of elements read.
+		int64_t loadArray(double* data, int64_t count);
+		/// @brief Loads an Array in a platform-aware format with a single read.
+		/// @param[out] outData The Array.
+		/// @return Number of elements read.
+		/// @note Counterpart of dumpArray(const Array<T>&). Previous elements of outData are removed.
+		/// @note Memory is allocated in blocks while the data is read so a corrupted size can't cause a huge allocation.
+		template <typename T>
+		inline int loadArray(Array<T>& outData)
+		{
+			outData.clear();
+			int size = this->loadInt32();
+			int blockCount = (sizeof(T) < HL_STREAM_ARRAY_BLOCK_SIZE ? HL_STREAM_ARRAY_BLOCK_SIZE / (int)sizeof(T) : 1);
+			int result = 0;
+			int count = 0;
+			int read = 0;
+			while (result < size)
+			{
+				count = (size - result < blockCount ? size - result : blockCount);
+				outData.add(T(), count);
+				read = (int)this->loadArray(&outData[result], count);
+				result += read;
+				if (read < count)
+				{
+					outData.removeAt(result, count - read);
+					break;
+				}
+			}
+			return result;
+		}
 		
 	protected:
 		/// @brief Data size, mostly used for optimization and faster "eof" detection.
@@ -223,6 +405,18 @@ namespace hltypes
 		virtual void _updateDataSize();
 		/// @brief Checks if object can be used.
 		virtual void _validate() const;
+		/// @brief Writes array elements in little endian byte order.
+		/// @param[in] data Pointer to the first element.
+		/// @param[in] count Number of elements.
+		/// @param[in] elementSize Size of one element in bytes.
+		/// @return Number of elements written.
+		int64_t _dumpArray(const void* data, int64_t count, int elementSize);
+		/// @brief Reads array elements stored in little endian byte order.
+		/// @param[out] data Pointer to the first element of the destination.
+		/// @param[in] count Number of elements.
+		/// @param[in] elementSize Size of one element in bytes.
+		/// @return Number of elements read.
+		int64_t _loadArray(void* data, int64_t count, int elementSize);
 
 		/// @brief Gets special descriptor.
 		/// @return Special descriptor.
@@ -0,0 +1,152 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides in-memory data streaming in fixed-size segments.
+
+#ifndef HLTYPES_SEGMENTED_STREAM_H
+#define HLTYPES_SEGMENTED_STREAM_H
+
+#include <stdint.h>
+
+#include "harray.h"
+#include "hltypesUtil.h"
+#include "hsbase.h"
+
+#include "hltypesExport.h"
+
+/// @brief Default size of a single SegmentedStream segment.
+#define HL_SEGMENTED_STREAM_SEGMENT_SIZE 1048576
+
+namespace hltypes
+{
+	class Stream;
+
+	/// @brief Provides in-memory data streaming that grows by appending fixed-size segments.
+	/// @note Unlike Stream, growing never reallocates or copies already written data.
+	/// @note The data is not contiguous. Use the segment accessors for scatter-gather style access or flatten() to get a contiguous copy.
+	class hltypesExport SegmentedStream : public StreamBase
+	{
+	public:
+		/// @brief Constructor.
+		/// @param[in] segmentSize Size of a single segment in bytes.
+		SegmentedStream(int segmentSize = HL_SEGMENTED_STREAM_SEGMENT_SIZE);
+		/// @brief Destructor.
+		~SegmentedStream();
+
+		/// @brief Gets the size of a single segment.
+		HL_DEFINE_GET(int, segmentSize, SegmentSize);
+		/// @brief Gets the number of allocated segments.
+		/// @return The number of allocated segments.
+		inline int getSegmentCount() const { return this->segments.size(); }
+		/// @brief Gets the data of a segment.
+		/// @param[in] index Index of the segment.
+		/// @return Pointer to the segment's data.
+		inline unsigned char* getSegment(int index) const { return this->segments[index]; }
+		/// @brief Gets the number of used bytes in a segment.
+		/// @param[in] index Index of the segment.
+		/// @return Number of bytes in the segment that belong to the stream data.
+		int getSegmentDataSize(int index) const;
+
+		/// @brief Clears the SegmentedStream and releases all segments.
+		void clear();
+		/// @brief Truncates the SegmentedStream and releases segments that aren't needed anymore.
+		/// @param[in] targetSize The size the SegmentedStream should be truncated to.
+		/// @return True if the SegmentedStream was truncated.
+		/// @note If targetSize is greater or equal than the current size, the size stays unchanged.
+		bool truncate(int64_t targetSize);
+		/// @brief Copies all data into a contiguous buffer.
+		/// @param[out] output Destination buffer with at least size() bytes.
+		void flatten(unsigned char* output) const;
+		/// @brief Appends all data to a Stream.
+		/// @param[out] output The Stream.
+		/// @return True if the Stream's buffer could be enlarged and the data was written.
+		/// @note The Stream's capacity is adjusted only once before writing and it's never reduced.
+		bool flatten(Stream& output) const;
+
+		/// @brief Writes raw data to the SegmentedStream.
+		/// @param[in] buffer Pointer to raw data buffer.
+		/// @param[in] count Number of bytes to write.
+		/// @return Number of bytes written.
+		int64_t writeRaw(void* buffer, int64_t count);
+		/// @brief Writes raw data to the SegmentedStream from another stream.
+		/// @param[in] stream Another stream.
+		/// @param[in] count Number of bytes to write.
+		/// @return Number of bytes written.
+		/// @note The data is read directly into the segments.
+		int64_t writeRaw(StreamBase& stream, int64_t count);
+		/// @brief Writes raw data to the SegmentedStream from another stream.
+		/// @param[in] stream Another stream.
+		/// @return Number of bytes written.
+		int64_t writeRaw(StreamBase& stream);
+		/// @brief Writes raw data to the SegmentedStream from a Stream.
+		/// @param[in] stream The Stream.
+		/// @param[in] count Number of bytes to write.
+		/// @return Number of bytes written.
+		int64_t writeRaw(Stream& stream, int64_t count);
+		/// @brief Writes raw data to the SegmentedStream from a Stream.
+		/// @param[in] stream The Stream.
+		/// @return Number of bytes written.
+		int64_t writeRaw(Stream& stream);
+
+	protected:
+		/// @brief Allocated segments in order.
+		Array<unsigned char*> segments;
+		/// @brief Size of a single segment.
+		int segmentSize;
+		/// @brief Current position in the data.
+		int64_t streamPosition;
+
+		/// @brief Does nothing, the data size is always up to date.
+		void _updateDataSize();
+		/// @brief Makes sure there are enough segments for the data.
+		/// @param[in] size Required data size.
+		/// @return True if all segments could be allocated.
+		bool _reserveSegments(int64_t size);
+		/// @brief Releases segments that don't contain any data.
+		void _releaseSegments();
+
+		/// @brief Reads data from the SegmentedStream.
+		/// @param[in] buffer Destination data buffer.
+		/// @param[in] count Number of bytes to read.
+		/// @return Number of bytes read.
+		int _read(void* buffer, int count);
+		/// @brief Writes data to the SegmentedStream.
+		/// @param[in] buffer Source data buffer.
+		/// @param[in] count Number of bytes contained in buffer.
+		/// @return Number of bytes written.
+		int _write(const void* buffer, int count);
+		/// @brief Checks if data is "open".
+		/// @return Always true.
+		bool _isOpen() const;
+		/// @brief Gets current position in the data.
+		/// @return Current position in the data.
+		int64_t _position() const;
+		/// @brief Seeks to position in the data.
+		/// @param[in] offset Seeking offset in bytes.
+		/// @param[in] seekMode Seeking mode.
+		/// @return True if successful.
+		/// @note Like with Stream, the position is clamped to the data.
+		bool _seek(int64_t offset, SeekMode seekMode = SeekMode::Current);
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		SegmentedStream(const SegmentedStream& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		SegmentedStream& operator=(SegmentedStream& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::SegmentedStream hsegstream;
+
+#endif
@@ -26,6 +26,11 @@ namespace hltypes
 		/// @param[in] maxCount The max lock count.
 		/// @param[in] name The internal name.
 		Semaphore(int maxCount, const String& name = "");
+		/// @brief Constructor with an initial lock count.
+		/// @param[in] maxCount The max lock count.
+		/// @param[in] initialCount The initial lock count. With 0 lock() waits until another thread calls unlock().
+		/// @param[in] name The internal name.
+		Semaphore(int maxCount, int initialCount, const String& name = "");
 		/// @brief Destructor.
 		~Semaphore();
 
@@ -51,6 +56,10 @@ namespace hltypes
 		/// @brief Semaphore name.
 		String name;
 
+		/// @brief Creates the OS semaphore.
+		/// @param[in] initialCount The initial lock count.
+		void _create(int initialCount);
+
 	private:
 		/// @brief Copy constructor.
 		/// @note Usage is not allowed and it will throw an exception.
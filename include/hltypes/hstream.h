@@ -13,6 +13,7 @@
 #ifndef HLTYPES_FILE_STREAM_H
 #define HLTYPES_FILE_STREAM_H
 
+#include "hltypesUtil.h"
 #include "hsbase.h"
 #include "hltypesExport.h"
 #define MIN_HSTREAM_CAPACITY 16
@@ -26,69 +27,90 @@ namespace hltypes
 		/// @brief Constructor.
 		/// @param[in] initialCapacity Initial capacity of the internal buffer.
 		/// @note initialCapacity is used to prevent unnecessary calls to realloc() internally if it's not needed. This is NOT the Stream's initial size.
-		Stream(int initialCapacity = MIN_HSTREAM_CAPACITY);
+		Stream(int64_t initialCapacity = MIN_HSTREAM_CAPACITY);
 		/// @brief Constructor.
 		/// @param[in] initialData Initial data in the Stream.
 		/// @param[in] initialDataSize Initial data's size.
 		/// @note initialData is copied into the Stream.
-		Stream(unsigned char* initialData, int initialDataSize);
+		Stream(unsigned char* initialData, int64_t initialDataSize);
 		/// @brief Constructor.
 		/// @param[in] initialData Initial data in the Stream.
 		/// @param[in] initialDataSize Initial data's size.
 		/// @param[in] initialCapacity Initial capacity of the internal buffer.
 		/// @note initialData is copied into the Stream. initialCapacity will be corrected to initialDataSize if less than initialDataSize.
-		Stream(unsigned char* initialData, int initialDataSize, int initialCapacity);
+		Stream(unsigned char* initialData, int64_t initialDataSize, int64_t initialCapacity);
 		/// @brief Copy constructor.
 		/// @param[in] other Other Stream.
 		Stream(const Stream& other);
+#ifdef HL_RVALUE_REFERENCES
+		/// @brief Move constructor.
+		/// @param[in] other Other Stream. Its buffer is taken over without copying and it's left empty.
+		Stream(Stream&& other);
+#endif
 		/// @brief Destructor.
 		~Stream();
 		/// @brief Clears the Stream.
 		/// @param[in] newCapacity New capacity of the internal buffer.
 		/// @note newCapacity is used to prevent unnecessary calls to realloc() internally if it's not needed. This is NOT the Stream's initial size.
-		void clear(int newCapacity = MIN_HSTREAM_CAPACITY);
+		void clear(int64_t newCapacity = MIN_HSTREAM_CAPACITY);
+		/// @brief Gets the capacity of the internal buffer.
+		/// @return The capacity of the internal buffer.
+		inline int64_t getCapacity() const { return this->capacity; }
 		/// @brief Resizes internal buffer.
 		/// @param[in] newCapacity New capacity of the internal buffer.
 		/// @return True if internal buffer was resized or already the same size that was requested.
 		/// @note This does not change the data stream size. Use this to avoid allocation of too much data if not needed.
 		/// @note If newCapacity is smaller than the stream size, data will be lost and the Stream will be resized.
-		bool setCapacity(int newCapacity);
+		bool setCapacity(int64_t newCapacity);
+		/// @brief Takes over an existing buffer without copying it.
+		/// @param[in] data Buffer allocated with malloc(). It will be freed by the Stream.
+		/// @param[in] size Size of the data in the buffer.
+		/// @param[in] capacity Allocated size of the buffer. Corrected to size if less than size.
+		/// @note The previous data is released and the position is set to the start.
+		void adopt(unsigned char* data, int64_t size, int64_t capacity = 0);
+		/// @brief Hands out the internal buffer without copying it.
+		/// @return Buffer allocated with malloc() that contains size() bytes of data. The caller has to free() it.
+		/// @note Get the size before calling this, the Stream is empty afterwards.
+		unsigned char* release();
+		/// @brief Exchanges data, size and position with another Stream without copying.
+		/// @param[in] other Other Stream.
+		void swap(Stream& other);
 		/// @brief Writes raw data to the Stream.
 		/// @param[in] buffer Pointer to raw data buffer.
 		/// @param[in] count Number of bytes to write.
 		/// @return Number of bytes written.
 		/// @note If return value differs from parameter count, it can indicate a writing error.
-		int writeRaw(void* buffer, int count);
+		int64_t writeRaw(void* buffer, int64_t count);
 		/// @brief Writes raw data to the Stream from another Stream.
 		/// @param[in] stream Another Stream.
 		/// @param[in] count Number of bytes to write.
 		/// @return Number of bytes written.
-		int writeRaw(StreamBase& stream, int count);
+		int64_t writeRaw(StreamBase& stream, int64_t count);
 		/// @brief Writes raw data to the Stream from another Stream.
 		/// @param[in] stream Another Stream.
 		/// @return Number of bytes written.
-		int writeRaw(StreamBase& stream);
+		int64_t writeRaw(StreamBase& stream);
 		/// @brief Writes raw data to the Stream from another Stream.
 		/// @param[in] stream Another Stream.
 		/// @param[in] count Number of bytes to write.
 		/// @return Number of bytes written.
-		int writeRaw(Stream& stream, int count);
+		int64_t writeRaw(Stream& stream, int64_t count);
 		/// @brief Writes raw data to the Stream from another Stream.
 		/// @param[in] stream Another Stream.
 		/// @return Number of bytes written.
-		int writeRaw(Stream& stream);
+		int64_t writeRaw(Stream& stream);
 		/// @brief Prepares Stream for manual writing without using write_raw() directly.
 		/// @param[in] count Number of bytes to prepare. Stream size is increased if necessary, but contains garbage data.
 		/// @return Number of bytes ready to be written.
 		/// @note Use this when you intend to manually write data. This does not change the current position and seeking has to be done manually as well.
 		/// @see writeRaw
-		int prepareManualWriteRaw(int count);
+		int64_t prepareManualWriteRaw(int64_t count);
 		/// @brief Writes a certain value into the buffer.
 		/// @param[in] value The value.
 		/// @param[in] count Number of bytes to write.
 		/// @return Number of bytes written.
 		/// @note If return value differs from parameter count, it can indicate a writing error.
-		int fill(unsigned char value, int count);
+		int64_t fill(unsigned char value, int64_t count);
 		/// @brief Truncates the Stream and removes data.
 		/// @param[in] targetSize The size the Stream should be truncated to.
 		/// @return True if Stream was truncated/reduced.
@@ -98,10 +120,21 @@ namespace hltypes
 		/// @param[in] index Reference to a specific element.
 		/// @return Direct reference to the internal steam.
 		const unsigned char& operator[](int index) const;
+		/// @brief Gets a direct reference to the internal steam.
+		/// @param[in] index Reference to a specific element.
+		/// @return Direct reference to the internal steam.
+		/// @note Both overloads exist, because a single int64_t one would be ambiguous with the built-in subscript of the pointer casts on 32 bit platforms.
+		const unsigned char& operator[](int64_t index) const;
 		/// @brief Copies the other Stream into this one.
 		/// @param[in] other Other Stream.
 		/// @return This modified Stream.
 		Stream& operator=(const Stream& other);
+#ifdef HL_RVALUE_REFERENCES
+		/// @brief Moves the other Stream into this one.
+		/// @param[in] other Other Stream. Its buffer is taken over without copying and it's left empty.
+		/// @return This modified Stream.
+		Stream& operator=(Stream&& other);
+#endif
 		/// @brief Casts this Array into a C-array.
 		/// @return The C-array.
 		operator char*() const;
@@ -151,7 +184,7 @@ namespace hltypes
 		/// @brief Resizes internal buffer if necessary.
 		/// @param[in,out] write_size Number of bytes that is needed for the next write.
 		/// @note This does not change the data stream size. Use this to avoid allocation of too much data if not needed.
-		bool _tryIncreaseCapacity(int& write_size);
+		bool _tryIncreaseCapacity(int64_t& write_size);
 
 	};
 }
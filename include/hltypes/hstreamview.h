@@ -0,0 +1,106 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides read-only streaming of external memory.
+
+#ifndef HLTYPES_STREAM_VIEW_H
+#define HLTYPES_STREAM_VIEW_H
+
+#include <stdint.h>
+
+#include "hltypesUtil.h"
+#include "hsbase.h"
+
+#include "hltypesExport.h"
+
+namespace hltypes
+{
+	class Stream;
+
+	/// @brief Provides read-only streaming of memory that is owned by someone else.
+	/// @note The memory is never copied or freed and has to stay valid as long as the StreamView is used.
+	class hltypesExport StreamView : public StreamBase
+	{
+	public:
+		/// @brief Basic constructor.
+		/// @param[in] data The data.
+		/// @param[in] size Size of the data.
+		StreamView(const unsigned char* data, int64_t size);
+		/// @brief Constructor that views the data of a Stream.
+		/// @param[in] stream The Stream.
+		/// @note The view becomes invalid if the Stream is modified.
+		StreamView(const Stream& stream);
+		/// @brief Destructor.
+		~StreamView();
+
+		/// @brief Gets the viewed data.
+		/// @return The viewed data.
+		inline const unsigned char* getData() const { return this->data; }
+		/// @brief Gets a byte at a position.
+		/// @param[in] index Position of the byte.
+		/// @return The byte.
+		const unsigned char& operator[](int index) const;
+		/// @brief Casts StreamView into a const unsigned char pointer.
+		/// @return The viewed data.
+		inline operator const unsigned char*() const { return this->data; }
+		/// @brief Casts StreamView into a const char pointer.
+		/// @return The viewed data.
+		inline operator const char*() const { return (const char*)this->data; }
+
+	protected:
+		/// @brief The viewed data.
+		const unsigned char* data;
+		/// @brief Current position in the data.
+		int64_t streamPosition;
+
+		/// @brief Does nothing, the size of the viewed data never changes.
+		void _updateDataSize();
+
+		/// @brief Gets special descriptor.
+		/// @return Special descriptor.
+		inline String _descriptor() const { return "stream view"; }
+		/// @brief Reads data from the StreamView.
+		/// @param[in] buffer Destination data buffer.
+		/// @param[in] count Number of bytes to read.
+		/// @return Number of bytes read.
+		int _read(void* buffer, int count);
+		/// @brief Writing is not supported.
+		/// @param[in] buffer Source data buffer.
+		/// @param[in] count Number of bytes contained in buffer.
+		/// @return Never returns, always throws an exception.
+		int _write(const void* buffer, int count);
+		/// @brief Checks if data is "open".
+		/// @return Always true.
+		bool _isOpen() const;
+		/// @brief Gets current position in the data.
+		/// @return Current position in the data.
+		int64_t _position() const;
+		/// @brief Seeks to position in the data.
+		/// @param[in] offset Seeking offset in bytes.
+		/// @param[in] seekMode Seeking mode.
+		/// @return True if successful.
+		/// @note Like with Stream, the position is clamped to the data.
+		bool _seek(int64_t offset, SeekMode seekMode = SeekMode::Current);
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		StreamView(const StreamView& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		StreamView& operator=(StreamView& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::StreamView hstreamview;
+
+#endif
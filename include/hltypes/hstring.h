@@ -31,9 +31,17 @@ namespace std
 }
 #endif
 
+namespace hltypes
+{
+	class String;
+}
+
+hltypesFnExport hltypes::String hvsprintf(const char* format, va_list args);
+
 namespace hltypes
 {
 	template <typename T> class Array;
+	class StringBuilder;
 	
 	/// @brief Encapsulates std::string and adds high level methods.
 	class hltypesSpecialExport String : std::basic_string<char>
@@ -578,6 +586,12 @@ namespace hltypes
 		/// @return True if String starts with s.
 		hltypesMemberExport bool startsWith(const char* string) const;
 		/// @brief Checks if the string starts with a specific string.
+		/// @param[in] string The C-type string to check.
+		/// @param[in] length Byte length of the C-type string.
+		/// @return True if String starts with s.
+		/// @note Use HL_LITERAL() with string literals to have the length calculated at compile time.
+		hltypesMemberExport bool startsWith(const char* string, int length) const;
+		/// @brief Checks if the string starts with a specific string.
 		/// @param[in] string The String to check.
 		/// @return True if String starts with s.
 		hltypesMemberExport bool startsWith(const String& string) const;
@@ -586,6 +600,12 @@ namespace hltypes
 		/// @return True if String ends with s.
 		hltypesMemberExport bool endsWith(const char* string) const;
 		/// @brief Checks if the string ends with a specific string.
+		/// @param[in] string The C-type string to check.
+		/// @param[in] length Byte length of the C-type string.
+		/// @return True if String ends with s.
+		/// @note Use HL_LITERAL() with string literals to have the length calculated at compile time.
+		hltypesMemberExport bool endsWith(const char* string, int length) const;
+		/// @brief Checks if the string ends with a specific string.
 		/// @param[in] string The String to check.
 		/// @return True if String ends with s.
 		hltypesMemberExport bool endsWith(const String& string) const;
@@ -660,13 +680,18 @@ namespace hltypes
 		/// @brief Gets the character length of the String.
 		/// @return Character length of String.
 		hltypesMemberExport int utf8Size() const;
+		/// @brief Calculates a hash value of the String's bytes.
+		/// @return The hash value.
+		/// @note Uses 32-bit FNV-1a.
+		hltypesMemberExport unsigned int hash() const;
 		/// @brief Creates a string with characters converted using the %02X format.
 		/// @return String of hex values of the characters.
+		/// @see hhexEncode
 		hltypesMemberExport String toHex() const;
 		/// @brief Creates an unsigned int from hex value string.
 		/// @return An unsigned int.
-		/// @note Will return 0 if string is not a hex number. Use String::is_hex() to check first.
-		/// @note Hex strings above 0xFFFFFFFF cause undefined behavior.
+		/// @note Will return 0 if string is not a hex number. Use String::isHex() to check first.
+		/// @note Only the last 8 digits of longer hex strings are used.
 		hltypesMemberExport unsigned int unhex() const;
 
 		/// @brief Returns character at position in form of String.
@@ -822,6 +847,7 @@ namespace hltypes
 		/// @brief Compares String for equivalency.
 		/// @param[in] string String value.
 		/// @return True if other String is equal to this one.
+		/// @note Lengths are compared first so most unequal Strings are rejected without looking at the data.
 		hltypesMemberExport bool operator==(const String& string) const;
 		/// @brief Compares String for equivalency.
 		/// @param[in] b bool value.
@@ -985,9 +1011,26 @@ namespace hltypes
 		/// @return UTF-8 string.
 		hltypesMemberExport static String fromUnicode(Array<unsigned char> chars);
 
+	private:
+		/// @brief Compares the String with other data in the same way as strcmp() does, but without scanning for the terminating character.
+		/// @param[in] string The data.
+		/// @param[in] length Byte length of the data.
+		/// @return Negative if this String is ordered before the data, positive if after and 0 if equal.
+		hltypesMemberExport int _compare(const char* string, int length) const;
+
+		/// @brief Allows StringBuilder to allocate the final storage only once.
+		friend class StringBuilder;
+		/// @brief Allows formatting directly into the String's storage.
+		friend hltypes::String (::hvsprintf)(const char* format, va_list args);
+
 	};
 }
 
+/// @brief Expands a string literal into the C-type string and its length known at compile time.
+/// @param[in] literal The string literal.
+/// @note Meant for String methods that take a C-type string and its length, e.g. startsWith(HL_LITERAL("abc")).
+#define HL_LITERAL(literal) (literal), ((int)sizeof(literal) - 1)
+
 /// @brief Alias for simpler code.
 typedef hltypes::String hstr;
 /// @brief Alias for simpler code.
@@ -1017,6 +1060,7 @@ hltypesFnExport inline hltypes::String operator+(char* string1, const hltypes::S
 /// @param[in] format C-type string containing format.
 /// @param[in] args Variable argument list.
 /// @return Formatted String.
+/// @note Short results are formatted on the stack, longer ones are measured first and then formatted directly into the String.
 hltypesFnExport hltypes::String hvsprintf(const char* format, va_list args);
 /// @brief Applies formatting to a string.
 /// @param[in] format C-type string containing format.
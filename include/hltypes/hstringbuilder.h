@@ -0,0 +1,336 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides functionality for incrementally building Strings.
+
+#ifndef HLTYPES_STRING_BUILDER_H
+#define HLTYPES_STRING_BUILDER_H
+
+#include <stdint.h>
+
+#include "hltypesExport.h"
+#include "hstring.h"
+
+/// @brief Size of the chunk that is stored directly inside a StringBuilder.
+#define HL_STRING_BUILDER_LOCAL_SIZE 256
+
+namespace hltypes
+{
+	/// @brief Provides an appendable chunked buffer that creates a String in a single allocation.
+	/// @note Unlike String::operator+, appending never creates temporary String objects and never moves already appended data.
+	class hltypesExport StringBuilder
+	{
+	public:
+		/// @brief Basic constructor.
+		/// @param[in] capacity Expected final size. Helps avoid chunk allocations if known in advance.
+		StringBuilder(int capacity = 0);
+		/// @brief Destructor.
+		~StringBuilder();
+
+		/// @brief Gets the number of appended bytes.
+		/// @return The number of appended bytes.
+		inline int size() const { return this->dataSize; }
+
+		/// @brief Removes all appended data.
+		/// @note Allocated chunks are released, except the local one.
+		void clear();
+
+		/// @brief Appends a character.
+		/// @param[in] c Character value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const char c);
+		/// @brief Appends a character multiple times.
+		/// @param[in] c Character value.
+		/// @param[in] times Number of repetitions.
+		/// @return This StringBuilder.
+		StringBuilder& add(const char c, int times);
+		/// @brief Appends a C-type string.
+		/// @param[in] string C-type string value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const char* string);
+		/// @brief Appends a C-type string.
+		/// @param[in] string C-type string value.
+		/// @param[in] length Number of bytes to append.
+		/// @return This StringBuilder.
+		StringBuilder& add(const char* string, int length);
+		/// @brief Appends a String.
+		/// @param[in] string String value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const String& string);
+		/// @brief Appends a bool as "true" or "false".
+		/// @param[in] b Bool value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const bool b);
+		/// @brief Appends a short in decimal notation.
+		/// @param[in] s Short value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const short s);
+		/// @brief Appends an unsigned short in decimal notation.
+		/// @param[in] s Unsigned short value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const unsigned short s);
+		/// @brief Appends an int in decimal notation.
+		/// @param[in] i Int value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const int i);
+		/// @brief Appends an unsigned int in decimal notation.
+		/// @param[in] i Unsigned int value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const unsigned int i);
+		/// @brief Appends a 64-bit int in decimal notation.
+		/// @param[in] i 64-bit int value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const int64_t i);
+		/// @brief Appends an unsigned 64-bit int in decimal notation.
+		/// @param[in] i Unsigned 64-bit int value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const uint64_t i);
+		/// @brief Appends a float with 6 decimal places.
+		/// @param[in] f Float value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const float f);
+		/// @brief Appends a float.
+		/// @param[in] f Float value.
+		/// @param[in] precision Number of decimal places.
+		/// @return This StringBuilder.
+		StringBuilder& add(const float f, int precision);
+		/// @brief Appends a double with 6 decimal places.
+		/// @param[in] d Double value.
+		/// @return This StringBuilder.
+		StringBuilder& add(const double d);
+		/// @brief Appends a double.
+		/// @param[in] d Double value.
+		/// @param[in] precision Number of decimal places.
+		/// @return This StringBuilder.
+		StringBuilder& add(const double d, int precision);
+		/// @brief Appends an unsigned int in hexadecimal notation.
+		/// @param[in] value The value.
+		/// @param[in] minDigits Minimum number of digits, padded with zeroes.
+		/// @return This StringBuilder.
+		/// @note Uses uppercase digits like the %X format.
+		StringBuilder& addHex(unsigned int value, int minDigits = 1);
+		/// @brief Appends a pointer address.
+		/// @param[in] pointer The pointer.
+		/// @return This StringBuilder.
+		/// @note Uses the %p format. Without this, pointers would be converted to bool.
+		StringBuilder& add(const void* pointer);
+
+		/// @brief Appends format text up to the next "{}" placeholder.
+		/// @param[in] format Format string.
+		/// @return Pointer to the text after the placeholder or to the terminating character if there is no placeholder.
+		/// @note "{{" and "}}" are appended as a single "{" and "}". Used by hformat().
+		const char* addFormatText(const char* format);
+		/// @brief Appends the remaining format text after the last placeholder.
+		/// @param[in] format Format string.
+		/// @note "{{" and "}}" are appended as a single "{" and "}", placeholders without arguments are appended as they are. Used by hformat().
+		void addFormatEnd(const char* format);
+
+		/// @brief Creates a String from all appended data.
+		/// @return The String.
+		/// @note The String's storage is allocated only once.
+		String toString() const;
+
+	protected:
+		/// @brief A single continuous block of data.
+		struct Chunk
+		{
+			/// @brief The data.
+			char* data;
+			/// @brief Number of used bytes.
+			int size;
+			/// @brief Number of allocated bytes.
+			int capacity;
+		};
+
+		/// @brief Chunks with appended data in order.
+		Chunk* chunks;
+		/// @brief Number of used chunks.
+		int chunkCount;
+		/// @brief Number of allocated Chunk entries.
+		int chunkCapacity;
+		/// @brief Total number of appended bytes.
+		int dataSize;
+		/// @brief Data of the first chunk.
+		char localData[HL_STRING_BUILDER_LOCAL_SIZE];
+		/// @brief Storage for the first chunk entry.
+		Chunk localChunk;
+
+		/// @brief Appends a new empty chunk.
+		/// @param[in] capacity Capacity of the new chunk.
+		void _addChunk(int capacity);
+		/// @brief Reserves space at the end of the last chunk.
+		/// @param[in] size Number of bytes that will be written.
+		/// @return Pointer to the reserved space.
+		/// @note Adds a new chunk if there is not enough space in the last one.
+		char* _reserve(int size);
+		/// @brief Appends an unsigned 64-bit value in decimal notation.
+		/// @param[in] value The value.
+		/// @param[in] negative Whether a minus sign should be prepended.
+		void _addDecimal(uint64_t value, bool negative);
+		/// @brief Appends a floating point value in fixed notation.
+		/// @param[in] value The value.
+		/// @param[in] precision Number of decimal places.
+		void _addFixed(double value, int precision);
+		/// @brief Appends a floating point value in fixed notation using printf.
+		/// @param[in] value The value.
+		/// @param[in] precision Number of decimal places.
+		/// @note Used for values that _addFixed() can't format exactly like printf.
+		void _addFixedFormatted(double value, int precision);
+		/// @brief Appends format text up to the next "{}" placeholder.
+		/// @param[in] format Format string.
+		/// @param[in] placeholders Whether to stop at placeholders or to append them as they are.
+		/// @return Pointer to the text after the placeholder or to the terminating character.
+		const char* _addFormatText(const char* format, bool placeholders);
+
+	private:
+		/// @brief Copy constructor.
+		/// @note Usage is not allowed and it will throw an exception.
+		StringBuilder(const StringBuilder& other);
+		/// @brief Assignment operator.
+		/// @note Usage is not allowed and it will throw an exception.
+		StringBuilder& operator=(StringBuilder& other);
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::StringBuilder hstrbuilder;
+
+/// @brief Applies type-safe formatting to a string.
+/// @param[in] format C-type string containing "{}" placeholders.
+/// @param[in] arg0 The first argument.
+/// @return Formatted String.
+/// @note Arguments are converted with StringBuilder::add() so no format specifiers are needed.
+template <typename T0>
+inline hltypes::String hformat(const char* format, const T0& arg0)
+{
+	hltypes::StringBuilder builder;
+	format = builder.addFormatText(format);
+	builder.add(arg0);
+	builder.addFormatEnd(format);
+	return builder.toString();
+}
+/// @brief Applies type-safe formatting to a string.
+/// @param[in] format C-type string containing "{}" placeholders.
+/// @param[in] arg0 The first argument.
+/// @param[in] arg1 The second argument.
+/// @return Formatted String.
+/// @note Arguments are converted with StringBuilder::add() so no format specifiers are needed.
+template <typename T0, typename T1>
+inline hltypes::String hformat(const char* format, const T0& arg0, const T1& arg1)
+{
+	hltypes::StringBuilder builder;
+	format = builder.addFormatText(format);
+	builder.add(arg0);
+	format = builder.addFormatText(format);
+	builder.add(arg1);
+	builder.addFormatEnd(format);
+	return builder.toString();
+}
+/// @brief Applies type-safe formatting to a string.
+/// @param[in] format C-type string containing "{}" placeholders.
+/// @param[in] arg0 The first argument.
+/// @param[in] arg1 The second argument.
+/// @param[in] arg2 The third argument.
+/// @return Formatted String.
+/// @note Arguments are converted with StringBuilder::add() so no format specifiers are needed.
+template <typename T0, typename T1, typename T2>
+inline hltypes::String hformat(const char* format, const T0& arg0, const T1& arg1, const T2& arg2)
+{
+	hltypes::StringBuilder builder;
+	format = builder.addFormatText(format);
+	builder.add(arg0);
+	format = builder.addFormatText(format);
+	builder.add(arg1);
+	format = builder.addFormatText(format);
+	builder.add(arg2);
+	builder.addFormatEnd(format);
+	return builder.toString();
+}
+/// @brief Applies type-safe formatting to a string.
+/// @param[in] format C-type string containing "{}" placeholders.
+/// @param[in] arg0 The first argument.
+/// @param[in] arg1 The second argument.
+/// @param[in] arg2 The third argument.
+/// @param[in] arg3 The fourth argument.
+/// @return Formatted String.
+/// @note Arguments are converted with StringBuilder::add() so no format specifiers are needed.
+template <typename T0, typename T1, typename T2, typename T3>
+inline hltypes::String hformat(const char* format, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3)
+{
+	hltypes::StringBuilder builder;
+	format = builder.addFormatText(format);
+	builder.add(arg0);
+	format = builder.addFormatText(format);
+	builder.add(arg1);
+	format = builder.addFormatText(format);
+	builder.add(arg2);
+	format = builder.addFormatText(format);
+	builder.add(arg3);
+	builder.addFormatEnd(format);
+	return builder.toString();
+}
+/// @brief Applies type-safe formatting to a string.
+/// @param[in] format C-type string containing "{}" placeholders.
+/// @param[in] arg0 The first argument.
+/// @param[in] arg1 The second argument.
+/// @param[in] arg2 The third argument.
+/// @param[in] arg3 The fourth argument.
+/// @param[in] arg4 The fifth argument.
+/// @return Formatted String.
+/// @note Arguments are converted with StringBuilder::add() so no format specifiers are needed.
+template <typename T0, typename T1, typename T2, typename T3, typename T4>
+inline hltypes::String hformat(const char* format, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4)
+{
+	hltypes::StringBuilder builder;
+	format = builder.addFormatText(format);
+	builder.add(arg0);
+	format = builder.addFormatText(format);
+	builder.add(arg1);
+	format = builder.addFormatText(format);
+	builder.add(arg2);
+	format = builder.addFormatText(format);
+	builder.add(arg3);
+	format = builder.addFormatText(format);
+	builder.add(arg4);
+	builder.addFormatEnd(format);
+	return builder.toString();
+}
+/// @brief Applies type-safe formatting to a string.
+/// @param[in] format C-type string containing "{}" placeholders.
+/// @param[in] arg0 The first argument.
+/// @param[in] arg1 The second argument.
+/// @param[in] arg2 The third argument.
+/// @param[in] arg3 The fourth argument.
+/// @param[in] arg4 The fifth argument.
+/// @param[in] arg5 The sixth argument.
+/// @return Formatted String.
+/// @note Arguments are converted with StringBuilder::add() so no format specifiers are needed.
+template <typename T0, typename T1, typename T2, typename T3, typename T4, typename T5>
+inline hltypes::String hformat(const char* format, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5)
+{
+	hltypes::StringBuilder builder;
+	format = builder.addFormatText(format);
+	builder.add(arg0);
+	format = builder.addFormatText(format);
+	builder.add(arg1);
+	format = builder.addFormatText(format);
+	builder.add(arg2);
+	format = builder.addFormatText(format);
+	builder.add(arg3);
+	format = builder.addFormatText(format);
+	builder.add(arg4);
+	format = builder.addFormatText(format);
+	builder.add(arg5);
+	builder.addFormatEnd(format);
+	return builder.toString();
+}
+
+#endif
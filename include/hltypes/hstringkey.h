@@ -0,0 +1,73 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides a String with a cached hash value for use as a Map key.
+
+#ifndef HLTYPES_STRING_KEY_H
+#define HLTYPES_STRING_KEY_H
+
+#include "hltypesExport.h"
+#include "hstring.h"
+
+namespace hltypes
+{
+	/// @brief String with a cached hash value for use as a Map key.
+	/// @note Comparisons look at the hash values first so most of them don't touch the String data.
+	/// @note The ordering is consistent, but it is not alphabetical.
+	class hltypesExport StringKey
+	{
+	public:
+		/// @brief Empty constructor.
+		inline StringKey() : hashValue(String().hash()) { }
+		/// @brief Basic constructor.
+		/// @param[in] string C-type string value.
+		inline StringKey(const char* string) : string(string), hashValue(this->string.hash()) { }
+		/// @brief Basic constructor.
+		/// @param[in] string String value.
+		inline StringKey(const String& string) : string(string), hashValue(string.hash()) { }
+
+		/// @brief Gets the String.
+		/// @return The String.
+		inline const String& getString() const { return this->string; }
+		/// @brief Gets the cached hash value.
+		/// @return The hash value.
+		inline unsigned int getHash() const { return this->hashValue; }
+
+		/// @brief Compares StringKeys for equivalency.
+		/// @param[in] other Other StringKey.
+		/// @return True if both StringKeys are equal.
+		inline bool operator==(const StringKey& other) const { return (this->hashValue == other.hashValue && this->string == other.string); }
+		/// @brief Compares StringKeys for non-equivalency.
+		/// @param[in] other Other StringKey.
+		/// @return True if the StringKeys are not equal.
+		inline bool operator!=(const StringKey& other) const { return !(*this == other); }
+		/// @brief Provides an ordering for Map.
+		/// @param[in] other Other StringKey.
+		/// @return True if this StringKey is ordered before the other one.
+		inline bool operator<(const StringKey& other) const
+		{
+			return (this->hashValue != other.hashValue ? this->hashValue < other.hashValue : this->string < other.string);
+		}
+		/// @brief Casts StringKey into String.
+		inline operator const String&() const { return this->string; }
+
+	protected:
+		/// @brief The String.
+		String string;
+		/// @brief The cached hash value.
+		unsigned int hashValue;
+
+	};
+}
+
+/// @brief Alias for simpler code.
+typedef hltypes::StringKey hstrkey;
+
+#endif
@@ -0,0 +1,387 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <limits.h>
+
+#include "harray.h"
+#include "hasyncfile.h"
+#include "hdeque.h"
+#include "hexception.h"
+#include "hfile.h"
+#include "hlog.h"
+#include "hltypesUtil.h"
+#include "hmutex.h"
+#include "hresource.h"
+#include "hsemaphore.h"
+#include "hstream.h"
+#include "hstring.h"
+#include "hthread.h"
+
+#define WAIT_SLEEP_TIME 1.0f
+
+namespace hltypes
+{
+	/// @brief I/O thread of AsyncFile.
+	class AsyncFileThread : public Thread
+	{
+	public:
+		Semaphore* semaphore;
+
+		AsyncFileThread(void (*function)(Thread*), Semaphore* semaphore, const String& name) : Thread(function, name), semaphore(semaphore) { }
+
+	};
+
+	HL_ENUM_CLASS_DEFINE(AsyncRequest::Type,
+	(
+		HL_ENUM_DEFINE(AsyncRequest::Type, Read);
+		HL_ENUM_DEFINE(AsyncRequest::Type, ReadResource);
+		HL_ENUM_DEFINE(AsyncRequest::Type, Write);
+		HL_ENUM_DEFINE(AsyncRequest::Type, Append);
+		HL_ENUM_DEFINE(AsyncRequest::Type, Copy);
+	));
+
+	HL_ENUM_CLASS_DEFINE(AsyncRequest::State,
+	(
+		HL_ENUM_DEFINE(AsyncRequest::State, Queued);
+		HL_ENUM_DEFINE(AsyncRequest::State, Running);
+		HL_ENUM_DEFINE(AsyncRequest::State, Completed);
+		HL_ENUM_DEFINE(AsyncRequest::State, Failed);
+		HL_ENUM_DEFINE(AsyncRequest::State, Cancelled);
+	));
+
+	AsyncRequest::AsyncRequest(Type type, const String& filename, void (*callback)(AsyncRequest*), void* userData) : overwrite(false), preserveTimes(false), state(State::Queued),
+		busy(false), idleSemaphore(NULL)
+	{
+		this->type = type;
+		this->filename = filename;
+		this->callback = callback;
+		this->userData = userData;
+	}
+
+	AsyncRequest::~AsyncRequest()
+	{
+		this->cancel();
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		if (this->busy)
+		{
+			Semaphore idleSemaphore(1, 0);
+			this->idleSemaphore = &idleSemaphore;
+			lock.release();
+			idleSemaphore.lock();
+			// the I/O thread holds the mutex until it's done with the semaphore
+			lock.acquire(&AsyncFile::mutex);
+		}
+	}
+
+	AsyncRequest::AsyncRequest(const AsyncRequest& other)
+	{
+		throw ObjectCannotCopyException("hltypes::AsyncRequest");
+	}
+
+	AsyncRequest& AsyncRequest::operator=(AsyncRequest& other)
+	{
+		throw ObjectCannotAssignException("hltypes::AsyncRequest");
+		return (*this);
+	}
+
+	AsyncRequest::State AsyncRequest::getState() const
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		return this->state;
+	}
+
+	bool AsyncRequest::isDone() const
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		return (this->state == State::Completed || this->state == State::Failed || this->state == State::Cancelled);
+	}
+
+	bool AsyncRequest::isCompleted() const
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		return (this->state == State::Completed);
+	}
+
+	bool AsyncRequest::wait(float timeout)
+	{
+		int64_t start = htickCount();
+		while (!this->isDone())
+		{
+			if (timeout > 0.0f && (float)(htickCount() - start) >= timeout)
+			{
+				return false;
+			}
+			Thread::sleep(WAIT_SLEEP_TIME);
+		}
+		return true;
+	}
+
+	bool AsyncRequest::cancel()
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		if (this->state != State::Queued)
+		{
+			return false;
+		}
+		AsyncFile::queue.remove(this);
+		this->state = State::Cancelled;
+		return true;
+	}
+
+	void AsyncRequest::_execute()
+	{
+		State result = State::Failed;
+		try
+		{
+			if (this->type == Type::Read)
+			{
+				File file;
+				file.open(this->filename);
+				this->stream.writeRaw(file);
+				this->stream.rewind();
+			}
+			else if (this->type == Type::ReadResource)
+			{
+				Resource resource;
+				resource.open(this->filename);
+				this->stream.writeRaw(resource);
+				this->stream.rewind();
+			}
+			else if (this->type == Type::Copy)
+			{
+				if (!File::copy(this->filename, this->newFilename, this->overwrite, this->preserveTimes))
+				{
+					throw Exception("Could not copy '" + this->filename + "' to '" + this->newFilename + "'!");
+				}
+			}
+			else
+			{
+				File file;
+				file.open(this->filename, this->type == Type::Append ? File::AccessMode::Append : File::AccessMode::Write);
+				this->stream.rewind();
+				file.writeRaw(this->stream);
+			}
+			result = State::Completed;
+		}
+		catch (hexception& e)
+		{
+			this->errorMessage = e.getMessage();
+		}
+		void (*callback)(AsyncRequest*) = this->callback;
+		// the AsyncRequest isn't accessed anymore after this so the callback can delete it
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		this->state = result;
+		this->busy = false;
+		if (this->idleSemaphore != NULL)
+		{
+			this->idleSemaphore->unlock();
+		}
+		lock.release();
+		if (callback != NULL)
+		{
+			(*callback)(this);
+		}
+	}
+
+	Array<Thread*> AsyncFile::threads;
+	int AsyncFile::threadCount = HL_ASYNC_FILE_THREAD_COUNT;
+	Deque<AsyncRequest*> AsyncFile::queue;
+	Mutex AsyncFile::mutex;
+	Semaphore* AsyncFile::semaphore = NULL;
+
+	int AsyncFile::getThreadCount()
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		return AsyncFile::threadCount;
+	}
+
+	void AsyncFile::setThreadCount(int value)
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		AsyncFile::threadCount = hmax(value, 1);
+	}
+
+	int AsyncFile::getQueuedCount()
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		return AsyncFile::queue.size();
+	}
+
+	AsyncRequest* AsyncFile::readAsync(const String& filename, void (*callback)(AsyncRequest*), void* userData)
+	{
+		AsyncRequest* request = new AsyncRequest(AsyncRequest::Type::Read, filename, callback, userData);
+		AsyncFile::_enqueue(Array<AsyncRequest*>(request));
+		return request;
+	}
+
+	Array<AsyncRequest*> AsyncFile::readAsync(const Array<String>& filenames, void (*callback)(AsyncRequest*), void* userData)
+	{
+		Array<AsyncRequest*> requests;
+		foreachc (String, it, filenames)
+		{
+			requests += new AsyncRequest(AsyncRequest::Type::Read, (*it), callback, userData);
+		}
+		AsyncFile::_enqueue(requests);
+		return requests;
+	}
+
+	AsyncRequest* AsyncFile::readResourceAsync(const String& filename, void (*callback)(AsyncRequest*), void* userData)
+	{
+		AsyncRequest* request = new AsyncRequest(AsyncRequest::Type::ReadResource, filename, callback, userData);
+		AsyncFile::_enqueue(Array<AsyncRequest*>(request));
+		return request;
+	}
+
+	AsyncRequest* AsyncFile::writeAsync(const String& filename, const Stream& data, void (*callback)(AsyncRequest*), void* userData)
+	{
+		AsyncRequest* request = new AsyncRequest(AsyncRequest::Type::Write, filename, callback, userData);
+		request->stream.writeRaw((unsigned char*)(const unsigned char*)data, data.size());
+		AsyncFile::_enqueue(Array<AsyncRequest*>(request));
+		return request;
+	}
+
+	AsyncRequest* AsyncFile::appendAsync(const String& filename, const Stream& data, void (*callback)(AsyncRequest*), void* userData)
+	{
+		AsyncRequest* request = new AsyncRequest(AsyncRequest::Type::Append, filename, callback, userData);
+		request->stream.writeRaw((unsigned char*)(const unsigned char*)data, data.size());
+		AsyncFile::_enqueue(Array<AsyncRequest*>(request));
+		return request;
+	}
+
+	AsyncRequest* AsyncFile::copyAsync(const String& oldFilename, const String& newFilename, bool overwrite, bool preserveTimes, void (*callback)(AsyncRequest*), void* userData)
+	{
+		AsyncRequest* request = new AsyncRequest(AsyncRequest::Type::Copy, oldFilename, callback, userData);
+		request->newFilename = newFilename;
+		request->overwrite = overwrite;
+		request->preserveTimes = preserveTimes;
+		AsyncFile::_enqueue(Array<AsyncRequest*>(request));
+		return request;
+	}
+
+	Array<AsyncRequest*> AsyncFile::copyAsync(const Array<String>& oldFilenames, const Array<String>& newFilenames, bool overwrite, bool preserveTimes, void (*callback)(AsyncRequest*), void* userData)
+	{
+		if (oldFilenames.size() != newFilenames.size())
+		{
+			throw ContainerRangeException(0, newFilenames.size());
+		}
+		Array<AsyncRequest*> requests;
+		AsyncRequest* request = NULL;
+		for_iter (i, 0, oldFilenames.size())
+		{
+			request = new AsyncRequest(AsyncRequest::Type::Copy, oldFilenames[i], callback, userData);
+			request->newFilename = newFilenames[i];
+			request->overwrite = overwrite;
+			request->preserveTimes = preserveTimes;
+			requests += request;
+		}
+		AsyncFile::_enqueue(requests);
+		return requests;
+	}
+
+	int AsyncFile::cancel(const Array<AsyncRequest*>& requests)
+	{
+		int result = 0;
+		foreachc (AsyncRequest*, it, requests)
+		{
+			if ((*it)->cancel())
+			{
+				++result;
+			}
+		}
+		return result;
+	}
+
+	void AsyncFile::wait(const Array<AsyncRequest*>& requests)
+	{
+		foreachc (AsyncRequest*, it, requests)
+		{
+			(*it)->wait();
+		}
+	}
+
+	void AsyncFile::finalize()
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		while (AsyncFile::queue.size() > 0)
+		{
+			AsyncFile::queue.removeFirst()->state = AsyncRequest::State::Cancelled;
+		}
+		Array<Thread*> threads = AsyncFile::threads;
+		AsyncFile::threads.clear();
+		Semaphore* semaphore = AsyncFile::semaphore;
+		AsyncFile::semaphore = NULL;
+		lock.release();
+		if (semaphore != NULL)
+		{
+			// the threads are woken up and stop, because they aren't in the list anymore
+			for_iter (i, 0, threads.size())
+			{
+				semaphore->unlock();
+			}
+		}
+		foreach (Thread*, it, threads)
+		{
+			(*it)->join();
+			delete (*it);
+		}
+		if (semaphore != NULL)
+		{
+			delete semaphore;
+		}
+	}
+
+	void AsyncFile::_enqueue(const Array<AsyncRequest*>& requests)
+	{
+		Mutex::ScopeLock lock(&AsyncFile::mutex);
+		if (AsyncFile::threads.size() == 0)
+		{
+			AsyncFile::semaphore = new Semaphore(INT_MAX, 0, "hltypes async file");
+			Thread* thread = NULL;
+			for_iter (i, 0, AsyncFile::threadCount)
+			{
+				thread = new AsyncFileThread(&AsyncFile::_process, AsyncFile::semaphore, hsprintf("hltypes async file %d", i));
+				AsyncFile::threads += thread;
+				thread->start();
+			}
+		}
+		foreachc (AsyncRequest*, it, requests)
+		{
+			AsyncFile::queue += (*it);
+			AsyncFile::semaphore->unlock();
+		}
+	}
+
+	void AsyncFile::_process(Thread* thread)
+	{
+		Semaphore* semaphore = ((AsyncFileThread*)thread)->semaphore;
+		AsyncRequest* request = NULL;
+		Mutex::ScopeLock lock;
+		while (true)
+		{
+			semaphore->lock();
+			lock.acquire(&AsyncFile::mutex);
+			// finalize() removes the threads from the list before waking them up
+			if (!AsyncFile::threads.has(thread))
+			{
+				break;
+			}
+			// the operation may have been cancelled already
+			if (AsyncFile::queue.size() == 0)
+			{
+				lock.release();
+				continue;
+			}
+			request = AsyncFile::queue.removeFirst();
+			request->state = AsyncRequest::State::Running;
+			request->busy = true;
+			lock.release();
+			request->_execute();
+		}
+	}
+
+}
@@ -0,0 +1,167 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hatom.h"
+#include "hltypesUtil.h"
+#include "hmutex.h"
+#include "hstring.h"
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+#define MIN_TABLE_CAPACITY 256
+#define ARENA_BLOCK_SIZE 65536
+#define ENTRY_ALIGNMENT 8
+
+namespace hltypes
+{
+	static Mutex accessMutex("hltypes::Atom");
+	static const void** table = NULL; // open addressing with linear probing, capacity is always a power of 2
+	static int tableCapacity = 0;
+	static int tableCount = 0;
+	static char* arenaBlock = NULL;
+	static int arenaRemaining = 0;
+
+	static unsigned int _hash(const char* string, int length)
+	{
+		unsigned int result = FNV_OFFSET_BASIS;
+		for_iter (i, 0, length)
+		{
+			result = (result ^ (unsigned char)string[i]) * FNV_PRIME;
+		}
+		return result;
+	}
+
+	// entries are never freed individually so they are packed into large blocks
+	static void* _allocate(int size)
+	{
+		size = (size + ENTRY_ALIGNMENT - 1) & ~(ENTRY_ALIGNMENT - 1);
+		if (size > ARENA_BLOCK_SIZE / 4)
+		{
+			return malloc(size);
+		}
+		if (size > arenaRemaining)
+		{
+			arenaBlock = (char*)malloc(ARENA_BLOCK_SIZE);
+			arenaRemaining = ARENA_BLOCK_SIZE;
+		}
+		void* result = arenaBlock;
+		arenaBlock += size;
+		arenaRemaining -= size;
+		return result;
+	}
+
+	struct EmptyEntry
+	{
+		unsigned int hash;
+		int size;
+		char data[1];
+	};
+	static const EmptyEntry emptyEntry = { FNV_OFFSET_BASIS, 0, { '\0' } };
+
+	Atom::Atom() : entry((const Entry*)&emptyEntry)
+	{
+	}
+
+	Atom::Atom(const char* string)
+	{
+		this->entry = Atom::_intern(string, (int)strlen(string), true);
+	}
+
+	Atom::Atom(const char* string, int length)
+	{
+		this->entry = Atom::_intern(string, length, true);
+	}
+
+	Atom::Atom(const String& string)
+	{
+		this->entry = Atom::_intern(string.cStr(), string.size(), true);
+	}
+
+	bool Atom::find(const String& string, Atom& outAtom)
+	{
+		const Entry* entry = Atom::_intern(string.cStr(), string.size(), false);
+		if (entry == NULL)
+		{
+			return false;
+		}
+		outAtom.entry = entry;
+		return true;
+	}
+
+	int Atom::getCount()
+	{
+		Mutex::ScopeLock lock(&accessMutex);
+		return tableCount;
+	}
+
+	const Atom::Entry* Atom::_intern(const char* string, int length, bool create)
+	{
+		if (length <= 0)
+		{
+			return (const Entry*)&emptyEntry;
+		}
+		unsigned int hash = _hash(string, length);
+		Mutex::ScopeLock lock(&accessMutex);
+		if (tableCapacity > 0)
+		{
+			unsigned int mask = (unsigned int)tableCapacity - 1;
+			for (unsigned int i = hash & mask; table[i] != NULL; i = (i + 1) & mask)
+			{
+				const Entry* entry = (const Entry*)table[i];
+				if (entry->hash == hash && entry->size == length && memcmp(entry->data, string, length) == 0)
+				{
+					return entry;
+				}
+			}
+		}
+		if (!create)
+		{
+			return NULL;
+		}
+		// load factor is kept below 3/4
+		if ((tableCount + 1) * 4 > tableCapacity * 3)
+		{
+			int newCapacity = hmax(tableCapacity * 2, MIN_TABLE_CAPACITY);
+			const void** newTable = (const void**)calloc(newCapacity, sizeof(void*));
+			unsigned int newMask = (unsigned int)newCapacity - 1;
+			for_iter (i, 0, tableCapacity)
+			{
+				if (table[i] != NULL)
+				{
+					unsigned int j = ((const Entry*)table[i])->hash & newMask;
+					while (newTable[j] != NULL)
+					{
+						j = (j + 1) & newMask;
+					}
+					newTable[j] = table[i];
+				}
+			}
+			free(table);
+			table = newTable;
+			tableCapacity = newCapacity;
+		}
+		Entry* entry = (Entry*)_allocate((int)sizeof(Entry) + length);
+		entry->hash = hash;
+		entry->size = length;
+		memcpy(entry->data, string, length);
+		entry->data[length] = '\0';
+		unsigned int mask = (unsigned int)tableCapacity - 1;
+		unsigned int i = hash & mask;
+		while (table[i] != NULL)
+		{
+			i = (i + 1) & mask;
+		}
+		table[i] = entry;
+		++tableCount;
+		return entry;
+	}
+
+}
@@ -0,0 +1,221 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include "harray.h"
+#include "hatomicfile.h"
+#include "hdir.h"
+#include "hexception.h"
+#include "hltypesUtil.h"
+#include "hpathcache.h"
+#include "hstring.h"
+#include "platform_internal.h"
+
+#define TEMP_FILE_ATTEMPTS 100
+
+namespace hltypes
+{
+	HL_ENUM_CLASS_DEFINE(AtomicFile::SyncMode,
+	(
+		HL_ENUM_DEFINE(AtomicFile::SyncMode, None);
+		HL_ENUM_DEFINE(AtomicFile::SyncMode, Data);
+		HL_ENUM_DEFINE(AtomicFile::SyncMode, Full);
+	));
+
+	AtomicFile::AtomicFile() : FileBase()
+	{
+	}
+
+	AtomicFile::AtomicFile(const String& filename) : FileBase()
+	{
+		this->open(filename);
+	}
+
+	AtomicFile::~AtomicFile()
+	{
+		this->discard();
+	}
+
+	AtomicFile::AtomicFile(const AtomicFile& other)
+	{
+		throw ObjectCannotCopyException("hltypes::AtomicFile");
+	}
+
+	AtomicFile& AtomicFile::operator=(AtomicFile& other)
+	{
+		throw ObjectCannotAssignException("hltypes::AtomicFile");
+		return (*this);
+	}
+
+	void AtomicFile::open(const String& filename)
+	{
+		this->discard();
+		String name = Dir::normalize(filename);
+		Dir::create(Dir::baseDir(name));
+		// the temporary file is created exclusively so an existing file with the same name is never truncated
+		for_iter (i, 0, TEMP_FILE_ATTEMPTS)
+		{
+			if (this->_fcreate(AtomicFile::_makeTempFilename(name)))
+			{
+				this->targetFilename = name;
+				return;
+			}
+		}
+		throw FileCouldNotOpenException(name);
+	}
+
+	void AtomicFile::close()
+	{
+		this->discard();
+	}
+
+	void AtomicFile::flush()
+	{
+		this->_fflush();
+	}
+
+	bool AtomicFile::commit(SyncMode syncMode)
+	{
+		if (!this->_prepareCommit(syncMode))
+		{
+			this->discard();
+			return false;
+		}
+		String dirName = Dir::baseDir(this->targetFilename);
+		if (!this->_publish())
+		{
+			return false;
+		}
+		if (syncMode != SyncMode::None)
+		{
+			_platformSyncDirectory(dirName);
+		}
+		return true;
+	}
+
+	void AtomicFile::discard()
+	{
+		if (this->_isOpen())
+		{
+			this->_fclose();
+		}
+		if (this->filename != "")
+		{
+			_platformRemoveFile(this->filename);
+			PathCache::invalidate(this->filename);
+			this->filename = "";
+		}
+		this->targetFilename = "";
+	}
+
+	bool AtomicFile::commit(const Array<AtomicFile*>& files, SyncMode syncMode)
+	{
+		bool result = true;
+		foreachc (AtomicFile*, it, files)
+		{
+			if (!(*it)->_prepareCommit(syncMode))
+			{
+				result = false;
+				break;
+			}
+		}
+		if (!result)
+		{
+			foreachc (AtomicFile*, it, files)
+			{
+				(*it)->discard();
+			}
+			return false;
+		}
+		Array<String> dirNames;
+		foreachc (AtomicFile*, it, files)
+		{
+			dirNames |= Dir::baseDir((*it)->targetFilename);
+			if (!(*it)->_publish())
+			{
+				result = false;
+			}
+		}
+		if (syncMode != SyncMode::None)
+		{
+			foreach (String, it, dirNames)
+			{
+				_platformSyncDirectory(*it);
+			}
+		}
+		return result;
+	}
+
+	bool AtomicFile::_prepareCommit(SyncMode syncMode)
+	{
+		this->_validate();
+		// any lost data means the target file must not be replaced
+		bool result = this->_fflush();
+		if (result && syncMode != SyncMode::None)
+		{
+			result = _platformSyncFile((_platformFile*)this->cfile, (syncMode == SyncMode::Data));
+		}
+		result = (result && !this->writeFailed);
+		if (!this->_fclose())
+		{
+			result = false;
+		}
+		return result;
+	}
+
+	bool AtomicFile::_publish()
+	{
+		// the temporary file was created with default permissions
+		if (_platformFileExists(this->targetFilename))
+		{
+			_platformCopyFilePermissions(this->targetFilename, this->filename);
+		}
+		bool result = _platformReplaceFile(this->filename, this->targetFilename);
+		if (!result)
+		{
+			_platformRemoveFile(this->filename);
+		}
+		PathCache::invalidate(this->filename);
+		PathCache::invalidate(this->targetFilename);
+		this->filename = "";
+		this->targetFilename = "";
+		return result;
+	}
+
+	int AtomicFile::_read(void* buffer, int count)
+	{
+		return this->_fread(buffer, count);
+	}
+
+	int AtomicFile::_write(const void* buffer, int count)
+	{
+		return this->_fwrite(buffer, count);
+	}
+
+	bool AtomicFile::_isOpen() const
+	{
+		return this->_fisOpen();
+	}
+
+	int64_t AtomicFile::_position() const
+	{
+		return this->_fposition();
+	}
+
+	bool AtomicFile::_seek(int64_t offset, SeekMode seekMode)
+	{
+		return this->_fseek(offset, seekMode);
+	}
+
+	String AtomicFile::_makeTempFilename(const String& filename)
+	{
+		// collisions are detected when the file is created, this only makes them unlikely
+		return Dir::joinPath(Dir::baseDir(filename), hsprintf(".%s.%08x%04x.tmp", Dir::baseName(filename).cStr(),
+			(unsigned int)htickCount(), (unsigned int)hrand(0x10000)), false);
+	}
+
+}
@@ -6,6 +6,8 @@
 /// This program is free software; you can redistribute it and/or modify it under
 /// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
 
+#include <string.h>
+
 #include "harray.h"
 #include "hdbase.h"
 #include "hlog.h"
@@ -13,120 +15,323 @@
 #include "hstring.h"
 #include "platform_internal.h"
 
+#define PATH_BUFFER_SIZE 1024
+
 namespace hltypes
 {
+	static inline bool _isSeparator(char c)
+	{
+		return (c == '/' || c == '\\');
+	}
+
+	static int _networkPrefixSize(const char* path, int size)
+	{
+#ifdef _WIN32
+		if (size >= 2 && path[0] == '\\' && path[1] == '\\')
+		{
+			return 2;
+		}
+#else
+		(void)path; // only needed on Windows
+		(void)size;
+#endif
+		return 0;
+	}
+
+	/// @brief Finds the base name in a path the same way splitPath() would.
+	/// @return True if there is a parent directory.
+	static bool _findBaseName(const char* path, int size, int& start, int& end)
+	{
+		int prefix = _networkPrefixSize(path, size);
+		int first = 0;
+#ifdef _WIN32
+		// systemize() removes leading separators on Win32 so they never form an empty root segment
+		first = prefix;
+		while (first < size && _isSeparator(path[first]))
+		{
+			++first;
+		}
+#endif
+		end = size;
+		while (end > first && _isSeparator(path[end - 1]))
+		{
+			--end;
+		}
+		start = end;
+		while (start > first && !_isSeparator(path[start - 1]))
+		{
+			--start;
+		}
+		if (start > first)
+		{
+			return true;
+		}
+		if (prefix > 0)
+		{
+			start = 0;
+		}
+		return false;
+	}
+
+	/// @brief Systemizes a path into a temporary buffer and creates a String from it.
+	static String _systemized(const char* path, int size)
+	{
+		char stackBuffer[PATH_BUFFER_SIZE];
+		char* buffer = (size < PATH_BUFFER_SIZE ? stackBuffer : new char[size + 1]);
+		memcpy(buffer, path, size);
+		buffer[size] = '\0';
+		size = DirBase::systemize(buffer, size);
+		String result(buffer, size);
+		if (buffer != stackBuffer)
+		{
+			delete[] buffer;
+		}
+		return result;
+	}
+
 	String DirBase::baseDir(const String& path)
 	{
-		Array<String> result = DirBase::splitPath(path);
-		if (result.size() < 2)
+		const char* data = path.cStr();
+		int start = 0;
+		int end = 0;
+		if (!_findBaseName(data, path.size(), start, end))
 		{
 			return ".";
 		}
-		result.removeLast();
-		return DirBase::joinPaths(result, false);
+		while (start > 0 && _isSeparator(data[start - 1]))
+		{
+			--start;
+		}
+		return _systemized(data, start);
 	}
 
 	String DirBase::baseName(const String& path)
 	{
-		Array<String> result = DirBase::splitPath(path);
-		return (result.size() > 0 ? result.removeLast() : String());
+#ifdef _WIN32
+		// separators following a network prefix are only removed by systemize()
+		if (_networkPrefixSize(path.cStr(), path.size()) > 0)
+		{
+			String systemized = DirBase::systemize(path);
+			int length = 0;
+			const char* name = DirBase::baseName(systemized.cStr(), systemized.size(), length);
+			return String(name, length);
+		}
+#endif
+		int length = 0;
+		const char* name = DirBase::baseName(path.cStr(), path.size(), length);
+		return String(name, length);
+	}
+
+	const char* DirBase::baseName(const char* path, int size, int& length)
+	{
+		if (size < 0)
+		{
+			size = (int)strlen(path);
+		}
+		int start = 0;
+		int end = 0;
+		_findBaseName(path, size, start, end);
+		length = end - start;
+		return &path[start];
 	}
 
 	String DirBase::systemize(const String& path)
 	{
-		String result = path;
-#ifdef _WIN32
-		bool networkDrive = path.startsWith("\\\\");
-		if (networkDrive)
+#ifdef _DEBUG // using _platformPrint() directory to avoid possible deadlock when saving to file during logging
+		String debugPath = path;
+		debugPath.replace('\\', '/');
+		if (debugPath.contains("//"))
 		{
-			result = result(2, -1);
+			hltypes::_platformPrint(logTag, "The path '" + path + "' contains multiple consecutive '/' (slash) characters. It will be systemized properly, but you may want to consider fixing this.", Log::LevelWarn);
 		}
 #endif
-		result.replace('\\', '/');
-		if (result.contains("//"))
+		return _systemized(path.cStr(), path.size());
+	}
+
+	int DirBase::systemize(char* path, int size)
+	{
+		if (size < 0)
 		{
-#ifdef _DEBUG // using _platformPrint() directory to avoid possible deadlock when saving to file during logging
-			hltypes::_platformPrint(logTag, "The path '" + result + "' contains multiple consecutive '/' (slash) characters. It will be systemized properly, but you may want to consider fixing this.", Log::LevelWarn);
-#endif
-			for (int i = 0; i < 1000 && result.contains("//"); ++i) // 1000 loops are there to prevent a possible infinite loop
-			{
-				result.replace("//", "/");
-			}
+			size = (int)strlen(path);
 		}
+		int read = _networkPrefixSize(path, size);
+		int write = read;
 #ifdef _WIN32
-		// there could still be a single leading slash
-		if (result.size() > 0 && result[0] == '/')
+		// there must not be any leading slashes
+		while (read < size && _isSeparator(path[read]))
 		{
-			result = result(1, -1);
+			++read;
 		}
-		if (networkDrive)
+#endif
+		char c = '\0';
+		for (; read < size; ++read)
 		{
-			result = "\\\\" + result;
+			c = (path[read] != '\\' ? path[read] : '/');
+			if (c != '/' || write == 0 || path[write - 1] != '/')
+			{
+				path[write] = c;
+				++write;
+			}
 		}
-#endif
-		return result;
+		path[write] = '\0';
+		return write;
 	}
 
 	String DirBase::normalize(const String& path)
 	{
-		Array<String> directories = DirBase::splitPath(path);
-		Array<String> result;
-		while (directories.size() > 0)
+		int size = path.size();
+		char stackBuffer[PATH_BUFFER_SIZE];
+		char* buffer = (size < PATH_BUFFER_SIZE ? stackBuffer : new char[size + 1]);
+		memcpy(buffer, path.cStr(), size);
+		buffer[size] = '\0';
+		size = DirBase::normalize(buffer, size);
+		String result(buffer, size);
+		if (buffer != stackBuffer)
+		{
+			delete[] buffer;
+		}
+		return result;
+	}
+
+	int DirBase::normalize(char* path, int size)
+	{
+		if (size < 0)
+		{
+			size = (int)strlen(path);
+		}
+		int read = _networkPrefixSize(path, size);
+		int write = read;
+		// the network prefix is part of the first segment, just like after systemize()
+		bool prefix = (read > 0);
+		int segments = 0;
+		bool found = false;
+#ifdef _WIN32
+		while (read < size && _isSeparator(path[read]))
 		{
-			if (directories.first() == ".")
+			++read;
+		}
+#else
+		if (size > 0 && _isSeparator(path[0]))
+		{
+			// absolute paths start with an empty segment
+			segments = 1;
+			found = true;
+			while (read < size && _isSeparator(path[read]))
 			{
-				directories.removeFirst();
+				++read;
 			}
-			else if (directories.first() == "..")
+		}
+#endif
+		int start = 0;
+		int length = 0;
+		int last = 0;
+		while (read < size)
+		{
+			start = read;
+			while (read < size && !_isSeparator(path[read]))
 			{
-				if (result.size() == 0)
-				{
-					result += directories.removeFirst();
-				}
-				else if (result.last() == "..")
+				++read;
+			}
+			length = read - start;
+			while (read < size && _isSeparator(path[read]))
+			{
+				++read;
+			}
+			found = true;
+			if (prefix)
+			{
+				memmove(&path[write], &path[start], length);
+				write += length;
+				segments = 1;
+				prefix = false;
+				continue;
+			}
+			if (length == 1 && path[start] == '.')
+			{
+				continue;
+			}
+			if (length == 2 && path[start] == '.' && path[start + 1] == '.' && segments > 0)
+			{
+				last = write;
+				while (last > 0 && path[last - 1] != '/')
 				{
-					result += directories.removeFirst();
+					--last;
 				}
-				else
+				if (write - last != 2 || path[last] != '.' || path[last + 1] != '.')
 				{
-					result.removeLast();
-					directories.removeFirst();
+					--segments;
+					write = (segments > 0 ? last - 1 : 0);
+					continue;
 				}
 			}
-			else
+			// the output is never ahead of the input so this can be done in place
+			if (segments > 0)
 			{
-				result += directories.removeFirst();
+				path[write] = '/';
+				++write;
 			}
+			memmove(&path[write], &path[start], length);
+			write += length;
+			++segments;
 		}
-		if (result.size() == 0)
+		if (prefix)
 		{
-			return ".";
+			segments = 1;
+		}
+		else if (segments == 0 && found)
+		{
+			path[0] = '.';
+			write = 1;
 		}
-		return DirBase::joinPaths(result);
+		path[write] = '\0';
+		return write;
 	}
-		
+
 	String DirBase::joinPath(const String& path1, const String& path2, bool systemizeResult)
 	{
-		String result;
-		bool slash1 = path1.endsWith("/");
-		bool slash2 = path2.startsWith("/");
-		if (!slash1 && !slash2)
+		int size = path1.size() + path2.size() + 1;
+		char stackBuffer[PATH_BUFFER_SIZE];
+		char* buffer = (size < PATH_BUFFER_SIZE ? stackBuffer : new char[size + 1]);
+		size = DirBase::joinPath(buffer, size + 1, path1.cStr(), path2.cStr());
+		if (systemizeResult)
+		{
+			size = DirBase::systemize(buffer, size);
+		}
+		String result(buffer, size);
+		if (buffer != stackBuffer)
+		{
+			delete[] buffer;
+		}
+		return result;
+	}
+
+	int DirBase::joinPath(char* output, int capacity, const char* path1, const char* path2)
+	{
+		int size1 = (int)strlen(path1);
+		int size2 = (int)strlen(path2);
+		bool slash1 = (size1 > 0 && path1[size1 - 1] == '/');
+		bool slash2 = (path2[0] == '/');
+		if (slash1 && slash2)
 		{
-			result = path1 + "/" + path2;
+			--size1;
 		}
-		else if (slash1 ^ slash2)
+		int separator = (!slash1 && !slash2 ? 1 : 0);
+		int size = size1 + separator + size2;
+		if (size >= capacity)
 		{
-			result = path1 + path2;
+			return -1;
 		}
-		else // (slash1 && slash2)
+		if (output != path1)
 		{
-			result = path1.subString(0, path1.size() - 1) + path2;
+			memmove(output, path1, size1);
 		}
-		if (systemizeResult)
+		if (separator > 0)
 		{
-			result = systemize(result);
+			output[size1] = '/';
 		}
-		return result;
+		memmove(&output[size1 + separator], path2, size2);
+		output[size] = '\0';
+		return size;
 	}
 
 	String DirBase::joinPaths(Array<String> paths, bool systemizeResult)
@@ -0,0 +1,427 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hdeflatestream.h"
+#include "hexception.h"
+#include "hlog.h"
+#include "hltypesUtil.h"
+#include "hsbase.h"
+#include "hstring.h"
+#include "miniz_internal.h"
+
+#define MIN_BUFFER_SIZE 1024
+#define Z_STREAM ((miniz::mz_stream*)this->zStream)
+
+namespace hltypes
+{
+	HL_ENUM_CLASS_DEFINE(DeflateStream::Mode,
+	(
+		HL_ENUM_DEFINE(DeflateStream::Mode, Compress);
+		HL_ENUM_DEFINE(DeflateStream::Mode, Decompress);
+	));
+
+	DeflateStream::DeflateStream(StreamBase* stream, Mode mode, int level, int bufferSize) : StreamBase(), stream(stream), mode(mode),
+		autoFlush(false), allowTruncated(false), finished(false), zStream(NULL), inputBuffer(NULL), outputBuffer(NULL), windowPosition(0LL),
+		windowSize(0), streamPosition(0LL), startPosition(0LL)
+	{
+		this->level = hclamp(level, 0, HL_DEFLATE_BEST_LEVEL);
+		this->bufferSize = hmax(bufferSize, MIN_BUFFER_SIZE);
+		this->_initialize();
+	}
+
+	DeflateStream::DeflateStream(StreamBase* stream, Mode mode, int level, int bufferSize, bool initialize) : StreamBase(), stream(stream),
+		mode(mode), autoFlush(false), allowTruncated(false), finished(false), zStream(NULL), inputBuffer(NULL), outputBuffer(NULL),
+		windowPosition(0LL), windowSize(0), streamPosition(0LL), startPosition(0LL)
+	{
+		this->level = hclamp(level, 0, HL_DEFLATE_BEST_LEVEL);
+		this->bufferSize = hmax(bufferSize, MIN_BUFFER_SIZE);
+		if (initialize)
+		{
+			this->_initialize();
+		}
+	}
+
+	DeflateStream::~DeflateStream()
+	{
+		try
+		{
+			this->finish();
+		}
+		catch (hexception& e)
+		{
+			Log::error(logTag, e.getMessage());
+		}
+		this->_release();
+		if (this->inputBuffer != NULL)
+		{
+			free(this->inputBuffer);
+		}
+		if (this->outputBuffer != NULL)
+		{
+			free(this->outputBuffer);
+		}
+	}
+
+	DeflateStream::DeflateStream(const DeflateStream& other)
+	{
+		throw ObjectCannotCopyException("hltypes::DeflateStream");
+	}
+
+	DeflateStream& DeflateStream::operator=(DeflateStream& other)
+	{
+		throw ObjectCannotAssignException("hltypes::DeflateStream");
+		return (*this);
+	}
+
+	void DeflateStream::flush(bool full)
+	{
+#ifdef _ZIPRESOURCE
+		if (this->mode == Mode::Compress && !this->finished)
+		{
+			this->_compress(NULL, 0, full ? miniz::MZ_FULL_FLUSH : miniz::MZ_SYNC_FLUSH);
+		}
+#else
+		(void)full; // only needed with _ZIPRESOURCE
+#endif
+	}
+
+	void DeflateStream::finish()
+	{
+#ifdef _ZIPRESOURCE
+		if (this->mode == Mode::Compress && !this->finished && this->zStream != NULL)
+		{
+			this->_compress(NULL, 0, miniz::MZ_FINISH);
+			this->_writeTrailer();
+			this->finished = true;
+		}
+#endif
+	}
+
+	void DeflateStream::_initialize()
+	{
+#ifdef _ZIPRESOURCE
+		if (this->stream == NULL)
+		{
+			throw FileNotOpenException(this->_descriptor());
+		}
+		if (this->inputBuffer == NULL)
+		{
+			this->inputBuffer = (unsigned char*)malloc(this->bufferSize);
+		}
+		if (this->outputBuffer == NULL)
+		{
+			this->outputBuffer = (unsigned char*)malloc(this->bufferSize);
+		}
+		if (this->inputBuffer == NULL || this->outputBuffer == NULL)
+		{
+			throw Exception("Could not allocate buffers for " + this->_descriptor() + "!");
+		}
+		this->startPosition = this->stream->position();
+		this->zStream = malloc(sizeof(miniz::mz_stream));
+		memset(this->zStream, 0, sizeof(miniz::mz_stream));
+		int result = 0;
+		if (this->mode == Mode::Compress)
+		{
+			result = miniz::mz_deflateInit2(Z_STREAM, this->level, MZ_DEFLATED, this->_windowBits(), 9, miniz::MZ_DEFAULT_STRATEGY);
+		}
+		else
+		{
+			result = miniz::mz_inflateInit2(Z_STREAM, this->_windowBits());
+		}
+		if (result != miniz::MZ_OK)
+		{
+			free(this->zStream);
+			this->zStream = NULL;
+			throw Exception(hsprintf("Could not initialize %s, error: %d", this->_descriptor().cStr(), result));
+		}
+		if (this->mode == Mode::Compress)
+		{
+			this->_writeHeader();
+		}
+		else
+		{
+			this->_readHeader();
+			this->_decompress();
+		}
+#else
+		throw Exception(this->_descriptor() + " is not supported, hltypes was compiled without _ZIPRESOURCE!");
+#endif
+	}
+
+	void DeflateStream::_release()
+	{
+#ifdef _ZIPRESOURCE
+		if (this->zStream != NULL)
+		{
+			if (this->mode == Mode::Compress)
+			{
+				miniz::mz_deflateEnd(Z_STREAM);
+			}
+			else
+			{
+				miniz::mz_inflateEnd(Z_STREAM);
+			}
+			free(this->zStream);
+			this->zStream = NULL;
+		}
+#endif
+	}
+
+	bool DeflateStream::_restart()
+	{
+		if (!this->stream->seek(this->startPosition, SeekMode::Start))
+		{
+			return false;
+		}
+		this->_release();
+		this->finished = false;
+		this->windowPosition = 0LL;
+		this->windowSize = 0;
+		this->streamPosition = 0LL;
+		this->dataSize = 0LL;
+		this->_initialize();
+		return true;
+	}
+
+	void DeflateStream::_decompress()
+	{
+#ifdef _ZIPRESOURCE
+		if (this->finished)
+		{
+			return;
+		}
+		// the end of the old data stays in the window so short backward seeks (e.g. from read(delimiter)) are cheap
+		int keep = hmin(this->windowSize, this->bufferSize / 4);
+		if (keep < this->windowSize)
+		{
+			memmove(this->outputBuffer, &this->outputBuffer[this->windowSize - keep], keep);
+			this->windowPosition += this->windowSize - keep;
+			this->windowSize = keep;
+		}
+		miniz::mz_stream* zStream = Z_STREAM;
+		int previousSize = this->windowSize;
+		int produced = 0;
+		int result = 0;
+		bool exhausted = false;
+		while (this->windowSize < this->bufferSize)
+		{
+			if (zStream->avail_in == 0 && !exhausted)
+			{
+				zStream->next_in = this->inputBuffer;
+				zStream->avail_in = this->stream->readRaw(this->inputBuffer, this->bufferSize);
+				exhausted = (zStream->avail_in == 0);
+			}
+			zStream->next_out = &this->outputBuffer[this->windowSize];
+			zStream->avail_out = this->bufferSize - this->windowSize;
+			result = miniz::mz_inflate(zStream, miniz::MZ_NO_FLUSH);
+			produced = this->bufferSize - this->windowSize - zStream->avail_out;
+			if (produced > 0)
+			{
+				this->_updateChecksum(&this->outputBuffer[this->windowSize], produced);
+				this->windowSize += produced;
+			}
+			if (result == miniz::MZ_STREAM_END)
+			{
+				this->finished = true;
+				int unused = _minizInflateUnusedBytes(zStream);
+				if (unused > 0)
+				{
+					this->stream->seek(-unused);
+				}
+				zStream->avail_in = 0;
+				this->_readTrailer();
+				break;
+			}
+			if (result != miniz::MZ_OK && result != miniz::MZ_BUF_ERROR)
+			{
+				throw Exception(hsprintf("Could not decompress data in %s, error: %d", this->_descriptor().cStr(), result));
+			}
+			if (exhausted && produced == 0)
+			{
+				// what was decompressed so far can still be read, the error only comes up when nothing is left
+				if (this->windowSize == previousSize)
+				{
+					if (!this->allowTruncated)
+					{
+						throw Exception("Compressed data in " + this->_descriptor() + " ends unexpectedly!");
+					}
+					// e.g. a log that is still being written simply ends here
+					this->finished = true;
+				}
+				break;
+			}
+		}
+		this->dataSize = this->windowPosition + this->windowSize;
+#endif
+	}
+
+	void DeflateStream::_compress(const void* data, int size, int flushMode)
+	{
+#ifdef _ZIPRESOURCE
+		miniz::mz_stream* zStream = Z_STREAM;
+		zStream->next_in = (const unsigned char*)data;
+		zStream->avail_in = size;
+		int result = 0;
+		int written = 0;
+		do
+		{
+			zStream->next_out = this->outputBuffer;
+			zStream->avail_out = this->bufferSize;
+			result = miniz::mz_deflate(zStream, flushMode);
+			if (result == miniz::MZ_BUF_ERROR)
+			{
+				break;
+			}
+			if (result != miniz::MZ_OK && result != miniz::MZ_STREAM_END)
+			{
+				throw Exception(hsprintf("Could not compress data in %s, error: %d", this->_descriptor().cStr(), result));
+			}
+			written = this->bufferSize - zStream->avail_out;
+			if (written > 0 && this->stream->writeRaw(this->outputBuffer, written) != written)
+			{
+				throw Exception("Could not write compressed data of " + this->_descriptor() + "!");
+			}
+		} while (result != miniz::MZ_STREAM_END && (zStream->avail_in > 0 || zStream->avail_out == 0 || flushMode == miniz::MZ_FINISH));
+#else
+		(void)data; // only needed with _ZIPRESOURCE
+		(void)size;
+		(void)flushMode;
+#endif
+	}
+
+	int DeflateStream::_windowBits() const
+	{
+		return 15;
+	}
+
+	void DeflateStream::_writeHeader()
+	{
+	}
+
+	void DeflateStream::_writeTrailer()
+	{
+	}
+
+	void DeflateStream::_readHeader()
+	{
+	}
+
+	void DeflateStream::_readTrailer()
+	{
+	}
+
+	void DeflateStream::_updateChecksum(const unsigned char*, int)
+	{
+	}
+
+	void DeflateStream::_updateDataSize()
+	{
+	}
+
+	int DeflateStream::_read(void* buffer, int count)
+	{
+		if (this->mode == Mode::Compress)
+		{
+			throw Exception("Cannot read from " + this->_descriptor() + " in compression mode!");
+		}
+		unsigned char* destination = (unsigned char*)buffer;
+		int result = 0;
+		int size = 0;
+		while (result < count)
+		{
+			if (this->streamPosition >= this->windowPosition + this->windowSize)
+			{
+				if (this->finished)
+				{
+					break;
+				}
+				this->_decompress();
+				continue;
+			}
+			size = (int)hmin((int64_t)(count - result), this->windowPosition + this->windowSize - this->streamPosition);
+			memcpy(&destination[result], &this->outputBuffer[this->streamPosition - this->windowPosition], size);
+			result += size;
+			this->streamPosition += size;
+		}
+		// decompressing ahead keeps eof() exact
+		if (this->streamPosition >= this->windowPosition + this->windowSize)
+		{
+			this->_decompress();
+		}
+		return result;
+	}
+
+	int DeflateStream::_write(const void* buffer, int count)
+	{
+		if (this->mode == Mode::Decompress || this->finished)
+		{
+			throw FileNotWriteableException(this->_descriptor());
+		}
+#ifdef _ZIPRESOURCE
+		this->_compress(buffer, count, this->autoFlush ? miniz::MZ_SYNC_FLUSH : miniz::MZ_NO_FLUSH);
+#endif
+		this->_updateChecksum((const unsigned char*)buffer, count);
+		this->streamPosition += count;
+		this->dataSize = this->streamPosition;
+		return count;
+	}
+
+	bool DeflateStream::_isOpen() const
+	{
+		return (this->stream != NULL && this->zStream != NULL);
+	}
+
+	int64_t DeflateStream::_position() const
+	{
+		return this->streamPosition;
+	}
+
+	bool DeflateStream::_seek(int64_t offset, SeekMode seekMode)
+	{
+		if (seekMode == SeekMode::End && this->mode == Mode::Decompress)
+		{
+			while (!this->finished)
+			{
+				this->_decompress();
+			}
+		}
+		int64_t target = offset;
+		if (seekMode == SeekMode::Current)
+		{
+			target = this->streamPosition + offset;
+		}
+		else if (seekMode == SeekMode::End)
+		{
+			target = this->dataSize + offset;
+		}
+		if (this->mode == Mode::Compress)
+		{
+			return (target == this->streamPosition);
+		}
+		target = hmax(target, (int64_t)0);
+		if (target < this->windowPosition && !this->_restart())
+		{
+			return false;
+		}
+		while (target > this->windowPosition + this->windowSize && !this->finished)
+		{
+			this->streamPosition = this->windowPosition + this->windowSize;
+			this->_decompress();
+		}
+		this->streamPosition = hmin(target, this->windowPosition + this->windowSize);
+		if (this->streamPosition >= this->windowPosition + this->windowSize)
+		{
+			this->_decompress();
+		}
+		return true;
+	}
+
+}
@@ -7,19 +7,302 @@
 /// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
 
 #include "harray.h"
+#include "hdeque.h"
 #include "hdir.h"
 #include "hfile.h"
 #include "hltypesUtil.h"
+#include "hmutex.h"
+#include "hpathcache.h"
 #include "hplatform.h"
 #include "hrdir.h"
 #include "hresource.h"
 #include "hstring.h"
+#include "hthread.h"
 #include "platform_internal.h"
 
+#define WALK_IDLE_SLEEP_TIME 0.1f
+#define COPY_THREAD_COUNT 4
+#define COPY_FILES_PER_THREAD 16
+
 namespace hltypes
 {
+	/// @brief Shared state of all threads of a directory copy.
+	struct DirCopyState
+	{
+		const Array<String>* oldFilenames;
+		const Array<String>* newFilenames;
+		bool preserveTimes;
+		int next;
+		bool failed;
+		Mutex mutex;
+
+		DirCopyState() : oldFilenames(NULL), newFilenames(NULL), preserveTimes(false), next(0), failed(false) { }
+
+	};
+
+	/// @brief Copies files of a directory copy on its own thread.
+	class DirCopyThread : public Thread
+	{
+	public:
+		DirCopyState* state;
+
+		DirCopyThread(DirCopyState* state) : Thread(&DirCopyThread::_process, "hltypes dir copy"), state(state) { }
+
+		static void _copyFiles(DirCopyState* state)
+		{
+			Mutex::ScopeLock lock;
+			int index = 0;
+			bool result = true;
+			while (true)
+			{
+				lock.acquire(&state->mutex);
+				if (!result)
+				{
+					state->failed = true;
+				}
+				index = state->next;
+				if (index >= state->oldFilenames->size())
+				{
+					break;
+				}
+				++state->next;
+				lock.release();
+				result = File::copy((*state->oldFilenames)[index], (*state->newFilenames)[index], false, state->preserveTimes);
+			}
+		}
+
+	protected:
+		static void _process(Thread* thread)
+		{
+			DirCopyThread::_copyFiles(((DirCopyThread*)thread)->state);
+		}
+
+	};
+
+	/// @brief A directory that still has to be listed during a walk.
+	struct DirWalkItem
+	{
+		String path;
+		int depth;
+
+		DirWalkItem() : depth(0) { }
+		DirWalkItem(const String& path, int depth) : path(path), depth(depth) { }
+
+	};
+
+	/// @brief Shared state of all threads of a walk.
+	struct DirWalkState
+	{
+		const DirWalkOptions* options;
+		bool (*callback)(const String&, const DirEntry&, void*);
+		void* userData;
+		Deque<DirWalkItem> queue;
+		int active;
+		volatile bool stopped;
+		Mutex mutex;
+
+		DirWalkState() : options(NULL), callback(NULL), userData(NULL), active(0), stopped(false) { }
+
+	};
+
+	/// @brief Worker thread of a walk.
+	class DirWalkThread : public Thread
+	{
+	public:
+		DirWalkState* state;
+
+		DirWalkThread(void (*function)(Thread*), DirWalkState* state, const String& name) : Thread(function, name), state(state) { }
+
+	};
+
+	/// @brief Data for collecting the paths of a walk.
+	struct DirWalkCollector
+	{
+		Array<String> paths;
+		Mutex mutex;
+
+	};
+
+	static bool _matchesGlob(const char* name, const char* pattern)
+	{
+		// iterative matching that only backtracks to the last "*"
+		const char* starPattern = NULL;
+		const char* starName = NULL;
+		while (*name != '\0')
+		{
+			if (*pattern == '*')
+			{
+				starPattern = ++pattern;
+				starName = name;
+			}
+			else if (*pattern == '?' || *pattern == *name)
+			{
+				++pattern;
+				++name;
+			}
+			else if (starPattern != NULL)
+			{
+				pattern = starPattern;
+				name = ++starName;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		while (*pattern == '*')
+		{
+			++pattern;
+		}
+		return (*pattern == '\0');
+	}
+
+	static bool _matchesWalkFilters(const String& name, const DirWalkOptions& options)
+	{
+		if (options.patterns.size() > 0)
+		{
+			bool found = false;
+			foreachc (String, it, options.patterns)
+			{
+				if (_matchesGlob(name.cStr(), (*it).cStr()))
+				{
+					found = true;
+					break;
+				}
+			}
+			if (!found)
+			{
+				return false;
+			}
+		}
+		if (options.extensions.size() > 0)
+		{
+			String lowered = name.lowered();
+			foreachc (String, it, options.extensions)
+			{
+				if (lowered.endsWith(((*it).startsWith(".") ? (*it) : "." + (*it)).lowered()))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+		return true;
+	}
+
+	static void _walkProcess(DirWalkState* state)
+	{
+		const DirWalkOptions& options = *state->options;
+		Mutex::ScopeLock lock;
+		DirWalkItem item;
+		Array<DirEntry> entries;
+		Array<DirWalkItem> subdirectories;
+		String path;
+		bool enter = false;
+		while (!state->stopped)
+		{
+			lock.acquire(&state->mutex);
+			if (state->queue.size() == 0)
+			{
+				bool done = (state->active == 0);
+				lock.release();
+				if (done)
+				{
+					break;
+				}
+				// other threads are still listing and may add more directories
+				Thread::sleep(WALK_IDLE_SLEEP_TIME);
+				continue;
+			}
+			item = state->queue.removeFirst();
+			++state->active;
+			lock.release();
+			entries = Dir::scan(item.path, options.withInfo);
+			subdirectories.clear();
+			foreach (DirEntry, it, entries)
+			{
+				if ((*it).symbolicLink && options.linkPolicy == DirWalkOptions::LinkPolicy::Skip)
+				{
+					continue;
+				}
+				path = Dir::joinPath(item.path, (*it).name, false);
+				if ((*it).isDirectory())
+				{
+					if (options.directories && !(*state->callback)(path, (*it), state->userData))
+					{
+						state->stopped = true;
+						break;
+					}
+					enter = (!(*it).symbolicLink || options.linkPolicy == DirWalkOptions::LinkPolicy::Follow);
+					if (enter && (options.maxDepth < 0 || item.depth < options.maxDepth))
+					{
+						subdirectories += DirWalkItem(path, item.depth + 1);
+					}
+				}
+				else if ((*it).isFile() && options.files && _matchesWalkFilters((*it).name, options))
+				{
+					if (!(*state->callback)(path, (*it), state->userData))
+					{
+						state->stopped = true;
+						break;
+					}
+				}
+			}
+			lock.acquire(&state->mutex);
+			foreach (DirWalkItem, it, subdirectories)
+			{
+				state->queue += (*it);
+			}
+			--state->active;
+			lock.release();
+		}
+	}
+
+	static void _walkThread(Thread* thread)
+	{
+		_walkProcess(((DirWalkThread*)thread)->state);
+	}
+
+	static bool _walkCollect(const String& path, const DirEntry&, void* userData)
+	{
+		DirWalkCollector* collector = (DirWalkCollector*)userData;
+		Mutex::ScopeLock lock(&collector->mutex);
+		collector->paths += path;
+		return true;
+	}
+
 	bool Dir::win32FullDirectoryPermissions = true;
 
+	HL_ENUM_CLASS_DEFINE(DirEntry::Type,
+	(
+		HL_ENUM_DEFINE(DirEntry::Type, File);
+		HL_ENUM_DEFINE(DirEntry::Type, Directory);
+		HL_ENUM_DEFINE(DirEntry::Type, Other);
+	));
+
+	DirEntry::DirEntry() : type(Type::Other), size(-1LL), modificationTime(0LL), symbolicLink(false)
+	{
+	}
+
+	DirEntry::~DirEntry()
+	{
+	}
+
+	HL_ENUM_CLASS_DEFINE(DirWalkOptions::LinkPolicy,
+	(
+		HL_ENUM_DEFINE(DirWalkOptions::LinkPolicy, Skip);
+		HL_ENUM_DEFINE(DirWalkOptions::LinkPolicy, Report);
+		HL_ENUM_DEFINE(DirWalkOptions::LinkPolicy, Follow);
+	));
+
+	DirWalkOptions::DirWalkOptions() : maxDepth(-1), files(true), directories(false), linkPolicy(LinkPolicy::Report), withInfo(false), threadCount(1)
+	{
+	}
+
+	DirWalkOptions::~DirWalkOptions()
+	{
+	}
+
 	bool Dir::isWin32FullDirectoryPermissions()
 	{
 		return win32FullDirectoryPermissions;
@@ -42,10 +325,12 @@ namespace hltypes
 		{
 			String path = folders.removeFirst();
 			_platformCreateDirectory(path);
+			PathCache::invalidate(path);
 			foreach (String, it, folders)
 			{
 				path = Dir::joinPath(path, (*it), false);
 				_platformCreateDirectory(path);
+				PathCache::invalidate(path);
 			}
 		}
 		return Dir::exists(dirName);
@@ -63,24 +348,28 @@ namespace hltypes
 		{
 			return false;
 		}
-		Array<String> directories = Dir::directories(name);
-		foreach (String, it, directories)
-		{
-			Dir::remove(Dir::joinPath(name, (*it), false));
-		}
-		Array<String> files = Dir::files(name);
-		foreach (String, it, files)
+		Array<DirEntry> entries = Dir::_scan(name, false);
+		foreach (DirEntry, it, entries)
 		{
-			File::remove(Dir::joinPath(name, (*it), false));
+			if ((*it).isDirectory() && !(*it).symbolicLink)
+			{
+				Dir::remove(Dir::joinPath(name, (*it).name, false));
+			}
+			// only the link itself is removed, never what it points to (Win32 removes linked directories like directories)
+			else if (!File::remove(Dir::joinPath(name, (*it).name, false)) && (*it).isDirectory())
+			{
+				_platformRemoveDirectory(Dir::joinPath(name, (*it).name, false));
+			}
 		}
 		_platformRemoveDirectory(name);
+		PathCache::invalidate(name);
 		return Dir::exists(name);
 	}
 	
 	bool Dir::exists(const String& dirName, bool caseSensitive)
 	{
 		String name = Dir::normalize(dirName);
-		bool result = _platformDirectoryExists(dirName);
+		bool result = PathCache::_directoryExists(name);
 		if (!result && !caseSensitive)
 		{
 			String baseDir = Dir::baseDir(name);
@@ -106,17 +395,21 @@ namespace hltypes
 		{
 			return false;
 		}
-		Array<String> directories = Dir::directories(name);
-		foreach (String, it, directories)
+		Array<DirEntry> entries = Dir::_scan(name, false);
+		foreach (DirEntry, it, entries)
 		{
-			Dir::remove(Dir::joinPath(name, (*it), false));
-		}
-		Array<String> files = Dir::files(name);
-		foreach (String, it, files)
-		{
-			File::remove(Dir::joinPath(name, (*it), false));
+			if ((*it).isDirectory() && !(*it).symbolicLink)
+			{
+				Dir::remove(Dir::joinPath(name, (*it).name, false));
+			}
+			// only the link itself is removed, never what it points to (Win32 removes linked directories like directories)
+			else if (!File::remove(Dir::joinPath(name, (*it).name, false)) && (*it).isDirectory())
+			{
+				_platformRemoveDirectory(Dir::joinPath(name, (*it).name, false));
+			}
 		}
-		return (directories.size() > 0 || files.size() > 0);
+		PathCache::invalidate(name);
+		return (entries.size() > 0);
 	}
 	
 	bool Dir::rename(const String& oldDirName, const String& newDirName)
@@ -128,7 +421,10 @@ namespace hltypes
 			return false;
 		}
 		Dir::create(Dir::baseDir(newName));
-		return _platformRenameDirectory(oldName, newName);
+		bool result = _platformRenameDirectory(oldName, newName);
+		PathCache::invalidate(oldName);
+		PathCache::invalidate(newName);
+		return result;
 	}
 	
 	bool Dir::move(const String& dirName, const String& path)
@@ -138,7 +434,7 @@ namespace hltypes
 		return Dir::rename(name, Dir::joinPath(path_name, Dir::baseName(name), false));
 	}
 	
-	bool Dir::copy(const String& oldDirName, const String& newDirName)
+	bool Dir::copy(const String& oldDirName, const String& newDirName, bool preserveTimes)
 	{
 		String oldName = Dir::normalize(oldDirName);
 		String newName = Dir::normalize(newDirName);
@@ -147,41 +443,136 @@ namespace hltypes
 			return false;
 		}
 		Dir::create(newName);
-		Array<String> directories = Dir::directories(oldName);
-		foreach (String, it, directories)
+		// the tree is walked once, creating directories along the way and collecting files for the copy threads
+		Array<String> oldDirectories(oldName);
+		Array<String> newDirectories(newName);
+		Array<String> oldFilenames;
+		Array<String> newFilenames;
+		Array<DirEntry> entries;
+		String oldPath;
+		String newPath;
+		for_iter (i, 0, oldDirectories.size())
 		{
-			Dir::copy(Dir::joinPath(oldName, (*it), false), Dir::joinPath(newName, (*it), false));
+			entries = Dir::_scan(oldDirectories[i], false);
+			foreach (DirEntry, it, entries)
+			{
+				oldPath = Dir::joinPath(oldDirectories[i], (*it).name, false);
+				newPath = Dir::joinPath(newDirectories[i], (*it).name, false);
+				if ((*it).isDirectory())
+				{
+					_platformCreateDirectory(newPath);
+					oldDirectories += oldPath;
+					newDirectories += newPath;
+				}
+				else if ((*it).isFile())
+				{
+					oldFilenames += oldPath;
+					newFilenames += newPath;
+				}
+			}
 		}
-		Array<String> files = Dir::files(oldName);
-		foreach (String, it, files)
+		PathCache::invalidate(newName);
+		if (oldFilenames.size() == 0)
 		{
-			File::copy(Dir::joinPath(oldName, (*it), false), Dir::joinPath(newName, (*it), false));
+			return true;
 		}
-		return true;
+		DirCopyState state;
+		state.oldFilenames = &oldFilenames;
+		state.newFilenames = &newFilenames;
+		state.preserveTimes = preserveTimes;
+		// the calling thread does its share of the work as well, so threads that are joined before they even started don't leave any work undone
+		int threadCount = hclamp((oldFilenames.size() + COPY_FILES_PER_THREAD - 1) / COPY_FILES_PER_THREAD, 1, COPY_THREAD_COUNT);
+		Array<DirCopyThread*> threads;
+		for_iter (i, 1, threadCount)
+		{
+			threads += new DirCopyThread(&state);
+			threads.last()->start();
+		}
+		DirCopyThread::_copyFiles(&state);
+		foreach (DirCopyThread*, it, threads)
+		{
+			(*it)->join();
+			delete (*it);
+		}
+		return !state.failed;
 	}
 	
-	Array<String> Dir::entries(const String& dirName, bool prependDir)
+	Array<DirEntry> Dir::scan(const String& dirName, bool withInfo)
 	{
 		String name = Dir::normalize(dirName);
-		Array<String> result;
-		if (Dir::exists(name))
+		if (!withInfo && PathCache::isEnabled())
+		{
+			return PathCache::_scan(name);
+		}
+		return Dir::_scan(name, withInfo);
+	}
+
+	Array<DirEntry> Dir::_scan(const String& name, bool withInfo)
+	{
+		Array<DirEntry> result;
+		_platformDir* dir = _platformOpenDirectory(name);
+		if (dir != NULL)
 		{
-			_platformDir* dir = _platformOpenDirectory(name);
 			_platformDirEntry* entry = NULL;
+			DirEntry dirEntry;
 			while ((entry = _platformReadDirectory(dir)))
 			{
-				result += _platformGetDirEntryName(entry);
-			}
-			if (!result.has("."))
-			{
-				result += ".";
-			}
-			if (!result.has(".."))
-			{
-				result += "..";
+				_platformGetDirEntryInfo(dir, entry, withInfo, dirEntry);
+				if (dirEntry.name != "." && dirEntry.name != "..")
+				{
+					result += dirEntry;
+				}
 			}
 			_platformCloseDirectory(dir);
 		}
+		return result;
+	}
+
+	bool Dir::walk(const String& dirName, const DirWalkOptions& options, bool (*callback)(const String&, const DirEntry&, void*), void* userData)
+	{
+		String name = Dir::normalize(dirName);
+		if (callback == NULL || !Dir::exists(name))
+		{
+			return true;
+		}
+		DirWalkState state;
+		state.options = &options;
+		state.callback = callback;
+		state.userData = userData;
+		state.queue += DirWalkItem(name, 0);
+		// the calling thread does its share of the work as well
+		Array<Thread*> threads;
+		for_iter (i, 1, options.threadCount)
+		{
+			threads += new DirWalkThread(&_walkThread, &state, hsprintf("hltypes dir walk %d", i));
+			threads.last()->start();
+		}
+		_walkProcess(&state);
+		foreach (Thread*, it, threads)
+		{
+			(*it)->join();
+			delete (*it);
+		}
+		return !state.stopped;
+	}
+
+	Array<String> Dir::walk(const String& dirName, const DirWalkOptions& options)
+	{
+		DirWalkCollector collector;
+		Dir::walk(dirName, options, &_walkCollect, &collector);
+		return collector.paths;
+	}
+
+	Array<String> Dir::entries(const String& dirName, bool prependDir)
+	{
+		String name = Dir::normalize(dirName);
+		Array<String> result;
+		if (Dir::exists(name))
+		{
+			result = Dir::contents(name);
+			result += ".";
+			result += "..";
+		}
 		if (prependDir)
 		{
 			Dir::_prependDirectory(name, result);
@@ -193,21 +584,19 @@ namespace hltypes
 	{
 		String name = Dir::normalize(dirName);
 		Array<String> result;
-		if (Dir::exists(name))
+		_platformDir* dir = _platformOpenDirectory(name);
+		if (dir != NULL)
 		{
-			_platformDir* dir = _platformOpenDirectory(name);
+			// only names are needed so there is no need to classify anything
 			_platformDirEntry* entry = NULL;
+			String entryName;
 			while ((entry = _platformReadDirectory(dir)))
 			{
-				result += _platformGetDirEntryName(entry);
-			}
-			if (result.has("."))
-			{
-				result.remove(".");
-			}
-			if (result.has(".."))
-			{
-				result.remove("..");
+				entryName = _platformGetDirEntryName(entry);
+				if (entryName != "." && entryName != "..")
+				{
+					result += entryName;
+				}
 			}
 			_platformCloseDirectory(dir);
 		}
@@ -222,28 +611,13 @@ namespace hltypes
 	{
 		String name = Dir::normalize(dirName);
 		Array<String> result;
-		if (Dir::exists(name))
+		Array<DirEntry> entries = Dir::scan(name);
+		foreach (DirEntry, it, entries)
 		{
-			_platformDir* dir = _platformOpenDirectory(name);
-			_platformDirEntry* entry = NULL;
-			String entryName;
-			while ((entry = _platformReadDirectory(dir)))
+			if ((*it).isDirectory())
 			{
-				entryName = _platformGetDirEntryName(entry);
-				if (Dir::exists(Dir::joinPath(name, entryName, false)))
-				{
-					result += entryName;
-				}
-			}
-			if (result.has("."))
-			{
-				result.remove(".");
+				result += (*it).name;
 			}
-			if (result.has(".."))
-			{
-				result.remove("..");
-			}
-			_platformCloseDirectory(dir);
 		}
 		if (prependDir)
 		{
@@ -256,28 +630,13 @@ namespace hltypes
 	{
 		String name = Dir::normalize(dirName);
 		Array<String> result;
-		if (Dir::exists(name))
+		Array<DirEntry> entries = Dir::scan(name);
+		foreach (DirEntry, it, entries)
 		{
-			_platformDir* dir = _platformOpenDirectory(name);
-			_platformDirEntry* entry = NULL;
-			String entryName;
-			while ((entry = _platformReadDirectory(dir)))
+			if ((*it).isFile())
 			{
-				entryName = _platformGetDirEntryName(entry);
-				if (File::exists(Dir::joinPath(name, entryName, false)))
-				{
-					result += entryName;
-				}
-			}
-			if (result.has("."))
-			{
-				result.remove(".");
+				result += (*it).name;
 			}
-			if (result.has(".."))
-			{
-				result.remove("..");
-			}
-			_platformCloseDirectory(dir);
 		}
 		if (prependDir)
 		{
@@ -288,7 +647,9 @@ namespace hltypes
 
 	void Dir::chdir(const String& dirName)
 	{
-		return _platformChdir(Dir::systemize(dirName));
+		_platformChdir(Dir::systemize(dirName));
+		// cached relative paths don't point to the same entries anymore
+		PathCache::clear();
 	}
 
 	String Dir::cwd()
@@ -0,0 +1,559 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hencoding.h"
+#include "hltypesUtil.h"
+#include "hsbase.h"
+#include "hstream.h"
+#include "hstring.h"
+
+#define STREAM_BLOCK_SIZE 3072
+
+static const char* hexPairs =
+	"000102030405060708090A0B0C0D0E0F"
+	"101112131415161718191A1B1C1D1E1F"
+	"202122232425262728292A2B2C2D2E2F"
+	"303132333435363738393A3B3C3D3E3F"
+	"404142434445464748494A4B4C4D4E4F"
+	"505152535455565758595A5B5C5D5E5F"
+	"606162636465666768696A6B6C6D6E6F"
+	"707172737475767778797A7B7C7D7E7F"
+	"808182838485868788898A8B8C8D8E8F"
+	"909192939495969798999A9B9C9D9E9F"
+	"A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+	"B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+	"C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+	"D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+	"E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+	"F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+static const char* base64Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+// 0xFF marks characters that are not hex digits
+static const unsigned char hexValues[256] =
+{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+// 0xFF marks characters that are not in the base64 alphabet
+static const unsigned char base64Values[256] =
+{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+// 1 marks RFC 3986 unreserved characters
+static const unsigned char percentUnreserved[256] =
+{
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+namespace hltypes
+{
+	typedef int (*EncodeFunction)(const unsigned char* data, int size, char* output);
+	typedef int (*EncodedSizeFunction)(int size);
+
+	static int _readFully(StreamBase* stream, unsigned char* buffer, int count)
+	{
+		int result = 0;
+		while (result < count)
+		{
+			int read = stream->readRaw(&buffer[result], count - result);
+			if (read <= 0)
+			{
+				break;
+			}
+			result += read;
+		}
+		return result;
+	}
+
+	static String _encode(const unsigned char* data, int size, EncodeFunction encode, EncodedSizeFunction encodedSize)
+	{
+		if (size <= 0)
+		{
+			return String();
+		}
+		String result('\0', encodedSize(size));
+		encode(data, size, &result[0]);
+		return result;
+	}
+
+	static String _encode(StreamBase* stream, int size, EncodeFunction encode, EncodedSizeFunction encodedSize)
+	{
+		size = (int)hmin((int64_t)size, stream->size() - stream->position());
+		if (size <= 0)
+		{
+			return String();
+		}
+		String result('\0', encodedSize(size));
+		char* output = &result[0];
+		int written = 0;
+		int total = 0;
+		// the block size is a multiple of 3 so base64 padding can only appear at the very end
+		unsigned char buffer[STREAM_BLOCK_SIZE];
+		while (total < size)
+		{
+			int read = _readFully(stream, buffer, hmin(size - total, STREAM_BLOCK_SIZE));
+			if (read <= 0)
+			{
+				break;
+			}
+			written += encode(buffer, read, &output[written]);
+			total += read;
+		}
+		stream->seek(-total);
+		if (total < size)
+		{
+			return result.subString(0, written);
+		}
+		return result;
+	}
+
+	static bool _decode(const String& string, Stream* stream, int size, int (*decode)(const char*, int, unsigned char*))
+	{
+		if (size < 0)
+		{
+			return false;
+		}
+		if (size == 0)
+		{
+			return true;
+		}
+		int64_t position = stream->position();
+		int64_t streamSize = stream->size();
+		if (position < streamSize)
+		{
+			// existing data must stay untouched if the input is not valid, so it's decoded into a separate buffer first
+			if (position + size > stream->getCapacity() && !stream->setCapacity(position + size))
+			{
+				return false;
+			}
+			unsigned char* buffer = (unsigned char*)malloc(size);
+			if (buffer == NULL)
+			{
+				return false;
+			}
+			bool result = (decode(string.cStr(), string.size(), buffer) >= 0);
+			if (result)
+			{
+				stream->writeRaw(buffer, size);
+			}
+			free(buffer);
+			return result;
+		}
+		// appended data is decoded in place and simply cut off again if the input is not valid
+		if (stream->prepareManualWriteRaw(size) < size || decode(string.cStr(), string.size(), (unsigned char*)(*stream) + position) < 0)
+		{
+			stream->truncate(streamSize);
+			return false;
+		}
+		stream->seek(size);
+		return true;
+	}
+
+	// exact size of the decoded data or -1 if the length or padding is not valid
+	static int _base64DecodedSize(const char* string, int& length)
+	{
+		int originalLength = length;
+		if (length > 0 && string[length - 1] == '=')
+		{
+			--length;
+			if (length > 0 && string[length - 1] == '=')
+			{
+				--length;
+			}
+			if (originalLength % 4 != 0)
+			{
+				return -1;
+			}
+		}
+		if (length % 4 == 1)
+		{
+			return -1;
+		}
+		return (length / 4 * 3 + (length % 4 == 0 ? 0 : length % 4 - 1));
+	}
+
+	// exact size of the decoded data or -1 if an escape sequence is cut off
+	static int _percentDecodedSize(const char* string, int length)
+	{
+		int result = length;
+		const char* end = string + length;
+		for (const char* current = (const char*)memchr(string, '%', length); current != NULL; current = (const char*)memchr(current, '%', end - current))
+		{
+			if (end - current < 3)
+			{
+				return -1;
+			}
+			result -= 2;
+			current += 3;
+		}
+		return result;
+	}
+
+}
+
+int hpercentEncodedSize(const char* string, int length)
+{
+	const unsigned char* input = (const unsigned char*)string;
+	int result = length;
+	for_iter (i, 0, length)
+	{
+		if (percentUnreserved[input[i]] == 0)
+		{
+			result += 2;
+		}
+	}
+	return result;
+}
+
+int hhexEncode(const unsigned char* data, int size, char* output)
+{
+	for_iter (i, 0, size)
+	{
+		memcpy(&output[i * 2], &hexPairs[data[i] * 2], 2);
+	}
+	return (size * 2);
+}
+
+hltypes::String hhexEncode(const hltypes::String& string)
+{
+	return hltypes::_encode((const unsigned char*)string.cStr(), string.size(), &hhexEncode, &hhexEncodedSize);
+}
+
+hltypes::String hhexEncode(hltypes::StreamBase* stream, int size)
+{
+	return hltypes::_encode(stream, size, &hhexEncode, &hhexEncodedSize);
+}
+
+hltypes::String hhexEncode(hltypes::StreamBase* stream)
+{
+	return hltypes::_encode(stream, (int)(stream->size() - stream->position()), &hhexEncode, &hhexEncodedSize);
+}
+
+hltypes::String hhexEncode(hltypes::Stream* stream, int size)
+{
+	size = (int)hmin((int64_t)size, stream->size() - stream->position());
+	return hltypes::_encode((const unsigned char*)(*stream) + stream->position(), size, &hhexEncode, &hhexEncodedSize);
+}
+
+hltypes::String hhexEncode(hltypes::Stream* stream)
+{
+	return hhexEncode(stream, (int)(stream->size() - stream->position()));
+}
+
+int hhexDecode(const char* string, int length, unsigned char* output)
+{
+	if (length % 2 != 0)
+	{
+		return -1;
+	}
+	const unsigned char* input = (const unsigned char*)string;
+	int size = length / 2;
+	for_iter (i, 0, size)
+	{
+		unsigned char high = hexValues[input[i * 2]];
+		unsigned char low = hexValues[input[i * 2 + 1]];
+		if (((high | low) & 0xF0) != 0)
+		{
+			return -1;
+		}
+		output[i] = (unsigned char)((high << 4) | low);
+	}
+	return size;
+}
+
+bool hhexDecode(const hltypes::String& string, hltypes::String& output)
+{
+	int length = string.size();
+	if (length == 0)
+	{
+		output = hltypes::String();
+		return true;
+	}
+	if (length % 2 != 0)
+	{
+		return false;
+	}
+	hltypes::String result('\0', length / 2);
+	if (hhexDecode(string.cStr(), length, (unsigned char*)&result[0]) < 0)
+	{
+		return false;
+	}
+	output = result;
+	return true;
+}
+
+bool hhexDecode(const hltypes::String& string, hltypes::Stream* stream)
+{
+	int length = string.size();
+	return hltypes::_decode(string, stream, (length % 2 == 0 ? length / 2 : -1), &hhexDecode);
+}
+
+int hbase64Encode(const unsigned char* data, int size, char* output)
+{
+	char* current = output;
+	int blockSize = size - size % 3;
+	for (int i = 0; i < blockSize; i += 3)
+	{
+		unsigned int value = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+		current[0] = base64Alphabet[value >> 18];
+		current[1] = base64Alphabet[(value >> 12) & 0x3F];
+		current[2] = base64Alphabet[(value >> 6) & 0x3F];
+		current[3] = base64Alphabet[value & 0x3F];
+		current += 4;
+	}
+	if (blockSize < size)
+	{
+		unsigned int value = data[blockSize] << 16;
+		if (blockSize + 1 < size)
+		{
+			value |= data[blockSize + 1] << 8;
+		}
+		current[0] = base64Alphabet[value >> 18];
+		current[1] = base64Alphabet[(value >> 12) & 0x3F];
+		current[2] = (blockSize + 1 < size ? base64Alphabet[(value >> 6) & 0x3F] : '=');
+		current[3] = '=';
+		current += 4;
+	}
+	return (int)(current - output);
+}
+
+hltypes::String hbase64Encode(const hltypes::String& string)
+{
+	return hltypes::_encode((const unsigned char*)string.cStr(), string.size(), &hbase64Encode, &hbase64EncodedSize);
+}
+
+hltypes::String hbase64Encode(hltypes::StreamBase* stream, int size)
+{
+	return hltypes::_encode(stream, size, &hbase64Encode, &hbase64EncodedSize);
+}
+
+hltypes::String hbase64Encode(hltypes::StreamBase* stream)
+{
+	return hltypes::_encode(stream, (int)(stream->size() - stream->position()), &hbase64Encode, &hbase64EncodedSize);
+}
+
+hltypes::String hbase64Encode(hltypes::Stream* stream, int size)
+{
+	size = (int)hmin((int64_t)size, stream->size() - stream->position());
+	return hltypes::_encode((const unsigned char*)(*stream) + stream->position(), size, &hbase64Encode, &hbase64EncodedSize);
+}
+
+hltypes::String hbase64Encode(hltypes::Stream* stream)
+{
+	return hbase64Encode(stream, (int)(stream->size() - stream->position()));
+}
+
+int hbase64Decode(const char* string, int length, unsigned char* output)
+{
+	int result = hltypes::_base64DecodedSize(string, length);
+	if (result < 0)
+	{
+		return -1;
+	}
+	const unsigned char* input = (const unsigned char*)string;
+	unsigned char* current = output;
+	int blockLength = length - length % 4;
+	for (int i = 0; i < blockLength; i += 4)
+	{
+		unsigned char a = base64Values[input[i]];
+		unsigned char b = base64Values[input[i + 1]];
+		unsigned char c = base64Values[input[i + 2]];
+		unsigned char d = base64Values[input[i + 3]];
+		if (((a | b | c | d) & 0x80) != 0)
+		{
+			return -1;
+		}
+		unsigned int value = (a << 18) | (b << 12) | (c << 6) | d;
+		current[0] = (unsigned char)(value >> 16);
+		current[1] = (unsigned char)(value >> 8);
+		current[2] = (unsigned char)value;
+		current += 3;
+	}
+	if (blockLength < length)
+	{
+		unsigned char a = base64Values[input[blockLength]];
+		unsigned char b = base64Values[input[blockLength + 1]];
+		unsigned char c = (blockLength + 2 < length ? base64Values[input[blockLength + 2]] : 0);
+		if (((a | b | c) & 0x80) != 0)
+		{
+			return -1;
+		}
+		unsigned int value = (a << 18) | (b << 12) | (c << 6);
+		current[0] = (unsigned char)(value >> 16);
+		if (blockLength + 2 < length)
+		{
+			current[1] = (unsigned char)(value >> 8);
+		}
+	}
+	return result;
+}
+
+bool hbase64Decode(const hltypes::String& string, hltypes::String& output)
+{
+	int length = string.size();
+	int size = hltypes::_base64DecodedSize(string.cStr(), length);
+	if (size < 0)
+	{
+		return false;
+	}
+	if (size == 0)
+	{
+		output = hltypes::String();
+		return (length == 0);
+	}
+	hltypes::String result('\0', size);
+	if (hbase64Decode(string.cStr(), string.size(), (unsigned char*)&result[0]) < 0)
+	{
+		return false;
+	}
+	output = result;
+	return true;
+}
+
+bool hbase64Decode(const hltypes::String& string, hltypes::Stream* stream)
+{
+	int length = string.size();
+	return hltypes::_decode(string, stream, hltypes::_base64DecodedSize(string.cStr(), length), &hbase64Decode);
+}
+
+int hpercentEncode(const char* string, int length, char* output)
+{
+	const unsigned char* input = (const unsigned char*)string;
+	char* current = output;
+	for_iter (i, 0, length)
+	{
+		if (percentUnreserved[input[i]] != 0)
+		{
+			*current = (char)input[i];
+			++current;
+		}
+		else
+		{
+			current[0] = '%';
+			memcpy(&current[1], &hexPairs[input[i] * 2], 2);
+			current += 3;
+		}
+	}
+	return (int)(current - output);
+}
+
+hltypes::String hpercentEncode(const hltypes::String& string)
+{
+	int length = string.size();
+	int size = hpercentEncodedSize(string.cStr(), length);
+	if (size == 0)
+	{
+		return hltypes::String();
+	}
+	if (size == length)
+	{
+		return string;
+	}
+	hltypes::String result('\0', size);
+	hpercentEncode(string.cStr(), length, &result[0]);
+	return result;
+}
+
+int hpercentDecode(const char* string, int length, char* output)
+{
+	const unsigned char* input = (const unsigned char*)string;
+	char* current = output;
+	int i = 0;
+	while (i < length)
+	{
+		if (input[i] != '%')
+		{
+			*current = (char)input[i];
+			++current;
+			++i;
+			continue;
+		}
+		if (i + 2 >= length)
+		{
+			return -1;
+		}
+		unsigned char high = hexValues[input[i + 1]];
+		unsigned char low = hexValues[input[i + 2]];
+		if (((high | low) & 0xF0) != 0)
+		{
+			return -1;
+		}
+		*current = (char)((high << 4) | low);
+		++current;
+		i += 3;
+	}
+	return (int)(current - output);
+}
+
+bool hpercentDecode(const hltypes::String& string, hltypes::String& output)
+{
+	int length = string.size();
+	int size = hltypes::_percentDecodedSize(string.cStr(), length);
+	if (size < 0)
+	{
+		return false;
+	}
+	if (size == length)
+	{
+		output = string;
+		return true;
+	}
+	hltypes::String result('\0', size);
+	if (hpercentDecode(string.cStr(), length, &result[0]) != size)
+	{
+		return false;
+	}
+	output = result;
+	return true;
+}
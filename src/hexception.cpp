@@ -19,6 +19,7 @@
 #include "hrdir.h"
 #include "hresource.h"
 #include "hstring.h"
+#include "hstringbuilder.h"
 #include "platform_internal.h"
 
 namespace hltypes
@@ -35,7 +36,7 @@ namespace hltypes
 
 	void _Exception::_setInternalMessage(const String& message, const char* sourceFile, int lineNumber)
 	{
-		this->message = hsprintf("[%s:%d] %s", Dir::baseName(sourceFile).cStr(), lineNumber, message.cStr());
+		this->message = StringBuilder().add('[').add(Dir::baseName(sourceFile)).add(':').add(lineNumber).add("] ", 2).add(message).toString();
 		// because Visual Studio on WinRT cannot properly display exceptions and stack traces for some reason even though it should
 		// because Android doesn't display register data properly if an exception is thrown
 #if defined(_WIN32) || defined(_ANDROID)
@@ -52,7 +53,8 @@ namespace hltypes
 #if defined(_WIN32) || defined(_ANDROID)
 		int errnoValue = errno;
 #endif
-		String message = hsprintf("'%s' could not be opened!", filename.cStr());
+		StringBuilder message;
+		message.add('\'').add(filename).add("' could not be opened!");
 		try
 		{
 			String baseDir = DirBase::baseDir(filename);
@@ -62,12 +64,12 @@ namespace hltypes
 			{
 				if ((*it) == baseName)
 				{
-					message += " File appears to be in use.";
+					message.add(" File appears to be in use.");
 					throw _Exception("", "", 0);
 				}
 				if ((*it).lowered() == baseName.lowered())
 				{
-					message += " But there is a file with a different case: " + Dir::joinPath(baseDir, (*it));
+					message.add(" But there is a file with a different case: ").add(Dir::joinPath(baseDir, (*it)));
 					throw _Exception("", "", 0);
 				}
 			}
@@ -90,7 +92,7 @@ namespace hltypes
 							break;
 						}
 					}
-					message += " But part of the path seems to have a different case: " + Dir::joinPath(baseDir, baseName);
+					message.add(" But part of the path seems to have a different case: ").add(Dir::joinPath(baseDir, baseName));
 					throw _Exception("", "", 0);
 				}
 			}
@@ -99,11 +101,11 @@ namespace hltypes
 		{
 		}
 #if defined(_WIN32) || defined(_ANDROID)
-		message += " System error: " + String(strerror(errnoValue));
+		message.add(" System error: ").add(strerror(errnoValue));
 #else
-		message += " File not found!";
+		message.add(" File not found!");
 #endif
-		this->_setInternalMessage(message, sourceFile, lineNumber);
+		this->_setInternalMessage(message.toString(), sourceFile, lineNumber);
 	}
 	_FileCouldNotOpenException::~_FileCouldNotOpenException()
 	{
@@ -112,7 +114,7 @@ namespace hltypes
 	_FileNotOpenException::_FileNotOpenException(const String& filename, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("'%s' is not open!", filename.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add('\'').add(filename).add("' is not open!").toString(), sourceFile, lineNumber);
 	}
 	_FileNotOpenException::~_FileNotOpenException()
 	{
@@ -121,7 +123,7 @@ namespace hltypes
 	_FileNotWriteableException::_FileNotWriteableException(const String& filename, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("'%s' is not writeable!", filename.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add('\'').add(filename).add("' is not writeable!").toString(), sourceFile, lineNumber);
 	}
 	_FileNotWriteableException::~_FileNotWriteableException()
 	{
@@ -130,7 +132,7 @@ namespace hltypes
 	_ResourceNotExistsException::_ResourceNotExistsException(const String& type, const String& name, const String& container, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("'%s' '%s' does not exist in '%s'", name.cStr(), type.cStr(), container.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add('\'').add(name).add("' '").add(type).add("' does not exist in '").add(container).add('\'').toString(), sourceFile, lineNumber);
 	}
 	_ResourceNotExistsException::~_ResourceNotExistsException()
 	{
@@ -139,7 +141,7 @@ namespace hltypes
 	_ResourceAlreadyExistsException::_ResourceAlreadyExistsException(const String& type, const String& name, const String& container, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("'%s' '%s' already exists in '%s'", name.cStr(), type.cStr(), container.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add('\'').add(name).add("' '").add(type).add("' already exists in '").add(container).add('\'').toString(), sourceFile, lineNumber);
 	}
 	_ResourceAlreadyExistsException::~_ResourceAlreadyExistsException()
 	{
@@ -148,7 +150,7 @@ namespace hltypes
 	_ContainerIndexException::_ContainerIndexException(int index, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("index '%d' out of range", index), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add("index '").add(index).add("' out of range").toString(), sourceFile, lineNumber);
 	}
 	_ContainerIndexException::~_ContainerIndexException()
 	{
@@ -157,7 +159,7 @@ namespace hltypes
 	_ContainerEmptyException::_ContainerEmptyException(const String& functionName, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("'%s' cannot be used on a container with size = 0", functionName.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add('\'').add(functionName).add("' cannot be used on a container with size = 0").toString(), sourceFile, lineNumber);
 	}
 	_ContainerEmptyException::~_ContainerEmptyException()
 	{
@@ -175,7 +177,7 @@ namespace hltypes
 	_ContainerRangeException::_ContainerRangeException(int start, int count, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("range 'at %d for %d' out of range", start, count), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add("range 'at ").add(start).add(" for ").add(count).add("' out of range").toString(), sourceFile, lineNumber);
 	}
 	_ContainerRangeException::~_ContainerRangeException()
 	{
@@ -184,7 +186,7 @@ namespace hltypes
 	_ContainerKeyException::_ContainerKeyException(const String& key, const String& container, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("key '%s' not found in '%s'", key.cStr(), container.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add("key '").add(key).add("' not found in '").add(container).add('\'').toString(), sourceFile, lineNumber);
 	}
 	_ContainerKeyException::~_ContainerKeyException()
 	{
@@ -193,7 +195,7 @@ namespace hltypes
 	_ObjectCannotCopyException::_ObjectCannotCopyException(const String& name, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("cannot create copy of object of class '%s'", name.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add("cannot create copy of object of class '").add(name).add('\'').toString(), sourceFile, lineNumber);
 	}
 	_ObjectCannotCopyException::~_ObjectCannotCopyException()
 	{
@@ -202,7 +204,7 @@ namespace hltypes
 	_ObjectCannotAssignException::_ObjectCannotAssignException(const String& name, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("cannot assign object of class '%s'", name.cStr()), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add("cannot assign object of class '").add(name).add('\'').toString(), sourceFile, lineNumber);
 	}
 	_ObjectCannotAssignException::~_ObjectCannotAssignException()
 	{
@@ -211,7 +213,7 @@ namespace hltypes
 	_EnumerationValueNotExistsException::_EnumerationValueNotExistsException(unsigned int value, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("enum value does not exist: %d", value), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add("enum value does not exist: ").add((int)value).toString(), sourceFile, lineNumber);
 	}
 	_EnumerationValueNotExistsException::~_EnumerationValueNotExistsException()
 	{
@@ -220,7 +222,7 @@ namespace hltypes
 	_EnumerationValueAlreadyExistsException::_EnumerationValueAlreadyExistsException(unsigned int value, const char* sourceFile, int lineNumber) :
 		_Exception("", sourceFile, lineNumber)
 	{
-		this->_setInternalMessage(hsprintf("enum value already exists: %d", value), sourceFile, lineNumber);
+		this->_setInternalMessage(StringBuilder().add("enum value already exists: ").add((int)value).toString(), sourceFile, lineNumber);
 	}
 	_EnumerationValueAlreadyExistsException::~_EnumerationValueAlreadyExistsException()
 	{
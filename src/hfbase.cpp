@@ -6,8 +6,15 @@
 /// This program is free software; you can redistribute it and/or modify it under
 /// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
 
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "hdir.h"
 #include "hfbase.h"
+#include "hlog.h"
+#include "hltypesUtil.h"
+#include "hpathcache.h"
 #include "hstring.h"
 #include "hthread.h"
 #include "platform_internal.h"
@@ -22,6 +29,18 @@ namespace hltypes
 	{
 	}
 
+	IoVector::IoVector() : data(NULL), size(0)
+	{
+	}
+
+	IoVector::IoVector(void* data, int64_t size) : data(data), size(size)
+	{
+	}
+
+	IoVector::~IoVector()
+	{
+	}
+
 	HL_ENUM_CLASS_DEFINE(FileBase::AccessMode,
 	(
 		HL_ENUM_DEFINE(FileBase::AccessMode, Read);
@@ -45,12 +64,14 @@ namespace hltypes
 		FileBase::timeout = value;
 	}
 
-	FileBase::FileBase(const String& filename) : StreamBase(), cfile(NULL)
+	FileBase::FileBase(const String& filename) : StreamBase(), cfile(NULL), filePosition(0), appendMode(false), ioBuffer(NULL), ioBufferSize(0),
+		ioBufferStart(0), ioBufferEnd(0), ioBufferWriting(false), osBufferWriting(false), sequentialPosition(-1LL), writeFailed(false)
 	{
 		this->filename = Dir::normalize(filename);
 	}
 	
-	FileBase::FileBase() : StreamBase(), cfile(NULL)
+	FileBase::FileBase() : StreamBase(), cfile(NULL), filePosition(0), appendMode(false), ioBuffer(NULL), ioBufferSize(0),
+		ioBufferStart(0), ioBufferEnd(0), ioBufferWriting(false), osBufferWriting(false), sequentialPosition(-1LL), writeFailed(false)
 	{
 	}
 	
@@ -61,6 +82,114 @@ namespace hltypes
 		{
 			this->_fclose();
 		}
+		if (this->ioBuffer != NULL)
+		{
+			free(this->ioBuffer);
+		}
+	}
+
+	FileInfo FileBase::info()
+	{
+		this->_validate();
+		this->_fprepareDirectAccess();
+		FileInfo result;
+		if (!_platformStatOpenFile((_platformFile*)this->cfile, result))
+		{
+			result = _platformStatFile(this->filename);
+		}
+		return result;
+	}
+
+	int64_t FileBase::readAt(int64_t offset, void* buffer, int64_t count)
+	{
+		IoVector vector(buffer, count);
+		return this->_freadAt(offset, &vector, 1);
+	}
+
+	int64_t FileBase::readAt(int64_t offset, const Array<IoVector>& vectors)
+	{
+		return this->_freadAt(offset, (vectors.size() > 0 ? &vectors.first() : NULL), vectors.size());
+	}
+
+	int64_t FileBase::writeAt(int64_t offset, const void* buffer, int64_t count)
+	{
+		IoVector vector((void*)buffer, count);
+		return this->_fwriteAt(offset, &vector, 1);
+	}
+
+	int64_t FileBase::writeAt(int64_t offset, const Array<IoVector>& vectors)
+	{
+		return this->_fwriteAt(offset, (vectors.size() > 0 ? &vectors.first() : NULL), vectors.size());
+	}
+
+	int64_t FileBase::readv(const Array<IoVector>& vectors)
+	{
+		this->_validate();
+		if (vectors.size() == 0)
+		{
+			return 0;
+		}
+		this->_fdiscardBuffer();
+		this->_fprepareDirectAccess();
+		int64_t result = _platformReadFileAt((_platformFile*)this->cfile, &vectors.first(), vectors.size(), this->filePosition);
+		this->_freposition(this->filePosition + result);
+		this->sequentialPosition = -1LL;
+		return result;
+	}
+
+	int64_t FileBase::writev(const Array<IoVector>& vectors)
+	{
+		this->_validate();
+		if (vectors.size() == 0)
+		{
+			return 0;
+		}
+		this->_fdiscardBuffer();
+		this->_fprepareDirectAccess();
+		int64_t position = (this->appendMode ? this->dataSize : this->filePosition);
+		int64_t result = _platformWriteFileAt((_platformFile*)this->cfile, &vectors.first(), vectors.size(), position);
+		int64_t size = 0LL;
+		foreachc (IoVector, it, vectors)
+		{
+			size += (*it).size;
+		}
+		if (result < size)
+		{
+			this->writeFailed = true;
+		}
+		this->dataSize = hmax(this->dataSize, position + result);
+		this->_freposition(position + result);
+		this->sequentialPosition = -1LL;
+		return result;
+	}
+
+	void FileBase::setBufferSize(int value)
+	{
+		value = hmax(value, 0);
+		if (value == this->ioBufferSize)
+		{
+			return;
+		}
+		if (this->_fisOpen())
+		{
+			this->_fdiscardBuffer();
+		}
+		if (this->ioBuffer != NULL)
+		{
+			free(this->ioBuffer);
+			this->ioBuffer = NULL;
+		}
+		this->ioBufferSize = value;
+		if (this->ioBufferSize > 0)
+		{
+			this->ioBuffer = (unsigned char*)malloc(this->ioBufferSize);
+			if (this->ioBuffer == NULL)
+			{
+				// unbuffered access still works
+				Log::errorf(logTag, "Could not allocate buffer of %d bytes for %s!", this->ioBufferSize, this->_descriptor().cStr());
+				this->ioBufferSize = 0;
+			}
+		}
 	}
 
 	String FileBase::extensionOf(const String& path)
@@ -95,6 +224,10 @@ namespace hltypes
 	{
 		return this->filename;
 	}
+
+	void FileBase::_updateDataSize()
+	{
+	}
 	
 	void FileBase::_fopen(const String& filename, AccessMode accessMode, int repeats, float timeout)
 	{
@@ -147,25 +280,173 @@ namespace hltypes
 		{
 			throw FileCouldNotOpenException(this->_descriptor());
 		}
+		if (accessMode != AccessMode::Read && accessMode != AccessMode::ReadWrite)
+		{
+			// the file might have been created
+			PathCache::invalidate(this->filename);
+		}
+		this->_fprepare(accessMode == AccessMode::Append || accessMode == AccessMode::ReadAppend);
+	}
+
+	bool FileBase::_fcreate(const String& filename)
+	{
+		if (this->_isOpen())
+		{
+			this->_fclose();
+		}
+		this->filename = Dir::normalize(filename);
+		this->cfile = _platformCreateFile(this->filename);
+		if (this->cfile == NULL)
+		{
+			// the existing file belongs to someone else so it must not be referenced by this instance
+			bool exists = (errno == EEXIST);
+			String descriptor = this->_descriptor();
+			this->filename = "";
+			if (exists)
+			{
+				return false;
+			}
+			throw FileCouldNotOpenException(descriptor);
+		}
+		PathCache::invalidate(this->filename);
+		this->_fprepare(false);
+		return true;
+	}
+
+	void FileBase::_fprepare(bool appendMode)
+	{
+		this->appendMode = appendMode;
+		this->filePosition = _platformGetFilePosition((_platformFile*)this->cfile);
+		this->ioBufferStart = 0;
+		this->ioBufferEnd = 0;
+		this->ioBufferWriting = false;
+		this->osBufferWriting = false;
+		this->sequentialPosition = this->filePosition;
+		this->writeFailed = false;
 	}
 	
-	void FileBase::_fclose()
+	bool FileBase::_fclose()
 	{
 		this->_validate();
-		_platformCloseFile(this->cfile);
+		this->_fdiscardBuffer();
+		bool result = _platformCloseFile(this->cfile);
 		this->cfile = NULL;
 		this->dataSize = 0;
+		this->filePosition = 0;
+		this->appendMode = false;
+		this->osBufferWriting = false;
+		this->sequentialPosition = -1LL;
+		this->writeFailed = false;
+		return result;
+	}
+
+	bool FileBase::_fflush()
+	{
+		this->_validate();
+		if (this->ioBufferWriting)
+		{
+			this->_fdiscardBuffer();
+		}
+		bool result = _platformFlushFile((_platformFile*)this->cfile);
+		this->osBufferWriting = false;
+		return result;
 	}
 	
 	int FileBase::_fread(void* buffer, int count)
 	{
-		return _platformReadFile(buffer, 1, count, this->cfile);
+		if (this->ioBufferSize == 0)
+		{
+			return this->_freadDirect(buffer, count);
+		}
+		if (this->ioBufferWriting)
+		{
+			this->_fdiscardBuffer();
+		}
+		bool sequential = (this->sequentialPosition == this->_fposition());
+		unsigned char* destination = (unsigned char*)buffer;
+		int result = hmin(this->ioBufferEnd - this->ioBufferStart, count);
+		if (result > 0)
+		{
+			memcpy(destination, &this->ioBuffer[this->ioBufferStart], result);
+			this->ioBufferStart += result;
+		}
+		if (result < count)
+		{
+			this->ioBufferStart = 0;
+			this->ioBufferEnd = 0;
+			if (count - result >= this->ioBufferSize || !sequential)
+			{
+				// large reads and random access don't need any read-ahead
+				result += this->_freadDirect(&destination[result], count - result);
+			}
+			else
+			{
+				this->ioBufferEnd = this->_freadDirect(this->ioBuffer, this->ioBufferSize);
+				this->ioBufferStart = hmin(this->ioBufferEnd, count - result);
+				memcpy(&destination[result], this->ioBuffer, this->ioBufferStart);
+				result += this->ioBufferStart;
+			}
+		}
+		this->sequentialPosition = this->_fposition();
+		return result;
 	}
 	
 	int FileBase::_fwrite(const void* buffer, int count)
+	{
+		if (this->ioBufferSize == 0)
+		{
+			return this->_fwriteDirect(buffer, count);
+		}
+		if (!this->ioBufferWriting)
+		{
+			this->_fdiscardBuffer();
+			this->_freposition(this->filePosition);
+			this->ioBufferWriting = true;
+			this->sequentialPosition = -1LL;
+		}
+		if (this->ioBufferEnd + count > this->ioBufferSize)
+		{
+			this->_fdiscardBuffer();
+			this->ioBufferWriting = true;
+		}
+		if (count >= this->ioBufferSize)
+		{
+			return this->_fwriteDirect(buffer, count);
+		}
+		memcpy(&this->ioBuffer[this->ioBufferEnd], buffer, count);
+		this->ioBufferEnd += count;
+		if (this->appendMode)
+		{
+			this->dataSize += count; // appended data always goes to the end
+		}
+		else
+		{
+			this->dataSize = hmax(this->dataSize, this->filePosition + this->ioBufferEnd);
+		}
+		return count;
+	}
+
+	int FileBase::_freadDirect(void* buffer, int count)
+	{
+		int result = _platformReadFile(buffer, 1, count, this->cfile);
+		this->filePosition += result;
+		return result;
+	}
+
+	int FileBase::_fwriteDirect(const void* buffer, int count)
 	{
 		int result = (int)_platformWriteFile(buffer, 1, count, (FILE*)this->cfile);
-		this->dataSize = hmax(this->dataSize, this->_fposition());
+		if (result < count)
+		{
+			this->writeFailed = true;
+		}
+		this->osBufferWriting = true;
+		if (this->appendMode)
+		{
+			this->filePosition = this->dataSize; // appended data always goes to the end
+		}
+		this->filePosition += result;
+		this->dataSize = hmax(this->dataSize, this->filePosition);
 		return result;
 	}
 	
@@ -176,18 +457,121 @@ namespace hltypes
 	
 	int64_t FileBase::_fposition() const
 	{
-		return _platformGetFilePosition((_platformFile*)this->cfile);
+		if (this->ioBufferWriting)
+		{
+			return (this->appendMode ? this->dataSize : this->filePosition + this->ioBufferEnd);
+		}
+		return (this->filePosition - (this->ioBufferEnd - this->ioBufferStart));
 	}
 	
 	bool FileBase::_fseek(int64_t offset, SeekMode seekMode)
 	{
-		return _platformSeekFile((_platformFile*)this->cfile, this->size(), this->_fposition(), offset, seekMode);
+		int64_t position = this->_fposition();
+		if (!this->ioBufferWriting && this->ioBufferEnd > 0)
+		{
+			int64_t target = position + offset;
+			if (seekMode == SeekMode::Start)
+			{
+				target = offset;
+			}
+			else if (seekMode == SeekMode::End)
+			{
+				target = this->dataSize + offset;
+			}
+			// seeking within read-ahead data doesn't have to touch the file
+			int64_t bufferPosition = this->filePosition - this->ioBufferEnd;
+			if (target >= bufferPosition && target <= this->filePosition)
+			{
+				this->ioBufferStart = (int)(target - bufferPosition);
+				this->sequentialPosition = target;
+				return true;
+			}
+		}
+		this->_fdiscardBuffer();
+		bool result = _platformSeekFile((_platformFile*)this->cfile, this->size(), position, offset, seekMode);
+		this->filePosition = _platformGetFilePosition((_platformFile*)this->cfile);
+		this->osBufferWriting = false;
+		this->sequentialPosition = -1LL;
+		return result;
+	}
+
+	void FileBase::_fdiscardBuffer()
+	{
+		if (this->ioBufferWriting)
+		{
+			this->ioBufferWriting = false;
+			if (this->ioBufferEnd > 0)
+			{
+				int pending = this->ioBufferEnd;
+				this->ioBufferEnd = 0;
+				if (this->appendMode)
+				{
+					this->dataSize -= pending; // _fwriteDirect() adds it again
+				}
+				this->_fwriteDirect(this->ioBuffer, pending);
+				this->_freposition(this->filePosition);
+			}
+		}
+		else if (this->ioBufferStart < this->ioBufferEnd)
+		{
+			this->_freposition(this->_fposition());
+		}
+		this->ioBufferStart = 0;
+		this->ioBufferEnd = 0;
+	}
+
+	void FileBase::_freposition(int64_t position)
+	{
+		_platformSeekFile((_platformFile*)this->cfile, this->dataSize, 0LL, position, SeekMode::Start);
+		this->filePosition = position;
+		// seeking writes the OS file buffer
+		this->osBufferWriting = false;
+	}
+
+	int64_t FileBase::_freadAt(int64_t offset, const IoVector* vectors, int count)
+	{
+		this->_validate();
+		if (count == 0)
+		{
+			return 0;
+		}
+		this->_fprepareDirectAccess();
+		return _platformReadFileAt((_platformFile*)this->cfile, vectors, count, offset);
+	}
+
+	int64_t FileBase::_fwriteAt(int64_t offset, const IoVector* vectors, int count)
+	{
+		this->_validate();
+		if (count == 0)
+		{
+			return 0;
+		}
+		this->_fdiscardBuffer();
+		this->_fprepareDirectAccess();
+		int64_t result = _platformWriteFileAt((_platformFile*)this->cfile, vectors, count, offset);
+		this->dataSize = (this->appendMode ? this->dataSize + result : hmax(this->dataSize, offset + result));
+		// drops data that the OS file buffer might have read ahead before it was overwritten
+		this->_freposition(this->filePosition);
+		return result;
+	}
+
+	void FileBase::_fprepareDirectAccess()
+	{
+		if (this->ioBufferWriting && this->ioBufferEnd > 0)
+		{
+			this->_fdiscardBuffer();
+		}
+		if (this->osBufferWriting)
+		{
+			_platformFlushFile((_platformFile*)this->cfile);
+			this->osBufferWriting = false;
+		}
 	}
 	
 	bool FileBase::_fexists(const String& filename, bool caseSensitive)
 	{
 		String name = Dir::normalize(filename);
-		bool result = _platformFileExists(name);
+		bool result = PathCache::_fileExists(name);
 		if (!result && !caseSensitive)
 		{
 			String baseDir = Dir::baseDir(name);
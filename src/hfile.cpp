@@ -7,19 +7,70 @@
 /// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
 
 #define __HL_INCLUDE_PLATFORM_HEADERS
+#include "hasyncfile.h"
+#include "hatomicfile.h"
 #include "hdir.h"
 #include "hexception.h"
 #include "hfile.h"
 #include "hlog.h"
+#include "hmutex.h"
+#include "hpathcache.h"
 #include "hplatform.h"
 #include "hstring.h"
 #include "hthread.h"
 #include "platform_internal.h"
 
 #define BUFFER_SIZE 65536
+#define INFO_BATCH_SIZE 256
 
 namespace hltypes
 {
+	/// @brief Work that is shared by the threads of File::hinfo().
+	struct FileInfoState
+	{
+		const String* filenames;
+		int count;
+		FileInfo* results;
+		int next;
+		Mutex mutex;
+	};
+
+	/// @brief Gets the file information of batches of paths on its own thread.
+	class FileInfoThread : public Thread
+	{
+	public:
+		FileInfoState* state;
+
+		FileInfoThread(FileInfoState* state) : Thread(&FileInfoThread::_process, "hltypes file info"), state(state) { }
+
+		static void _processBatches(FileInfoState* state)
+		{
+			Mutex::ScopeLock lock;
+			int start = 0;
+			int count = 0;
+			while (true)
+			{
+				lock.acquire(&state->mutex);
+				start = state->next;
+				count = hmin(state->count - start, INFO_BATCH_SIZE);
+				state->next += count;
+				lock.release();
+				if (count <= 0)
+				{
+					break;
+				}
+				_platformStatFiles(&state->filenames[start], count, &state->results[start]);
+			}
+		}
+
+	protected:
+		static void _process(Thread* thread)
+		{
+			FileInfoThread::_processBatches(((FileInfoThread*)thread)->state);
+		}
+
+	};
+
 	File::File() : FileBase()
 	{
 	}
@@ -35,21 +86,26 @@ namespace hltypes
 	void File::open(const String& filename)
 	{
 		this->_fopen(filename, AccessMode::Read, FileBase::repeats, FileBase::timeout);
-		// initial size must be set manually with hinfo(), because _updateDataSize() uses seeking which requires the size again
-		this->dataSize = File::hinfo(this->filename).size;
+		// initial size is taken from the open handle, the path doesn't have to be looked up again
+		this->dataSize = this->info().size;
 	}
 
 	void File::open(const String& filename, AccessMode accessMode)
 	{
 		this->_fopen(filename, accessMode, FileBase::repeats, FileBase::timeout);
-		// initial size must be set manually with hinfo(), because _updateDataSize() uses seeking which requires the size again
-		this->dataSize = File::hinfo(this->filename).size;
+		// initial size is taken from the open handle, the path doesn't have to be looked up again
+		this->dataSize = this->info().size;
 	}
 
 	void File::close()
 	{
 		this->_fclose();
 	}
+
+	void File::flush()
+	{
+		this->_fflush();
+	}
 	
 	int File::_read(void* buffer, int count)
 	{
@@ -90,6 +146,7 @@ namespace hltypes
 				if (file != NULL)
 				{
 					_platformCloseFile(file);
+					PathCache::invalidate(name);
 					return true;
 				}
 				--attempts;
@@ -110,7 +167,10 @@ namespace hltypes
 	
 	bool File::remove(const String& filename)
 	{
-		return _platformRemoveFile(Dir::normalize(filename));
+		String name = Dir::normalize(filename);
+		bool result = _platformRemoveFile(name);
+		PathCache::invalidate(name);
+		return result;
 	}
 	
 	bool File::exists(const String& filename, bool caseSensitive) // such an sensitive method
@@ -131,6 +191,7 @@ namespace hltypes
 				if (file != NULL)
 				{
 					_platformCloseFile(file);
+					PathCache::invalidate(name);
 					return true;
 				}
 				--attempts;
@@ -161,7 +222,10 @@ namespace hltypes
 			File::remove(newName);
 		}
 		Dir::create(Dir::baseDir(newName));
-		return _platformRenameFile(oldName, newName);
+		bool result = _platformRenameFile(oldName, newName);
+		PathCache::invalidate(oldName);
+		PathCache::invalidate(newName);
+		return result;
 	}
 	
 	bool File::move(const String& filename, const String& path, bool overwrite)
@@ -170,7 +234,7 @@ namespace hltypes
 		return File::rename(name, Dir::joinPath(path, Dir::baseName(name), false), overwrite);
 	}
 	
-	bool File::copy(const String& oldFilename, const String& newFilename, bool overwrite)
+	bool File::copy(const String& oldFilename, const String& newFilename, bool overwrite, bool preserveTimes)
 	{
 		String oldName = Dir::normalize(oldFilename);
 		String newName = Dir::normalize(newFilename);
@@ -179,17 +243,29 @@ namespace hltypes
 			return false;
 		}
 		Dir::create(Dir::baseDir(newName));
-		File oldFile;
-		File newFile;
-		oldFile.open(oldName);
-		newFile.open(newName, File::AccessMode::Write);
-		int count = 0;
-		unsigned char c[BUFFER_SIZE] = {0};
-		while (!oldFile.eof())
+		if (!_platformCopyFile(oldName, newName))
 		{
-			count = _platformReadFile(c, 1, BUFFER_SIZE, (_platformFile*)oldFile.cfile);
-			_platformWriteFile(c, 1, count, (_platformFile*)newFile.cfile);
+			File oldFile;
+			File newFile;
+			oldFile.open(oldName);
+			newFile.open(newName, File::AccessMode::Write);
+			int count = 0;
+			unsigned char c[BUFFER_SIZE] = {0};
+			while (!oldFile.eof())
+			{
+				count = oldFile._fread(c, BUFFER_SIZE);
+				if (count <= 0)
+				{
+					break;
+				}
+				newFile._fwrite(c, count);
+			}
 		}
+		if (preserveTimes)
+		{
+			_platformSetFileTimes(newName, _platformStatFile(oldName));
+		}
+		PathCache::invalidate(newName);
 		return true;
 	}
 	
@@ -221,11 +297,87 @@ namespace hltypes
 		file.write(text);
 	}
 
+	bool File::writeAtomic(const String& filename, const String& text, AtomicFile::SyncMode syncMode)
+	{
+		AtomicFile file(filename);
+		if (file.writeRaw((void*)text.cStr(), text.size()) != text.size())
+		{
+			file.discard();
+			return false;
+		}
+		return file.commit(syncMode);
+	}
+
+	bool File::writeAtomic(const String& filename, const unsigned char* data, int size, AtomicFile::SyncMode syncMode)
+	{
+		AtomicFile file(filename);
+		if (file.writeRaw((void*)data, size) != size)
+		{
+			file.discard();
+			return false;
+		}
+		return file.commit(syncMode);
+	}
+
+	AsyncRequest* File::hreadAsync(const String& filename, void (*callback)(AsyncRequest*), void* userData)
+	{
+		return AsyncFile::readAsync(filename, callback, userData);
+	}
+
+	AsyncRequest* File::hwriteAsync(const String& filename, const String& text, void (*callback)(AsyncRequest*), void* userData)
+	{
+		Stream stream;
+		stream.write(text);
+		return AsyncFile::writeAsync(filename, stream, callback, userData);
+	}
+
+	AsyncRequest* File::happendAsync(const String& filename, const String& text, void (*callback)(AsyncRequest*), void* userData)
+	{
+		Stream stream;
+		stream.write(text);
+		return AsyncFile::appendAsync(filename, stream, callback, userData);
+	}
+
 	FileInfo File::hinfo(const String& filename)
 	{
 		return _platformStatFile(filename);
 	}
 
+	Array<FileInfo> File::hinfo(const Array<String>& filenames, int threadCount)
+	{
+		Array<FileInfo> result(FileInfo(), filenames.size());
+		if (filenames.size() == 0)
+		{
+			return result;
+		}
+		threadCount = hclamp(threadCount, 1, (filenames.size() + INFO_BATCH_SIZE - 1) / INFO_BATCH_SIZE);
+		if (threadCount == 1)
+		{
+			_platformStatFiles(&filenames.first(), filenames.size(), &result.first());
+			return result;
+		}
+		// batches of consecutive paths keep paths of the same directory together
+		FileInfoState state;
+		state.filenames = &filenames.first();
+		state.count = filenames.size();
+		state.results = &result.first();
+		state.next = 0;
+		// the calling thread does its share of the work as well, so threads that are joined before they even started don't leave any work undone
+		Array<FileInfoThread*> threads;
+		for_iter (i, 1, threadCount)
+		{
+			threads += new FileInfoThread(&state);
+			threads.last()->start();
+		}
+		FileInfoThread::_processBatches(&state);
+		foreach (FileInfoThread*, it, threads)
+		{
+			(*it)->join();
+			delete (*it);
+		}
+		return result;
+	}
+
 	File::File(const File& other)
 	{
 		throw ObjectCannotCopyException("hltypes::File");
@@ -0,0 +1,165 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#ifdef _ZIPRESOURCE
+#define MINIZ_HEADER_FILE_ONLY
+#include <miniz.cpp>
+#endif
+
+#include "hdeflatestream.h"
+#include "hexception.h"
+#include "hgzipstream.h"
+#include "hlog.h"
+#include "hltypesUtil.h"
+#include "hsbase.h"
+#include "hstring.h"
+
+#define GZIP_HEADER_SIZE 10
+#define GZIP_TRAILER_SIZE 8
+#define GZIP_METHOD_DEFLATE 8
+#define GZIP_FLAG_HCRC 0x02
+#define GZIP_FLAG_EXTRA 0x04
+#define GZIP_FLAG_NAME 0x08
+#define GZIP_FLAG_COMMENT 0x10
+#define GZIP_OS_UNKNOWN 255
+
+namespace hltypes
+{
+	static unsigned int _readUint32Le(const unsigned char* data)
+	{
+		return ((unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24));
+	}
+
+	static void _writeUint32Le(unsigned char* data, unsigned int value)
+	{
+		data[0] = (unsigned char)(value & 0xFF);
+		data[1] = (unsigned char)((value >> 8) & 0xFF);
+		data[2] = (unsigned char)((value >> 16) & 0xFF);
+		data[3] = (unsigned char)((value >> 24) & 0xFF);
+	}
+
+	GzipStream::GzipStream(StreamBase* stream, Mode mode, int level, int bufferSize) : DeflateStream(stream, mode, level, bufferSize, false),
+		crc(0), uncompressedSize(0)
+	{
+		this->_initialize();
+	}
+
+	GzipStream::~GzipStream()
+	{
+		// has to happen here, the trailer can't be written from the base destructor anymore
+		try
+		{
+			this->finish();
+		}
+		catch (hexception& e)
+		{
+			Log::error(logTag, e.getMessage());
+		}
+	}
+
+	GzipStream::GzipStream(const GzipStream& other) : DeflateStream(NULL, Mode::Compress, 0, 0, false)
+	{
+		throw ObjectCannotCopyException("hltypes::GzipStream");
+	}
+
+	GzipStream& GzipStream::operator=(GzipStream& other)
+	{
+		throw ObjectCannotAssignException("hltypes::GzipStream");
+		return (*this);
+	}
+
+	int GzipStream::_windowBits() const
+	{
+		return -15;
+	}
+
+	void GzipStream::_writeHeader()
+	{
+		this->crc = 0;
+		this->uncompressedSize = 0;
+		unsigned char header[GZIP_HEADER_SIZE] = {0x1F, 0x8B, GZIP_METHOD_DEFLATE, 0, 0, 0, 0, 0, 0, GZIP_OS_UNKNOWN};
+		if (this->level >= HL_DEFLATE_BEST_LEVEL)
+		{
+			header[8] = 2;
+		}
+		else if (this->level <= HL_DEFLATE_FASTEST_LEVEL)
+		{
+			header[8] = 4;
+		}
+		if (this->stream->writeRaw(header, GZIP_HEADER_SIZE) != GZIP_HEADER_SIZE)
+		{
+			throw Exception("Could not write header of " + this->_descriptor() + "!");
+		}
+	}
+
+	void GzipStream::_writeTrailer()
+	{
+		unsigned char trailer[GZIP_TRAILER_SIZE];
+		_writeUint32Le(trailer, this->crc);
+		_writeUint32Le(&trailer[4], this->uncompressedSize);
+		if (this->stream->writeRaw(trailer, GZIP_TRAILER_SIZE) != GZIP_TRAILER_SIZE)
+		{
+			throw Exception("Could not write trailer of " + this->_descriptor() + "!");
+		}
+	}
+
+	void GzipStream::_readHeader()
+	{
+		this->crc = 0;
+		this->uncompressedSize = 0;
+		unsigned char header[GZIP_HEADER_SIZE];
+		if (this->stream->readRaw(header, GZIP_HEADER_SIZE) != GZIP_HEADER_SIZE || header[0] != 0x1F || header[1] != 0x8B || header[2] != GZIP_METHOD_DEFLATE)
+		{
+			throw Exception("Data in " + this->_descriptor() + " is not in gzip format!");
+		}
+		unsigned char flags = header[3];
+		if ((flags & GZIP_FLAG_EXTRA) != 0)
+		{
+			unsigned char extraSize[2] = {0, 0};
+			this->stream->readRaw(extraSize, 2);
+			this->stream->seek((int64_t)extraSize[0] | ((int64_t)extraSize[1] << 8));
+		}
+		unsigned char character = 0;
+		if ((flags & GZIP_FLAG_NAME) != 0)
+		{
+			while (this->stream->readRaw(&character, 1) == 1 && character != 0);
+		}
+		if ((flags & GZIP_FLAG_COMMENT) != 0)
+		{
+			while (this->stream->readRaw(&character, 1) == 1 && character != 0);
+		}
+		if ((flags & GZIP_FLAG_HCRC) != 0)
+		{
+			this->stream->seek(2);
+		}
+	}
+
+	void GzipStream::_readTrailer()
+	{
+		unsigned char trailer[GZIP_TRAILER_SIZE];
+		if (this->stream->readRaw(trailer, GZIP_TRAILER_SIZE) != GZIP_TRAILER_SIZE)
+		{
+			throw Exception("Trailer of " + this->_descriptor() + " is incomplete!");
+		}
+		if (_readUint32Le(trailer) != this->crc || _readUint32Le(&trailer[4]) != this->uncompressedSize)
+		{
+			throw Exception("Data in " + this->_descriptor() + " is corrupted, checksum mismatch!");
+		}
+	}
+
+	void GzipStream::_updateChecksum(const unsigned char* data, int size)
+	{
+#ifdef _ZIPRESOURCE
+		this->crc = (unsigned int)miniz::mz_crc32(this->crc, data, size);
+#else
+		(void)data; // only needed with _ZIPRESOURCE
+#endif
+		this->uncompressedSize += (unsigned int)size;
+	}
+
+}
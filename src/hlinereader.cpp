@@ -0,0 +1,169 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexception.h"
+#include "hlinereader.h"
+#include "hltypesUtil.h"
+#include "hsbase.h"
+#include "hstring.h"
+
+#define MIN_BUFFER_SIZE 64
+
+namespace hltypes
+{
+	LineReader::LineReader(StreamBase* stream, const String& delimiter, int bufferSize) : stream(stream), delimiter(delimiter),
+		bufferStart(0), bufferEnd(0), searchStart(0), streamEnded(false)
+	{
+		if (this->delimiter == "")
+		{
+			this->delimiter = "\n";
+		}
+		this->bufferCapacity = hmax(bufferSize, MIN_BUFFER_SIZE);
+		this->buffer = (char*)malloc(this->bufferCapacity);
+	}
+
+	LineReader::~LineReader()
+	{
+		free(this->buffer);
+	}
+
+	LineReader::LineReader(const LineReader& other)
+	{
+		throw ObjectCannotCopyException("hltypes::LineReader");
+	}
+
+	LineReader& LineReader::operator=(LineReader& other)
+	{
+		throw ObjectCannotAssignException("hltypes::LineReader");
+		return (*this);
+	}
+
+	bool LineReader::next(const char*& outData, int& outSize)
+	{
+		const char* found = NULL;
+		while (true)
+		{
+			found = this->_findDelimiter();
+			if (found != NULL || this->streamEnded)
+			{
+				break;
+			}
+			this->_fill();
+		}
+		const char* start = &this->buffer[this->bufferStart];
+		if (found != NULL)
+		{
+			outSize = (int)(found - start);
+			this->bufferStart += outSize + this->delimiter.size();
+		}
+		else if (this->bufferStart < this->bufferEnd)
+		{
+			outSize = this->bufferEnd - this->bufferStart; // last line without delimiter
+			this->bufferStart = this->bufferEnd;
+		}
+		else
+		{
+			return false;
+		}
+		this->searchStart = this->bufferStart;
+		if (outSize > 0 && start[outSize - 1] == '\r')
+		{
+			--outSize;
+		}
+		outData = start;
+		return true;
+	}
+
+	bool LineReader::next(String& outLine)
+	{
+		const char* data = NULL;
+		int size = 0;
+		if (!this->next(data, size))
+		{
+			return false;
+		}
+		// assigning and appending keeps the String's capacity
+		outLine = "";
+		outLine.add(data, size);
+		return true;
+	}
+
+	int64_t LineReader::position() const
+	{
+		return (this->stream->position() - (this->bufferEnd - this->bufferStart));
+	}
+
+	void LineReader::reset()
+	{
+		this->bufferStart = 0;
+		this->bufferEnd = 0;
+		this->searchStart = 0;
+		this->streamEnded = false;
+	}
+
+	const char* LineReader::_findDelimiter()
+	{
+		int delimiterSize = this->delimiter.size();
+		int searchEnd = this->bufferEnd - delimiterSize + 1;
+		if (this->searchStart >= searchEnd)
+		{
+			return NULL;
+		}
+		const char* delimiterData = this->delimiter.cStr();
+		const char* result = NULL;
+		const char* current = &this->buffer[this->searchStart];
+		const char* end = &this->buffer[searchEnd];
+		while (current < end)
+		{
+			result = (const char*)memchr(current, delimiterData[0], end - current);
+			if (result == NULL)
+			{
+				break;
+			}
+			if (delimiterSize == 1 || memcmp(result + 1, delimiterData + 1, delimiterSize - 1) == 0)
+			{
+				return result;
+			}
+			current = result + 1;
+		}
+		// a delimiter can still start in the last few bytes once more data has been read
+		this->searchStart = searchEnd;
+		return NULL;
+	}
+
+	void LineReader::_fill()
+	{
+		if (this->bufferStart > 0)
+		{
+			int remaining = this->bufferEnd - this->bufferStart;
+			if (remaining > 0)
+			{
+				memmove(this->buffer, &this->buffer[this->bufferStart], remaining);
+			}
+			this->searchStart -= this->bufferStart;
+			this->bufferEnd = remaining;
+			this->bufferStart = 0;
+		}
+		if (this->bufferEnd >= this->bufferCapacity)
+		{
+			this->bufferCapacity *= 2;
+			this->buffer = (char*)realloc(this->buffer, this->bufferCapacity);
+		}
+		int read = this->stream->readRaw(&this->buffer[this->bufferEnd], this->bufferCapacity - this->bufferEnd);
+		if (read <= 0)
+		{
+			this->streamEnded = true;
+			return;
+		}
+		this->bufferEnd += read;
+	}
+
+}
@@ -18,6 +18,7 @@
 #include "hmutex.h"
 #include "hplatform.h"
 #include "hstring.h"
+#include "hstringbuilder.h"
 #include "platform_internal.h"
 
 // required for Win32 only actually
@@ -30,13 +31,10 @@
 #endif
 
 #define MAKE_VA_ARGS(result, format) \
-	String result; \
-	{ \
-		va_list args; \
-		va_start(args, format); \
-		result = String(hvsprintf(format, args)); \
-		va_end(args); \
-	}
+	va_list args; \
+	va_start(args, format); \
+	String result = hvsprintf(format, args); \
+	va_end(args);
 
 namespace hltypes
 {
@@ -203,14 +201,7 @@ namespace hltypes
 		{
 			Dir::create(filename + ".hlog");
 		}
-		String newFilename = Log::_makeFilename(filename, Log::fileIndex);
-		if (File::hinfo(newFilename).size > MAX_FILE_SIZE)
-		{
-			++Log::fileIndex;
-			newFilename = Log::_makeFilename(filename, Log::fileIndex);
-			File::createNew(newFilename); // clears the file
-		}
-		return newFilename;
+		return Log::_makeFilename(filename, Log::fileIndex);
 	}
 
 	bool Log::_systemLog(const String& tag, const String& message, int level) // level is needed for Android
@@ -249,10 +240,20 @@ namespace hltypes
 				file.open(Log::filename, File::AccessMode::Append);
 #else
 				file.open(Log::_makeCurrentFilename(Log::filename), File::AccessMode::Append);
+				// the size comes from the open handle so the file doesn't have to be looked up again for every message
+				if (file.size() > MAX_FILE_SIZE)
+				{
+					++Log::fileIndex;
+					file.open(Log::_makeFilename(Log::filename, Log::fileIndex), File::AccessMode::Write); // clears the file
+				}
 #endif
-				String logMessage = (tag != "" ? "[" + tag + "] " + message : message);
-				file.write(logMessage);
-				file.write("\n");
+				StringBuilder logMessage(tag.size() + message.size() + 4);
+				if (tag != "")
+				{
+					logMessage.add('[').add(tag).add("] ", 2);
+				}
+				logMessage.add(message).add('\n');
+				file.write(logMessage.toString());
 			}
 			catch (_Exception& e)
 			{
@@ -21,6 +21,7 @@
 #include "harray.h"
 #include "hlog.h"
 #include "hltypesUtil.h"
+#include "hmappedfile.h"
 #include "hplatform.h"
 #include "hresource.h"
 #include "hstream.h"
@@ -44,6 +45,7 @@
 
 #define MAX_STACK_ADDRESS_NAME_SIZE 1024
 #define MAX_STACK_FRAMES 62 // WinXP has a max of 63 frames and the current frame is always skipped
+#define CRC32_BUFFER_SIZE 65536
 
 namespace hltypes
 {
@@ -527,49 +529,79 @@ void createCrc32Table()
 	crc32TableCreated = true;
 }
 
-unsigned int hcrc32(const unsigned char* data, unsigned int size)
+static unsigned int _updateCrc32(unsigned int crc, const unsigned char* data, int64_t size)
 {
-	createCrc32Table();
-	unsigned int crc = 0xFFFFFFFF;
-	for_itert (unsigned int, i, 0, size)
+	for_itert (int64_t, i, 0, size)
 	{
 		crc = ((crc >> 8) & 0xFFFFFF) ^ crc32Table[(crc ^ data[i]) & 0xFF];
 	}
-	return ((crc & 0xFFFFFFFF) ^ 0xFFFFFFFF);
+	return crc;
+}
+
+unsigned int hcrc32(const unsigned char* data, int64_t size)
+{
+	createCrc32Table();
+	return ((_updateCrc32(0xFFFFFFFF, data, size) & 0xFFFFFFFF) ^ 0xFFFFFFFF);
 }
 
-unsigned int hcrc32(hltypes::StreamBase* stream, unsigned int size)
+unsigned int hcrc32(hltypes::StreamBase* stream, int64_t size)
 {
-	size = hmin(size, (unsigned int)(stream->size() - stream->position()));
+	size = hmin(size, stream->size() - stream->position());
 	if (size <= 0)
 	{
 		return 0;
 	}
-	unsigned char* data = new unsigned char[size];
-	int read = stream->readRaw(data, size);
-	if (read == 0)
+	createCrc32Table();
+	unsigned char* data = new unsigned char[CRC32_BUFFER_SIZE];
+	unsigned int crc = 0xFFFFFFFF;
+	int64_t done = 0LL;
+	int read = 0;
+	while (done < size)
 	{
-		delete[] data;
-		return 0;
+		read = (int)stream->readRaw(data, hmin(size - done, (int64_t)CRC32_BUFFER_SIZE));
+		if (read <= 0)
+		{
+			break;
+		}
+		crc = _updateCrc32(crc, data, read);
+		done += read;
 	}
-	stream->seek(-read);
-	unsigned int result = hcrc32(data, size);
 	delete[] data;
-	return result;
+	stream->seek(-done);
+	if (done == 0)
+	{
+		return 0;
+	}
+	return ((crc & 0xFFFFFFFF) ^ 0xFFFFFFFF);
 }
 
 unsigned int hcrc32(hltypes::StreamBase* stream)
 {
-	return hcrc32(stream, (unsigned int)(stream->size() - stream->position()));
+	return hcrc32(stream, stream->size() - stream->position());
 }
 
-unsigned int hcrc32(hltypes::Stream* stream, unsigned int size)
+unsigned int hcrc32(hltypes::Stream* stream, int64_t size)
 {
-	return hcrc32(&stream->operator[]((int)stream->position()), hmin(size, (unsigned int)(stream->size() - stream->position())));
+	return hcrc32(&stream->operator[](stream->position()), hmin(size, stream->size() - stream->position()));
 }
 
 unsigned int hcrc32(hltypes::Stream* stream)
 {
-	return hcrc32(&stream->operator[]((int)stream->position()), (unsigned int)(stream->size() - stream->position()));
+	return hcrc32(&stream->operator[](stream->position()), stream->size() - stream->position());
+}
+
+unsigned int hcrc32(hltypes::MappedFile* file, int64_t size)
+{
+	int64_t remaining = file->size() - file->position();
+	if (remaining <= 0)
+	{
+		return 0;
+	}
+	return hcrc32(file->getData() + file->position(), hmin(size, remaining));
+}
+
+unsigned int hcrc32(hltypes::MappedFile* file)
+{
+	return hcrc32(file, hmax(file->size() - file->position(), (int64_t)0));
 }
 
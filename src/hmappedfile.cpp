@@ -0,0 +1,168 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hdir.h"
+#include "hexception.h"
+#include "hfile.h"
+#include "hltypesUtil.h"
+#include "hmappedfile.h"
+#include "hstring.h"
+#include "platform_internal.h"
+
+namespace hltypes
+{
+	MappedFile::MappedFile() : StreamBase(), data(NULL), handle(NULL), mapped(false), streamPosition(0LL)
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (this->_isOpen())
+		{
+			this->close();
+		}
+	}
+
+	MappedFile::MappedFile(const MappedFile& other)
+	{
+		throw ObjectCannotCopyException("hltypes::MappedFile");
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile& other)
+	{
+		throw ObjectCannotAssignException("hltypes::MappedFile");
+		return (*this);
+	}
+
+	void MappedFile::open(const String& filename, bool privateCopy)
+	{
+		if (this->_isOpen())
+		{
+			this->close();
+		}
+		this->filename = Dir::normalize(filename);
+		int64_t size = 0LL;
+		this->data = (unsigned char*)_platformMapFile(this->filename, privateCopy, size, this->handle);
+		if (this->data != NULL)
+		{
+			this->mapped = true;
+			this->dataSize = size;
+		}
+		else
+		{
+			// empty files can't be mapped and some platforms can't map at all
+			File file;
+			file.open(this->filename);
+			size = file.size();
+			if (size >= (int64_t)INT_MAX)
+			{
+				throw FileCouldNotOpenException(this->filename);
+			}
+			// always null-terminated, see isNullTerminated()
+			this->data = (unsigned char*)malloc((int)size + 1);
+			if (this->data == NULL)
+			{
+				throw FileCouldNotOpenException(this->filename);
+			}
+			this->data[size] = 0;
+			this->dataSize = (int64_t)file.readRaw(this->data, (int)size);
+		}
+		this->streamPosition = 0LL;
+	}
+
+	void MappedFile::close()
+	{
+		this->_validate();
+		if (this->mapped)
+		{
+			_platformUnmapFile(this->data, this->dataSize, this->handle);
+		}
+		else
+		{
+			free(this->data);
+		}
+		this->data = NULL;
+		this->handle = NULL;
+		this->mapped = false;
+		this->dataSize = 0LL;
+		this->streamPosition = 0LL;
+		this->filename = "";
+	}
+
+	bool MappedFile::isNullTerminated() const
+	{
+		return (this->data != NULL && (!this->mapped || this->dataSize % _platformGetPageSize() != 0));
+	}
+
+	const unsigned char& MappedFile::operator[](int index) const
+	{
+		if (index < 0)
+		{
+			index = (int)((int64_t)index + this->dataSize);
+		}
+		return this->data[index];
+	}
+
+	void MappedFile::_updateDataSize()
+	{
+	}
+
+	int MappedFile::_read(void* buffer, int count)
+	{
+		// the position can be past the end after seeking
+		if (count <= 0 || this->streamPosition >= this->dataSize)
+		{
+			return 0;
+		}
+		int readSize = (int)hmin((int64_t)count, this->dataSize - this->streamPosition);
+		memcpy(buffer, &this->data[this->streamPosition], readSize);
+		this->streamPosition += readSize;
+		return readSize;
+	}
+
+	int MappedFile::_write(const void*, int)
+	{
+		throw FileNotWriteableException(this->filename);
+		return 0;
+	}
+
+	bool MappedFile::_isOpen() const
+	{
+		return (this->data != NULL);
+	}
+
+	int64_t MappedFile::_position() const
+	{
+		return this->streamPosition;
+	}
+
+	bool MappedFile::_seek(int64_t offset, SeekMode seekMode)
+	{
+		int64_t position = this->streamPosition;
+		if (seekMode == SeekMode::Start)
+		{
+			position = 0LL;
+		}
+		else if (seekMode == SeekMode::End)
+		{
+			position = this->dataSize;
+		}
+		position += offset;
+		if (position < 0LL)
+		{
+			return false;
+		}
+		this->streamPosition = position;
+		return true;
+	}
+
+}
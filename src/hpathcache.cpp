@@ -0,0 +1,346 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "harray.h"
+#include "hdir.h"
+#include "hltypesUtil.h"
+#include "hmap.h"
+#include "hmutex.h"
+#include "hpathcache.h"
+#include "hstring.h"
+#include "hthread.h"
+#include "platform_internal.h"
+
+#define WATCH_POLL_TIMEOUT 100
+#define WATCH_BUFFER_SIZE 4096
+
+namespace hltypes
+{
+	volatile bool PathCache::enabled = false;
+	float PathCache::timeToLive = HL_PATH_CACHE_TIME_TO_LIVE;
+	int64_t PathCache::hits = 0LL;
+	int64_t PathCache::misses = 0LL;
+	Map<String, PathCache::StatEntry> PathCache::stats;
+	Map<String, PathCache::ListingEntry> PathCache::listings;
+	int64_t PathCache::generation = 0LL;
+	Mutex PathCache::mutex;
+	Thread* PathCache::watchThread = NULL;
+	int PathCache::watchHandle = -1;
+	Map<int, String> PathCache::watchedDirectories;
+	Map<String, int> PathCache::watchIds;
+
+	bool PathCache::isEnabled()
+	{
+		return PathCache::enabled;
+	}
+
+	void PathCache::setEnabled(bool value)
+	{
+		if (!value)
+		{
+			PathCache::_stopWatching();
+		}
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		PathCache::enabled = value;
+		PathCache::stats.clear();
+		PathCache::listings.clear();
+		++PathCache::generation;
+	}
+
+	float PathCache::getTimeToLive()
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		return PathCache::timeToLive;
+	}
+
+	void PathCache::setTimeToLive(float value)
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		PathCache::timeToLive = value;
+	}
+
+	bool PathCache::isWatching()
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		return (PathCache::watchThread != NULL);
+	}
+
+	bool PathCache::setWatching(bool value)
+	{
+		if (!value)
+		{
+			PathCache::_stopWatching();
+			return true;
+		}
+#ifdef __linux__
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		if (PathCache::watchThread == NULL)
+		{
+			PathCache::watchHandle = inotify_init();
+			if (PathCache::watchHandle < 0)
+			{
+				return false;
+			}
+			// entries that were cached before can't be watched anymore
+			PathCache::stats.clear();
+			PathCache::listings.clear();
+			++PathCache::generation;
+			PathCache::watchThread = new Thread(&PathCache::_processChanges, "hltypes path cache");
+			PathCache::watchThread->start();
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	int64_t PathCache::getHits()
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		return PathCache::hits;
+	}
+
+	int64_t PathCache::getMisses()
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		return PathCache::misses;
+	}
+
+	void PathCache::resetCounters()
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		PathCache::hits = 0LL;
+		PathCache::misses = 0LL;
+	}
+
+	void PathCache::invalidate(const String& path)
+	{
+		if (PathCache::enabled)
+		{
+			String name = Dir::normalize(path);
+			Mutex::ScopeLock lock(&PathCache::mutex);
+			PathCache::_invalidate(name, true);
+		}
+	}
+
+	void PathCache::clear()
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		PathCache::stats.clear();
+		PathCache::listings.clear();
+		++PathCache::generation;
+	}
+
+	bool PathCache::_fileExists(const String& name)
+	{
+		if (!PathCache::enabled)
+		{
+			return _platformFileExists(name);
+		}
+		StatEntry entry = PathCache::_getStat(name);
+		return (entry.exists && entry.type == DirEntry::Type::File);
+	}
+
+	bool PathCache::_directoryExists(const String& name)
+	{
+		if (!PathCache::enabled)
+		{
+			return _platformDirectoryExists(name);
+		}
+		StatEntry entry = PathCache::_getStat(name);
+		return (entry.exists && entry.type == DirEntry::Type::Directory);
+	}
+
+	Array<DirEntry> PathCache::_scan(const String& name)
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		Map<String, ListingEntry>::iterator it = PathCache::listings.find(name);
+		if (it != PathCache::listings.end() && !PathCache::_isExpired(it->second.time))
+		{
+			++PathCache::hits;
+			return it->second.entries;
+		}
+		++PathCache::misses;
+		int64_t generation = PathCache::generation;
+		lock.release();
+		ListingEntry entry;
+		entry.time = htickCount();
+		entry.entries = Dir::_scan(name, false);
+		lock.acquire(&PathCache::mutex);
+		if (PathCache::enabled && generation == PathCache::generation)
+		{
+			PathCache::listings[name] = entry;
+			PathCache::_watch(name);
+		}
+		return entry.entries;
+	}
+
+	PathCache::StatEntry PathCache::_getStat(const String& name)
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		Map<String, StatEntry>::iterator it = PathCache::stats.find(name);
+		if (it != PathCache::stats.end() && !PathCache::_isExpired(it->second.time))
+		{
+			++PathCache::hits;
+			return it->second;
+		}
+		++PathCache::misses;
+		int64_t generation = PathCache::generation;
+		lock.release();
+		StatEntry entry;
+		entry.time = htickCount();
+		entry.exists = _platformGetPathType(name, entry.type);
+		lock.acquire(&PathCache::mutex);
+		if (PathCache::enabled && generation == PathCache::generation)
+		{
+			PathCache::stats[name] = entry;
+			PathCache::_watch(Dir::baseDir(name));
+		}
+		return entry;
+	}
+
+	bool PathCache::_isExpired(int64_t time)
+	{
+		return (PathCache::timeToLive > 0.0f && htickCount() - time > (int64_t)(PathCache::timeToLive * 1000.0f));
+	}
+
+	void PathCache::_invalidate(const String& path, bool parent)
+	{
+		PathCache::stats.removeKey(path);
+		PathCache::listings.removeKey(path);
+		// everything below the path is sorted right after the prefix
+		String prefix = path + "/";
+		Map<String, StatEntry>::iterator it = PathCache::stats.lower_bound(prefix);
+		while (it != PathCache::stats.end() && it->first.startsWith(prefix))
+		{
+			PathCache::stats.erase(it++);
+		}
+		Map<String, ListingEntry>::iterator it2 = PathCache::listings.lower_bound(prefix);
+		while (it2 != PathCache::listings.end() && it2->first.startsWith(prefix))
+		{
+			PathCache::listings.erase(it2++);
+		}
+		if (parent)
+		{
+			String baseDir = Dir::baseDir(path);
+			PathCache::listings.removeKey(baseDir);
+			if (baseDir == ".")
+			{
+				PathCache::listings.removeKey("");
+			}
+		}
+		++PathCache::generation;
+	}
+
+	void PathCache::_watch(const String& dirName)
+	{
+#ifdef __linux__
+		String name = (dirName != "" ? dirName : ".");
+		if (PathCache::watchHandle < 0 || PathCache::watchIds.hasKey(name))
+		{
+			return;
+		}
+		int id = inotify_add_watch(PathCache::watchHandle, name.cStr(),
+			IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+		if (id >= 0)
+		{
+			PathCache::watchedDirectories[id] = name;
+			PathCache::watchIds[name] = id;
+		}
+#endif
+	}
+
+	void PathCache::_stopWatching()
+	{
+		Mutex::ScopeLock lock(&PathCache::mutex);
+		Thread* thread = PathCache::watchThread;
+		PathCache::watchThread = NULL;
+		lock.release();
+		if (thread != NULL)
+		{
+			thread->join();
+			delete thread;
+		}
+		lock.acquire(&PathCache::mutex);
+#ifdef __linux__
+		if (PathCache::watchHandle >= 0)
+		{
+			close(PathCache::watchHandle);
+		}
+#endif
+		PathCache::watchHandle = -1;
+		PathCache::watchedDirectories.clear();
+		PathCache::watchIds.clear();
+	}
+
+	void PathCache::_processChanges(Thread* thread)
+	{
+#ifdef __linux__
+		char buffer[WATCH_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+		struct pollfd handle;
+		handle.fd = PathCache::watchHandle;
+		handle.events = POLLIN;
+		int size = 0;
+		struct inotify_event* event = NULL;
+		Map<int, String>::iterator it;
+		Mutex::ScopeLock lock;
+		while (thread->isRunning())
+		{
+			handle.revents = 0;
+			if (poll(&handle, 1, WATCH_POLL_TIMEOUT) <= 0)
+			{
+				continue;
+			}
+			size = (int)read(handle.fd, buffer, WATCH_BUFFER_SIZE);
+			if (size <= 0)
+			{
+				continue;
+			}
+			lock.acquire(&PathCache::mutex);
+			for (char* pointer = buffer; pointer < buffer + size; pointer += sizeof(struct inotify_event) + event->len)
+			{
+				event = (struct inotify_event*)pointer;
+				if ((event->mask & IN_Q_OVERFLOW) != 0)
+				{
+					// changes were lost so nothing can be trusted anymore
+					PathCache::stats.clear();
+					PathCache::listings.clear();
+					++PathCache::generation;
+					continue;
+				}
+				it = PathCache::watchedDirectories.find(event->wd);
+				if (it == PathCache::watchedDirectories.end())
+				{
+					continue;
+				}
+				if (event->len > 0)
+				{
+					PathCache::_invalidate(Dir::normalize(Dir::joinPath(it->second, event->name, false)), true);
+				}
+				if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0)
+				{
+					PathCache::_invalidate(it->second, true);
+				}
+				if ((event->mask & IN_IGNORED) != 0)
+				{
+					PathCache::watchIds.removeKey(it->second);
+					PathCache::watchedDirectories.erase(it);
+				}
+			}
+			lock.release();
+		}
+#endif
+	}
+
+}
@@ -6,6 +6,7 @@
 /// This program is free software; you can redistribute it and/or modify it under
 /// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
 
+#include "hasyncfile.h"
 #include "hdir.h"
 #include "hexception.h"
 #include "hfile.h"
@@ -201,6 +202,18 @@ namespace hltypes
 		this->dataPosition = 0;
 	}
 	
+	FileInfo Resource::info()
+	{
+#ifdef _ZIPRESOURCE
+		if (Resource::zipMounts)
+		{
+			this->_validate();
+			return Resource::hinfo(this->resourceFilename);
+		}
+#endif
+		return FileBase::info();
+	}
+
 	bool Resource::hasZip()
 	{
 #ifdef _ZIPRESOURCE
@@ -219,8 +232,8 @@ namespace hltypes
 			return;
 		}
 #endif
-		// using hinfo, because the default FileBase implementation with _position() and _seek() can cause problems and Resources are always read-only anyway
-		this->dataSize = Resource::hinfo(this->resourceFilename).size;
+		// using the OS information of the open handle, because the default FileBase implementation with _position() and _seek() can cause problems and Resources are always read-only anyway
+		this->dataSize = FileBase::info().size;
 	}
 
 	int Resource::_read(void* buffer, int count)
@@ -228,8 +241,9 @@ namespace hltypes
 #ifdef _ZIPRESOURCE
 		if (Resource::zipMounts)
 		{
-			this->dataPosition += count;
-			return zip::fread(this->cfile, buffer, count);
+			int result = zip::fread(this->cfile, buffer, count);
+			this->dataPosition += result;
+			return result;
 		}
 #endif
 		return this->_fread(buffer, count);
@@ -317,6 +331,11 @@ namespace hltypes
 		return file.read(delimiter);
 	}
 
+	AsyncRequest* Resource::hreadAsync(const String& filename, void (*callback)(AsyncRequest*), void* userData)
+	{
+		return AsyncFile::readResourceAsync(filename, callback, userData);
+	}
+
 	FileInfo Resource::hinfo(const String& filename)
 	{
 #ifdef _ZIPRESOURCE
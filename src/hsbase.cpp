@@ -8,19 +8,43 @@
 
 #include <string.h>
 #include <stdarg.h>
+#include <stdlib.h>
 
 #include "harray.h"
 #include "hexception.h"
 #include "hfbase.h"
+#include "hlinereader.h"
 #include "hlog.h"
+#include "hltypesUtil.h"
 #include "hsbase.h"
 #include "hstream.h"
 #include "hstring.h"
 
 #define BUFFER_SIZE 4096
+#define BOUNCE_BUFFER_SIZE 65536
+#define RAW_CHUNK_SIZE 1073741824
+#define MAX_VARINT_SIZE 10
 
 namespace hltypes
 {
+#ifdef __BIG_ENDIAN__
+	static void _swapBytes(void* data, int64_t count, int elementSize)
+	{
+		unsigned char* bytes = (unsigned char*)data;
+		unsigned char c;
+		for_itert (int64_t, i, 0, count)
+		{
+			for_iter (j, 0, elementSize / 2)
+			{
+				c = bytes[j];
+				bytes[j] = bytes[elementSize - 1 - j];
+				bytes[elementSize - 1 - j] = c;
+			}
+			bytes += elementSize;
+		}
+	}
+
+#endif
 	HL_ENUM_CLASS_DEFINE(StreamBase::SeekMode,
 	(
 		HL_ENUM_DEFINE(StreamBase::SeekMode, Current);
@@ -75,10 +99,11 @@ namespace hltypes
 	{
 		this->_validate();
 		String result;
-		Array<String> parts;
+		int delimiterSize = delimiter.size();
+		int searchStart = 0;
 		int read;
 		int index;
-		char c[BUFFER_SIZE + 1];
+		char c[BUFFER_SIZE];
 		while (!this->eof())
 		{
 			read = this->_read(c, BUFFER_SIZE);
@@ -86,44 +111,47 @@ namespace hltypes
 			{
 				break;
 			}
-			c[read] = '\0';
-			result += c;
-			if (delimiter != "")
+			result.add(c, read);
+			if (delimiterSize > 0)
 			{
-				index = (int)result.indexOf(delimiter);
+				// only the new data and the part of the old data where a delimiter could start is searched
+				index = result.indexOf(delimiter, searchStart);
 				if (index >= 0)
 				{
-					this->_seek(index - result.size() + delimiter.size(), SeekMode::Current);
-					result = result(0, index);
+					this->_seek(index - result.size() + delimiterSize, SeekMode::Current);
+					result = String(result, index);
 					break;
 				}
+				searchStart = hmax(result.size() - delimiterSize + 1, 0);
 			}
 		}
-		result.replace("\r", "");
+		if (result.indexOf('\r') >= 0)
+		{
+			result.replace("\r", "");
+		}
 		return result;
 	}
 	
-	String StreamBase::read(int count)
+	String StreamBase::read(int64_t count)
 	{
 		this->_validate();
 		String result;
 		int current = BUFFER_SIZE;
 		int read;
-		char c[BUFFER_SIZE + 1];
+		char c[BUFFER_SIZE];
 		while (count > 0)
 		{
 			if (count <= BUFFER_SIZE)
 			{
-				current = count;
+				current = (int)count;
 			}
 			read = this->_read(c, current);
 			if (read == 0)
 			{
 				break;
 			}
-			c[read] = '\0';
-			result += String(c);
-			count -= BUFFER_SIZE;
+			result.add(c, read);
+			count -= read;
 		}
 		return result;
 	}
@@ -135,7 +163,37 @@ namespace hltypes
 	
 	Array<String> StreamBase::readLines()
 	{
-		return this->read().split("\n", -1, false);
+		this->_validate();
+		Array<String> result;
+		bool terminated = true;
+		if (this->_position() < this->dataSize)
+		{
+			LineReader reader(this);
+			const char* data = NULL;
+			int size = 0;
+			while (reader.next(data, size))
+			{
+				if (memchr(data, '\r', size) != NULL)
+				{
+					String line(data, size);
+					line.replace("\r", "");
+					result += line;
+				}
+				else
+				{
+					result += String(data, size);
+				}
+			}
+			// same as splitting the whole text, a trailing delimiter produces an empty last line
+			char last = '\0';
+			this->_seek(-1, SeekMode::End);
+			terminated = (this->_read(&last, 1) == 1 && last == '\n');
+		}
+		if (terminated)
+		{
+			result += String();
+		}
+		return result;
 	}
 	
 	void StreamBase::write(const String& text)
@@ -155,7 +213,8 @@ namespace hltypes
 	void StreamBase::writeLine(const String& text)
 	{
 		this->_validate();
-		this->_write((text + "\n").cStr(), text.size() + 1);
+		this->_write(text.cStr(), text.size());
+		this->_write("\n", 1);
 		this->_updateDataSize();
 	}
 	
@@ -173,65 +232,122 @@ namespace hltypes
 		this->write(result);
 	}
 
-	int StreamBase::readRaw(void* buffer, int count)
+	int64_t StreamBase::readRaw(void* buffer, int64_t count)
 	{
 		this->_validate();
-		return this->_read(buffer, count);
+		int64_t result = 0LL;
+		int size = 0;
+		int read = 0;
+		while (result < count)
+		{
+			size = (int)hmin(count - result, (int64_t)RAW_CHUNK_SIZE);
+			read = this->_read((unsigned char*)buffer + result, size);
+			if (read <= 0)
+			{
+				break;
+			}
+			result += read;
+			if (read < size)
+			{
+				break;
+			}
+		}
+		return result;
 	}
 	
-	int StreamBase::writeRaw(void* buffer, int count)
+	int64_t StreamBase::writeRaw(void* buffer, int64_t count)
 	{
 		this->_validate();
-		int result = this->_write(buffer, count);
+		int64_t result = 0LL;
+		int size = 0;
+		int written = 0;
+		while (result < count)
+		{
+			size = (int)hmin(count - result, (int64_t)RAW_CHUNK_SIZE);
+			written = this->_write((unsigned char*)buffer + result, size);
+			if (written <= 0)
+			{
+				break;
+			}
+			result += written;
+			if (written < size)
+			{
+				break;
+			}
+		}
 		this->_updateDataSize();
 		return result;
 	}
 		
-	int StreamBase::writeRaw(StreamBase& stream, int count)
-	{
-		this->_validate();
-		count = (int)hmin((int64_t)count, stream.size() - stream.position());
-		unsigned char* buffer = new unsigned char[count];
-		stream.readRaw(buffer, count);
-		stream.seek(-count);
-		int result = this->_write(buffer, count);
-		delete[] buffer;
-		this->_updateDataSize();
-		return result;
-	}
-
-	int StreamBase::writeRaw(StreamBase& stream)
+	int64_t StreamBase::writeRaw(StreamBase& stream, int64_t count)
 	{
 		this->_validate();
-		int size = (int)(stream.size() - stream.position());
-		if (size > INT_MAX)
+		count = hmin(count, stream.size() - stream.position());
+		if (count <= 0)
 		{
-			Log::errorf(logTag, "Data too large for writing in %s: %d bytes", stream._descriptor().cStr(), size);
 			return 0;
 		}
-		return this->writeRaw(stream, (int)(stream.size() - stream.position()));
+		// not kept between calls so streams don't hold on to the memory for their whole lifetime
+		unsigned char stackBuffer[BUFFER_SIZE];
+		int bufferSize = (int)hmin(count, (int64_t)BOUNCE_BUFFER_SIZE);
+		unsigned char* buffer = NULL;
+		if (bufferSize > BUFFER_SIZE)
+		{
+			buffer = (unsigned char*)malloc(bufferSize);
+		}
+		if (buffer == NULL)
+		{
+			bufferSize = hmin(bufferSize, BUFFER_SIZE);
+		}
+		unsigned char* bounceBuffer = (buffer != NULL ? buffer : stackBuffer);
+		int64_t result = 0LL;
+		int64_t copied = 0LL;
+		int read = 0;
+		int written = 0;
+		while (copied < count)
+		{
+			read = (int)stream.readRaw(bounceBuffer, hmin(count - copied, (int64_t)bufferSize));
+			if (read <= 0)
+			{
+				break;
+			}
+			copied += read;
+			written = this->_write(bounceBuffer, read);
+			result += written;
+			if (written < read)
+			{
+				break;
+			}
+		}
+		if (buffer != NULL)
+		{
+			free(buffer);
+		}
+		stream.seek(-copied);
+		this->_updateDataSize();
+		return result;
 	}
 
-	int StreamBase::writeRaw(Stream& stream, int count)
+	int64_t StreamBase::writeRaw(StreamBase& stream)
 	{
-		this->_validate();
-		int64_t position = stream.position();
-		count = (int)hmin((int64_t)count, stream.size() - position);
-		int result = this->_write(&stream[(int)position], count);
-		this->_updateDataSize();
-		return result;
+		return this->writeRaw(stream, stream.size() - stream.position());
 	}
 
-	int StreamBase::writeRaw(Stream& stream)
+	int64_t StreamBase::writeRaw(Stream& stream, int64_t count)
 	{
 		this->_validate();
-		int size = (int)(stream.size() - stream.position());
-		if (size > INT_MAX)
+		int64_t position = stream.position();
+		count = hmin(count, stream.size() - position);
+		if (count <= 0)
 		{
-			Log::errorf(logTag, "Data too large for writing in %s: %d bytes", stream._descriptor().cStr(), size);
 			return 0;
 		}
-		return this->writeRaw(stream, (int)(stream.size() - stream.position()));
+		return this->writeRaw((void*)&stream[position], count);
+	}
+
+	int64_t StreamBase::writeRaw(Stream& stream)
+	{
+		return this->writeRaw(stream, stream.size() - stream.position());
 	}
 
 	void StreamBase::_updateDataSize()
@@ -376,6 +492,66 @@ namespace hltypes
 		this->dump(String(c));
 	}
 
+	void StreamBase::dumpVarint(uint64_t value)
+	{
+		this->_validate();
+		unsigned char bytes[MAX_VARINT_SIZE];
+		int size = 0;
+		while (value >= 0x80)
+		{
+			bytes[size] = (unsigned char)(value | 0x80);
+			value >>= 7;
+			++size;
+		}
+		bytes[size] = (unsigned char)value;
+		this->_write(bytes, size + 1);
+		this->_updateDataSize();
+	}
+
+	void StreamBase::dumpSignedVarint(int64_t value)
+	{
+		this->dumpVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+	}
+
+	void StreamBase::dumpCompactString(const String& string)
+	{
+		this->_validate();
+		int size = string.size();
+		this->dumpVarint((uint64_t)size);
+		if (size > 0)
+		{
+			this->_write(string.cStr(), size);
+			this->_updateDataSize();
+		}
+	}
+
+	void StreamBase::dumpBitfield(const bool* values, int count)
+	{
+		this->_validate();
+		if (count <= 0)
+		{
+			return;
+		}
+		unsigned char buffer[BUFFER_SIZE];
+		int index = 0;
+		while (index < count)
+		{
+			int currentCount = hmin(count - index, BUFFER_SIZE * 8);
+			int size = (currentCount + 7) / 8;
+			memset(buffer, 0, size);
+			for_iter (i, 0, currentCount)
+			{
+				if (values[index + i])
+				{
+					buffer[i >> 3] |= (unsigned char)(1 << (i & 7));
+				}
+			}
+			this->_write(buffer, size);
+			index += currentCount;
+		}
+		this->_updateDataSize();
+	}
+
 	char StreamBase::loadInt8()
 	{
 		return (char)this->loadUint8();
@@ -499,6 +675,222 @@ namespace hltypes
 		return this->read(this->loadInt32());
 	}
 
+	uint64_t StreamBase::loadVarint()
+	{
+		this->_validate();
+		uint64_t result = 0ULL;
+		unsigned char c = 0;
+		for (int shift = 0; shift < MAX_VARINT_SIZE * 7; shift += 7)
+		{
+			if (this->_read(&c, 1) < 1)
+			{
+				throw Exception("Varint in " + this->_descriptor() + " is truncated!");
+			}
+			result |= (uint64_t)(c & 0x7F) << shift;
+			if ((c & 0x80) == 0)
+			{
+				return result;
+			}
+		}
+		throw Exception("Varint in " + this->_descriptor() + " is longer than " + String(MAX_VARINT_SIZE) + " bytes!");
+	}
+
+	int64_t StreamBase::loadSignedVarint()
+	{
+		uint64_t value = this->loadVarint();
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	}
+
+	String StreamBase::loadCompactString()
+	{
+		this->_validate();
+		uint64_t size = this->loadVarint();
+		if (size > (uint64_t)INT_MAX)
+		{
+			Log::errorf(logTag, "String too large for reading in %s: %s bytes", this->_descriptor().cStr(), String(size).cStr());
+			return "";
+		}
+		return this->read((int)size);
+	}
+
+	int StreamBase::loadBitfield(bool* values, int count)
+	{
+		this->_validate();
+		if (count <= 0)
+		{
+			return 0;
+		}
+		unsigned char buffer[BUFFER_SIZE];
+		int index = 0;
+		while (index < count)
+		{
+			int currentCount = hmin(count - index, BUFFER_SIZE * 8);
+			int size = (currentCount + 7) / 8;
+			int read = this->_read(buffer, size);
+			currentCount = hmin(currentCount, read * 8);
+			for_iter (i, 0, currentCount)
+			{
+				values[index + i] = ((buffer[i >> 3] & (1 << (i & 7))) != 0);
+			}
+			index += currentCount;
+			if (read < size)
+			{
+				break;
+			}
+		}
+		return index;
+	}
+
+	int64_t StreamBase::dumpArray(const char* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(char));
+	}
+
+	int64_t StreamBase::dumpArray(const unsigned char* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(unsigned char));
+	}
+
+	int64_t StreamBase::dumpArray(const short* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(short));
+	}
+
+	int64_t StreamBase::dumpArray(const unsigned short* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(unsigned short));
+	}
+
+	int64_t StreamBase::dumpArray(const int* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(int));
+	}
+
+	int64_t StreamBase::dumpArray(const unsigned int* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(unsigned int));
+	}
+
+	int64_t StreamBase::dumpArray(const int64_t* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(int64_t));
+	}
+
+	int64_t StreamBase::dumpArray(const uint64_t* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(uint64_t));
+	}
+
+	int64_t StreamBase::dumpArray(const float* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(float));
+	}
+
+	int64_t StreamBase::dumpArray(const double* data, int64_t count)
+	{
+		return this->_dumpArray(data, count, (int)sizeof(double));
+	}
+
+	int64_t StreamBase::loadArray(char* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(char));
+	}
+
+	int64_t StreamBase::loadArray(unsigned char* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(unsigned char));
+	}
+
+	int64_t StreamBase::loadArray(short* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(short));
+	}
+
+	int64_t StreamBase::loadArray(unsigned short* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(unsigned short));
+	}
+
+	int64_t StreamBase::loadArray(int* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(int));
+	}
+
+	int64_t StreamBase::loadArray(unsigned int* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(unsigned int));
+	}
+
+	int64_t StreamBase::loadArray(int64_t* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(int64_t));
+	}
+
+	int64_t StreamBase::loadArray(uint64_t* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(uint64_t));
+	}
+
+	int64_t StreamBase::loadArray(float* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(float));
+	}
+
+	int64_t StreamBase::loadArray(double* data, int64_t count)
+	{
+		return this->_loadArray(data, count, (int)sizeof(double));
+	}
+
+	int64_t StreamBase::_dumpArray(const void* data, int64_t count, int elementSize)
+	{
+		this->_validate();
+		if (count <= 0)
+		{
+			return 0LL;
+		}
+#ifndef __BIG_ENDIAN__
+		return (this->writeRaw((void*)data, count * elementSize) / elementSize);
+#else
+		if (elementSize == 1)
+		{
+			return this->writeRaw((void*)data, count);
+		}
+		// swapped in blocks on the stack so the caller's data stays unchanged
+		int64_t result = 0LL;
+		unsigned char buffer[BUFFER_SIZE];
+		int blockCount = BUFFER_SIZE / elementSize;
+		const unsigned char* current = (const unsigned char*)data;
+		while (result < count)
+		{
+			int currentCount = (int)hmin(count - result, (int64_t)blockCount);
+			memcpy(buffer, current, currentCount * elementSize);
+			_swapBytes(buffer, currentCount, elementSize);
+			int written = (int)(this->writeRaw(buffer, currentCount * elementSize) / elementSize);
+			result += written;
+			if (written < currentCount)
+			{
+				break;
+			}
+			current += currentCount * elementSize;
+		}
+		return result;
+#endif
+	}
+
+	int64_t StreamBase::_loadArray(void* data, int64_t count, int elementSize)
+	{
+		this->_validate();
+		if (count <= 0)
+		{
+			return 0LL;
+		}
+		int64_t result = this->readRaw(data, count * elementSize) / elementSize;
+#ifdef __BIG_ENDIAN__
+		_swapBytes(data, result, elementSize);
+#endif
+		return result;
+	}
+
 	StreamBase::StreamBase(const StreamBase& other)
 	{
 		throw ObjectCannotCopyException("hltypes::StreamBase");
@@ -0,0 +1,261 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "harray.h"
+#include "hexception.h"
+#include "hltypesUtil.h"
+#include "hsegmentedstream.h"
+#include "hstream.h"
+
+#define MIN_SEGMENT_SIZE 64
+
+namespace hltypes
+{
+	SegmentedStream::SegmentedStream(int segmentSize) : StreamBase(), streamPosition(0LL)
+	{
+		this->segmentSize = hmax(segmentSize, MIN_SEGMENT_SIZE);
+	}
+
+	SegmentedStream::~SegmentedStream()
+	{
+		this->clear();
+	}
+
+	SegmentedStream::SegmentedStream(const SegmentedStream& other)
+	{
+		throw ObjectCannotCopyException("hltypes::SegmentedStream");
+	}
+
+	SegmentedStream& SegmentedStream::operator=(SegmentedStream& other)
+	{
+		throw ObjectCannotAssignException("hltypes::SegmentedStream");
+		return (*this);
+	}
+
+	int SegmentedStream::getSegmentDataSize(int index) const
+	{
+		return (int)hclamp(this->dataSize - (int64_t)index * this->segmentSize, (int64_t)0, (int64_t)this->segmentSize);
+	}
+
+	void SegmentedStream::clear()
+	{
+		foreach (unsigned char*, it, this->segments)
+		{
+			free(*it);
+		}
+		this->segments.clear();
+		this->dataSize = 0LL;
+		this->streamPosition = 0LL;
+	}
+
+	bool SegmentedStream::truncate(int64_t targetSize)
+	{
+		if (targetSize >= this->dataSize)
+		{
+			return false;
+		}
+		this->dataSize = hmax(targetSize, (int64_t)0);
+		this->streamPosition = hmin(this->streamPosition, this->dataSize);
+		this->_releaseSegments();
+		return true;
+	}
+
+	void SegmentedStream::flatten(unsigned char* output) const
+	{
+		int size = 0;
+		for_iter (i, 0, this->segments.size())
+		{
+			size = this->getSegmentDataSize(i);
+			memcpy(output, this->segments[i], size);
+			output += size;
+		}
+	}
+
+	bool SegmentedStream::flatten(Stream& output) const
+	{
+		// a capacity that was reserved by the caller is never reduced
+		int64_t required = output.position() + this->dataSize;
+		if (required > output.getCapacity() && !output.setCapacity(required))
+		{
+			return false;
+		}
+		for_iter (i, 0, this->segments.size())
+		{
+			output.writeRaw(this->segments[i], this->getSegmentDataSize(i));
+		}
+		return true;
+	}
+
+	int64_t SegmentedStream::writeRaw(void* buffer, int64_t count)
+	{
+		return StreamBase::writeRaw(buffer, count);
+	}
+
+	int64_t SegmentedStream::writeRaw(StreamBase& stream, int64_t count)
+	{
+		this->_validate();
+		count = hmin(count, stream.size() - stream.position());
+		if (count <= 0)
+		{
+			return 0;
+		}
+		if (!this->_reserveSegments(this->streamPosition + count))
+		{
+			this->_releaseSegments();
+			return 0;
+		}
+		int64_t result = 0;
+		int read = 0;
+		int offset = 0;
+		int size = 0;
+		while (result < count)
+		{
+			offset = (int)(this->streamPosition % this->segmentSize);
+			size = (int)hmin(count - result, (int64_t)(this->segmentSize - offset));
+			read = (int)stream.readRaw(&this->segments[(int)(this->streamPosition / this->segmentSize)][offset], size);
+			if (read <= 0)
+			{
+				break;
+			}
+			result += read;
+			this->streamPosition += read;
+			this->dataSize = hmax(this->dataSize, this->streamPosition);
+		}
+		// segments were reserved for the whole count, but the stream may have ended earlier
+		this->_releaseSegments();
+		stream.seek(-result);
+		return result;
+	}
+
+	int64_t SegmentedStream::writeRaw(StreamBase& stream)
+	{
+		return StreamBase::writeRaw(stream);
+	}
+
+	int64_t SegmentedStream::writeRaw(Stream& stream, int64_t count)
+	{
+		return StreamBase::writeRaw(stream, count);
+	}
+
+	int64_t SegmentedStream::writeRaw(Stream& stream)
+	{
+		return StreamBase::writeRaw(stream);
+	}
+
+	void SegmentedStream::_updateDataSize()
+	{
+	}
+
+	bool SegmentedStream::_reserveSegments(int64_t size)
+	{
+		int count = (int)((size + this->segmentSize - 1) / this->segmentSize);
+		unsigned char* segment = NULL;
+		while (this->segments.size() < count)
+		{
+			// malloc() doesn't zero-fill so untouched pages aren't committed before they are written
+			segment = (unsigned char*)malloc(this->segmentSize);
+			if (segment == NULL)
+			{
+				return false;
+			}
+			this->segments.add(segment);
+		}
+		return true;
+	}
+
+	void SegmentedStream::_releaseSegments()
+	{
+		int count = (int)((this->dataSize + this->segmentSize - 1) / this->segmentSize);
+		for_iter (i, count, this->segments.size())
+		{
+			free(this->segments[i]);
+		}
+		if (count < this->segments.size())
+		{
+			this->segments.removeAt(count, this->segments.size() - count);
+		}
+	}
+
+	int SegmentedStream::_read(void* buffer, int count)
+	{
+		int readSize = (int)hclamp((int64_t)count, (int64_t)0, this->dataSize - this->streamPosition);
+		unsigned char* destination = (unsigned char*)buffer;
+		int offset = 0;
+		int size = 0;
+		int remaining = readSize;
+		while (remaining > 0)
+		{
+			offset = (int)(this->streamPosition % this->segmentSize);
+			size = hmin(remaining, this->segmentSize - offset);
+			memcpy(destination, &this->segments[(int)(this->streamPosition / this->segmentSize)][offset], size);
+			destination += size;
+			remaining -= size;
+			this->streamPosition += size;
+		}
+		return readSize;
+	}
+
+	int SegmentedStream::_write(const void* buffer, int count)
+	{
+		if (count <= 0)
+		{
+			return 0;
+		}
+		if (!this->_reserveSegments(this->streamPosition + count))
+		{
+			this->_releaseSegments();
+			return 0;
+		}
+		const unsigned char* source = (const unsigned char*)buffer;
+		int offset = 0;
+		int size = 0;
+		int remaining = count;
+		while (remaining > 0)
+		{
+			offset = (int)(this->streamPosition % this->segmentSize);
+			size = hmin(remaining, this->segmentSize - offset);
+			memcpy(&this->segments[(int)(this->streamPosition / this->segmentSize)][offset], source, size);
+			source += size;
+			remaining -= size;
+			this->streamPosition += size;
+		}
+		this->dataSize = hmax(this->dataSize, this->streamPosition);
+		return count;
+	}
+
+	bool SegmentedStream::_isOpen() const
+	{
+		return true;
+	}
+
+	int64_t SegmentedStream::_position() const
+	{
+		return this->streamPosition;
+	}
+
+	bool SegmentedStream::_seek(int64_t offset, SeekMode seekMode)
+	{
+		if (seekMode == SeekMode::Current)
+		{
+			this->streamPosition = hclamp(this->streamPosition + offset, (int64_t)0, this->dataSize);
+		}
+		else if (seekMode == SeekMode::Start)
+		{
+			this->streamPosition = hclamp(offset, (int64_t)0, this->dataSize);
+		}
+		else if (seekMode == SeekMode::End)
+		{
+			this->streamPosition = hclamp(this->dataSize + offset, (int64_t)0, this->dataSize);
+		}
+		return true;
+	}
+
+}
@@ -10,6 +10,7 @@
 #include <semaphore.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <unistd.h>
 #endif
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,19 +27,14 @@ namespace hltypes
 	{
 		this->maxCount = maxCount;
 		this->name = name;
-#ifdef _WIN32
-#ifndef _WINRT // WinXP does not have CreateSemaphoreEx()
-		this->handle = CreateSemaphoreW(NULL, this->maxCount, this->maxCount, L""); // this->name is NOT a system name!
-#else
-		this->handle = CreateSemaphoreExW(NULL, this->maxCount, this->maxCount, L"", 0, 0); // this->name is NOT a system name!
-#endif
-#else
-		this->handle = sem_open(this->name.cStr(), O_CREAT|O_EXCL, this->maxCount);
-		if (this->handle == SEM_FAILED)
-		{
-			Log::writef("semaphore", "Error creating POSIX semaphore '%s'! errno = %s", this->name.cStr(), String(strerror(errno)).cStr());
-		}
-#endif
+		this->_create(this->maxCount);
+	}
+
+	Semaphore::Semaphore(int maxCount, int initialCount, const String& name) : handle(NULL)
+	{
+		this->maxCount = maxCount;
+		this->name = name;
+		this->_create(hclamp(initialCount, 0, this->maxCount));
 	}
 
 	Semaphore::~Semaphore()
@@ -68,6 +64,29 @@ namespace hltypes
 #endif
 	}
 	
+	void Semaphore::_create(int initialCount)
+	{
+#ifdef _WIN32
+#ifndef _WINRT // WinXP does not have CreateSemaphoreEx()
+		this->handle = CreateSemaphoreW(NULL, initialCount, this->maxCount, L""); // this->name is NOT a system name!
+#else
+		this->handle = CreateSemaphoreExW(NULL, initialCount, this->maxCount, L"", 0, 0); // this->name is NOT a system name!
+#endif
+#else
+		// this->name is NOT a system name either, the system name only has to be unique until it's unlinked right away
+		String systemName = hsprintf("/hltypes_%d_%p", (int)getpid(), this);
+		this->handle = sem_open(systemName.cStr(), O_CREAT | O_EXCL, 0600, (unsigned int)initialCount);
+		if (this->handle == SEM_FAILED)
+		{
+			Log::writef("semaphore", "Error creating POSIX semaphore '%s'! errno = %s", this->name.cStr(), String(strerror(errno)).cStr());
+		}
+		else
+		{
+			sem_unlink(systemName.cStr());
+		}
+#endif
+	}
+
 	Semaphore::Semaphore(const Semaphore& other)
 	{
 		throw ObjectCannotCopyException("hltypes::Semaphore");
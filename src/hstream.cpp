@@ -18,26 +18,26 @@
 
 namespace hltypes
 {
-	Stream::Stream(int initialCapacity) : StreamBase()
+	Stream::Stream(int64_t initialCapacity) : StreamBase()
 	{
-        initialCapacity = hmax(MIN_HSTREAM_CAPACITY, initialCapacity);
-		this->capacity = (int64_t)initialCapacity;
+        initialCapacity = hmax((int64_t)MIN_HSTREAM_CAPACITY, initialCapacity);
+		this->capacity = initialCapacity;
 		this->streamSize = 0;
 		this->streamPosition = 0;
 		// using malloc because realloc is used later
-        this->stream = (unsigned char*)malloc((int)this->capacity);
+        this->stream = (unsigned char*)malloc((size_t)this->capacity);
 	}
 
-	Stream::Stream(unsigned char* initialData, int initialDataSize) : StreamBase()
+	Stream::Stream(unsigned char* initialData, int64_t initialDataSize) : StreamBase()
 	{
-		this->capacity = (int64_t)initialDataSize;
-		this->streamSize = (int64_t)initialDataSize;
+		this->capacity = initialDataSize;
+		this->streamSize = initialDataSize;
 		this->streamPosition = 0;
 		// using malloc because realloc is used later
 		if (initialDataSize > 0)
 		{
-            this->stream = (unsigned char*)malloc((int)this->capacity);
-			memcpy(this->stream, initialData, initialDataSize);
+            this->stream = (unsigned char*)malloc((size_t)this->capacity);
+			memcpy(this->stream, initialData, (size_t)initialDataSize);
 		}
         else
         {
@@ -47,16 +47,16 @@ namespace hltypes
 		this->_updateDataSize();
 	}
 
-	Stream::Stream(unsigned char* initialData, int initialDataSize, int initialCapacity) : StreamBase()
+	Stream::Stream(unsigned char* initialData, int64_t initialDataSize, int64_t initialCapacity) : StreamBase()
 	{
-		this->capacity = (int64_t)hmax(initialCapacity, initialDataSize);
-		this->streamSize = (int64_t)initialDataSize;
+		this->capacity = hmax(initialCapacity, initialDataSize);
+		this->streamSize = initialDataSize;
 		this->streamPosition = 0;
 		// using malloc because realloc is used later
 		if (initialDataSize > 0)
 		{
-            this->stream = (unsigned char*)malloc((int)this->capacity);
-			memcpy(this->stream, initialData, initialDataSize);
+            this->stream = (unsigned char*)malloc((size_t)this->capacity);
+			memcpy(this->stream, initialData, (size_t)initialDataSize);
 		}
         else
         {
@@ -75,8 +75,8 @@ namespace hltypes
 		// using malloc because realloc is used later
 		if (this->streamSize > 0LL)
 		{
-            this->stream = (unsigned char*)malloc((int)this->capacity);
-			memcpy(this->stream, (unsigned char*)other, (int)this->streamSize);
+            this->stream = (unsigned char*)malloc((size_t)this->capacity);
+			memcpy(this->stream, (unsigned char*)other, (size_t)this->streamSize);
 		}
         else
         {
@@ -86,6 +86,19 @@ namespace hltypes
 		this->_updateDataSize();
 	}
 
+#ifdef HL_RVALUE_REFERENCES
+	Stream::Stream(Stream&& other) : StreamBase()
+	{
+		this->stream = other.stream;
+		this->capacity = other.capacity;
+		this->streamSize = other.streamSize;
+		this->streamPosition = other.streamPosition;
+		this->_updateDataSize();
+		other.stream = NULL;
+		other.adopt(NULL, 0);
+	}
+
+#endif
 	Stream::~Stream()
 	{
 		if (this->stream != NULL)
@@ -95,7 +108,7 @@ namespace hltypes
 		}
 	}
 	
-	void Stream::clear(int newCapacity)
+	void Stream::clear(int64_t newCapacity)
 	{
 		this->streamSize = 0;
 		this->streamPosition = 0;
@@ -103,12 +116,49 @@ namespace hltypes
 		this->_updateDataSize();
 	}
 	
-	bool Stream::setCapacity(int newCapacity)
+	void Stream::adopt(unsigned char* data, int64_t size, int64_t capacity)
+	{
+		if (this->stream != NULL)
+		{
+			free(this->stream);
+		}
+		if (data == NULL)
+		{
+			size = 0;
+			capacity = MIN_HSTREAM_CAPACITY;
+			data = (unsigned char*)malloc(MIN_HSTREAM_CAPACITY);
+		}
+		this->stream = data;
+		this->streamSize = hmax(size, (int64_t)0);
+		this->capacity = hmax(capacity, size);
+		this->streamPosition = 0;
+		this->_updateDataSize();
+	}
+
+	unsigned char* Stream::release()
+	{
+		unsigned char* result = this->stream;
+		this->stream = NULL;
+		this->adopt(NULL, 0);
+		return result;
+	}
+
+	void Stream::swap(Stream& other)
+	{
+		hswap(this->stream, other.stream);
+		hswap(this->capacity, other.capacity);
+		hswap(this->streamSize, other.streamSize);
+		hswap(this->streamPosition, other.streamPosition);
+		this->_updateDataSize();
+		other._updateDataSize();
+	}
+
+	bool Stream::setCapacity(int64_t newCapacity)
 	{
-		newCapacity = hmax(MIN_HSTREAM_CAPACITY, newCapacity); // not allowing less than MIN_HSTREAM_CAPACITY bytes
+		newCapacity = hmax((int64_t)MIN_HSTREAM_CAPACITY, newCapacity); // not allowing less than MIN_HSTREAM_CAPACITY bytes
 		if (this->capacity != newCapacity)
 		{
-			unsigned char* newStream = (unsigned char*)realloc(this->stream, newCapacity);
+			unsigned char* newStream = (unsigned char*)realloc(this->stream, (size_t)newCapacity);
 			if (newStream == NULL) // could not reallocate enough memory
 			{
 				return false;
@@ -124,21 +174,21 @@ namespace hltypes
 		return true;
 	}
 
-	int Stream::writeRaw(void* buffer, int count)
+	int64_t Stream::writeRaw(void* buffer, int64_t count)
 	{
 		return StreamBase::writeRaw(buffer, count);
 	}
 
-	int Stream::writeRaw(StreamBase& stream, int count)
+	int64_t Stream::writeRaw(StreamBase& stream, int64_t count)
 	{
 		this->_validate();
-		int result = 0;
+		int64_t result = 0;
 		if (count > 0)
 		{
 			this->_tryIncreaseCapacity(count);
 			if (count > 0)
 			{
-				result = stream.readRaw(&this->stream[(int)this->streamPosition], count);
+				result = stream.readRaw(&this->stream[this->streamPosition], count);
 				if (result > 0)
 				{
 					stream.seek(-result);
@@ -154,25 +204,25 @@ namespace hltypes
 		return result;
 	}
 
-	int Stream::writeRaw(StreamBase& stream)
+	int64_t Stream::writeRaw(StreamBase& stream)
 	{
 		return StreamBase::writeRaw(stream);
 	}
 
-	int Stream::writeRaw(Stream& stream, int count)
+	int64_t Stream::writeRaw(Stream& stream, int64_t count)
 	{
 		return StreamBase::writeRaw(stream, count);
 	}
 
-	int Stream::writeRaw(Stream& stream)
+	int64_t Stream::writeRaw(Stream& stream)
 	{
 		return StreamBase::writeRaw(stream);
 	}
 
-	int Stream::prepareManualWriteRaw(int count)
+	int64_t Stream::prepareManualWriteRaw(int64_t count)
 	{
 		this->_validate();
-		int result = 0;
+		int64_t result = 0;
 		if (count > 0)
 		{
 			this->_tryIncreaseCapacity(count);
@@ -189,16 +239,16 @@ namespace hltypes
 		return result;
 	}
 
-	int Stream::fill(unsigned char value, int count)
+	int64_t Stream::fill(unsigned char value, int64_t count)
 	{
 		this->_validate();
-		int result = 0;
+		int64_t result = 0;
 		if (count > 0)
 		{
 			this->_tryIncreaseCapacity(count);
 			if (count > 0)
 			{
-				memset(&this->stream[(int)this->streamPosition], value, count);
+				memset(&this->stream[this->streamPosition], value, (size_t)count);
 				result = count;
 				this->streamPosition += count;
 				if (this->streamSize < this->streamPosition)
@@ -225,10 +275,15 @@ namespace hltypes
 	}
 
 	const unsigned char& Stream::operator[](int index) const
+	{
+		return this->operator[]((int64_t)index);
+	}
+
+	const unsigned char& Stream::operator[](int64_t index) const
 	{
 		if (index < 0)
 		{
-			index = (int)((int64_t)index + this->streamSize);
+			index += this->streamSize;
 		}
 		return this->stream[index];
 	}
@@ -238,13 +293,13 @@ namespace hltypes
         int64_t otherDataSize = other.dataSize;
 		this->streamSize = other.streamSize;
 		this->streamPosition = other.streamPosition;
-		this->setCapacity((int)other.capacity);
+		this->setCapacity(other.capacity);
 		// using malloc because realloc is used later
 		if (otherDataSize > 0)
 		{
             if (this->capacity >= otherDataSize)
             {
-                memcpy(this->stream, (unsigned char*)other.stream, (int)otherDataSize);
+                memcpy(this->stream, (unsigned char*)other.stream, (size_t)otherDataSize);
             }
             else
             {
@@ -255,6 +310,18 @@ namespace hltypes
 		return (*this);
 	}
 
+#ifdef HL_RVALUE_REFERENCES
+	Stream& Stream::operator=(Stream&& other)
+	{
+		if (this != &other)
+		{
+			this->swap(other);
+			free(other.release());
+		}
+		return (*this);
+	}
+
+#endif
 	Stream::operator char*() const
 	{
 		return (char*)&this->stream[0];
@@ -294,13 +361,14 @@ namespace hltypes
 	int Stream::_write(const void* buffer, int count)
 	{
 		int result = 0;
-		if (count > 0)
+		int64_t size = (int64_t)count;
+		if (size > 0)
 		{
-			this->_tryIncreaseCapacity(count);
-			if (count > 0)
+			this->_tryIncreaseCapacity(size);
+			if (size > 0)
 			{
-				memcpy(&this->stream[(int)this->streamPosition], buffer, count);
-				result = count;
+				memcpy(&this->stream[this->streamPosition], buffer, (size_t)size);
+				result = (int)size;
 				this->streamPosition += result;
 				this->streamSize = hmax(this->streamSize, this->streamPosition);
 			}
@@ -335,12 +403,12 @@ namespace hltypes
 		return true;
 	}
 	
-	bool Stream::_tryIncreaseCapacity(int& write_size)
+	bool Stream::_tryIncreaseCapacity(int64_t& write_size)
 	{
-		if (write_size > this->capacity - this->streamPosition && !this->setCapacity(hpotCeil((int)(write_size + this->streamPosition))))
+		if (write_size > this->capacity - this->streamPosition && !this->setCapacity(hpotCeil(write_size + this->streamPosition)))
 		{
 			// could not reallocate enough memory, reduce write_size
-			write_size = (int)hmax(this->capacity - this->streamPosition, 0LL);
+			write_size = hmax(this->capacity - this->streamPosition, 0LL);
 			return false;
 		}
 		return true;
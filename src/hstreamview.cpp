@@ -0,0 +1,100 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <string.h>
+
+#include "hexception.h"
+#include "hltypesUtil.h"
+#include "hstream.h"
+#include "hstreamview.h"
+
+namespace hltypes
+{
+	StreamView::StreamView(const unsigned char* data, int64_t size) : StreamBase(), data(data), streamPosition(0LL)
+	{
+		this->dataSize = hmax(size, (int64_t)0);
+	}
+
+	StreamView::StreamView(const Stream& stream) : StreamBase(), data((const unsigned char*)stream), streamPosition(0LL)
+	{
+		this->dataSize = stream.size();
+	}
+
+	StreamView::~StreamView()
+	{
+	}
+
+	StreamView::StreamView(const StreamView& other)
+	{
+		throw ObjectCannotCopyException("hltypes::StreamView");
+	}
+
+	StreamView& StreamView::operator=(StreamView& other)
+	{
+		throw ObjectCannotAssignException("hltypes::StreamView");
+		return (*this);
+	}
+
+	const unsigned char& StreamView::operator[](int index) const
+	{
+		if (index < 0)
+		{
+			index = (int)((int64_t)index + this->dataSize);
+		}
+		return this->data[index];
+	}
+
+	void StreamView::_updateDataSize()
+	{
+	}
+
+	int StreamView::_read(void* buffer, int count)
+	{
+		int readSize = (int)hclamp((int64_t)count, (int64_t)0, this->dataSize - this->streamPosition);
+		if (readSize > 0)
+		{
+			memcpy(buffer, &this->data[this->streamPosition], readSize);
+			this->streamPosition += readSize;
+		}
+		return readSize;
+	}
+
+	int StreamView::_write(const void*, int)
+	{
+		throw FileNotWriteableException(this->_descriptor());
+		return 0;
+	}
+
+	bool StreamView::_isOpen() const
+	{
+		return true;
+	}
+
+	int64_t StreamView::_position() const
+	{
+		return this->streamPosition;
+	}
+
+	bool StreamView::_seek(int64_t offset, SeekMode seekMode)
+	{
+		if (seekMode == SeekMode::Current)
+		{
+			this->streamPosition = hclamp(this->streamPosition + offset, (int64_t)0, this->dataSize);
+		}
+		else if (seekMode == SeekMode::Start)
+		{
+			this->streamPosition = hclamp(offset, (int64_t)0, this->dataSize);
+		}
+		else if (seekMode == SeekMode::End)
+		{
+			this->streamPosition = hclamp(this->dataSize + offset, (int64_t)0, this->dataSize);
+		}
+		return true;
+	}
+
+}
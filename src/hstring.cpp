@@ -14,6 +14,7 @@
 #include <string.h>
 
 #include "harray.h"
+#include "hencoding.h"
 #include "hexception.h"
 #include "hlog.h"
 #include "hltypesUtil.h"
@@ -23,6 +24,7 @@
 
 #define FORMAT_BUFFER_SIZE 16
 #define FORMATTING_STRING_BUFFER_SIZE 64
+#define HVSPRINTF_BUFFER_SIZE 512
 
 #define BOOL_TO_STRING(b) ((b) ? "true" : "false")
 
@@ -145,7 +147,7 @@ namespace hltypes
 	{
 	}
 
-	String::String(const String& string) : stdstr(string.c_str())
+	String::String(const String& string) : stdstr(string)
 	{
 	}
 
@@ -1086,29 +1088,43 @@ namespace hltypes
 
 	bool String::startsWith(const char* string) const
 	{
-		return (strncmp(stdstr::c_str(), string, strlen(string)) == 0);
+		// single pass, the end of the other string is found while comparing
+		const char* cString = stdstr::data();
+		int thisLength = (int)stdstr::size();
+		for (int i = 0; string[i] != '\0'; ++i)
+		{
+			if (i >= thisLength || cString[i] != string[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool String::startsWith(const char* string, int length) const
+	{
+		return (length <= (int)stdstr::size() && memcmp(stdstr::data(), string, length) == 0);
 	}
 
 	bool String::startsWith(const String& string) const
 	{
-		return this->startsWith(string.c_str());
+		return this->startsWith(string.data(), (int)string.stdstr::size());
 	}
 
 	bool String::endsWith(const char* string) const
 	{
-		const char* cString = stdstr::c_str();
-		int thisLength = this->size();
-		int stringLength = (int)strlen(string);
-		if (stringLength > thisLength)
-		{
-			return false;
-		}
-		return (strcmp(cString + thisLength - stringLength, string) == 0);
+		return this->endsWith(string, (int)strlen(string));
+	}
+
+	bool String::endsWith(const char* string, int length) const
+	{
+		int thisLength = (int)stdstr::size();
+		return (length <= thisLength && memcmp(stdstr::data() + thisLength - length, string, length) == 0);
 	}
 
 	bool String::endsWith(const String& string) const
 	{
-		return this->endsWith(string.c_str());
+		return this->endsWith(string.data(), (int)string.stdstr::size());
 	}
 
 	bool String::contains(const char c) const
@@ -1384,27 +1400,53 @@ namespace hltypes
 		}
 		return result;
 	}
-	
-	String String::toHex() const
+
+	unsigned int String::hash() const
 	{
-		String result;
+		const unsigned char* string = (const unsigned char*)stdstr::data();
 		int size = (int)stdstr::size();
-		result.reserve(size * 2);
+		unsigned int result = 2166136261U;
 		for_iter (i, 0, size)
 		{
-			result.append(hsprintf("%02X", stdstr::at(i)));
+			result = (result ^ string[i]) * 16777619U;
 		}
 		return result;
 	}
+	
+	String String::toHex() const
+	{
+		return hhexEncode(*this);
+	}
 
 	unsigned int String::unhex() const
 	{
-		unsigned int i = 0;
-		if (this->isHex())
+		const char* string = stdstr::c_str();
+		if (string[0] == '\0')
 		{
-			sscanf(this->uppered().c_str(), "%X", &i);
+			return 0;
 		}
-		return i;
+		unsigned int result = 0;
+		for (int i = 0; string[i] != '\0'; ++i)
+		{
+			char c = string[i];
+			if (c >= '0' && c <= '9')
+			{
+				result = (result << 4) | (unsigned int)(c - '0');
+			}
+			else if (c >= 'A' && c <= 'F')
+			{
+				result = (result << 4) | (unsigned int)(c - 'A' + 10);
+			}
+			else if (c >= 'a' && c <= 'f')
+			{
+				result = (result << 4) | (unsigned int)(c - 'a' + 10);
+			}
+			else
+			{
+				return 0;
+			}
+		}
+		return result;
 	}
 
 	String String::operator()(int index) const
@@ -1507,7 +1549,7 @@ namespace hltypes
 
 	String String::operator=(const String& string)
 	{
-		stdstr::assign(string.c_str());
+		stdstr::assign(string);
 		return *this;
 	}
 
@@ -1662,12 +1704,23 @@ namespace hltypes
 
 	bool String::operator==(const char* string) const
 	{
-		return (strcmp(stdstr::c_str(), string) == 0);
+		// single pass, the end of the other string is found while comparing
+		const char* cString = stdstr::data();
+		int thisLength = (int)stdstr::size();
+		for_iter (i, 0, thisLength)
+		{
+			if (cString[i] != string[i] || string[i] == '\0')
+			{
+				return false;
+			}
+		}
+		return (string[thisLength] == '\0');
 	}
 
 	bool String::operator==(const String& string) const
 	{
-		return (strcmp(stdstr::c_str(), string.c_str()) == 0);
+		int thisLength = (int)stdstr::size();
+		return (thisLength == (int)string.stdstr::size() && memcmp(stdstr::data(), string.data(), thisLength) == 0);
 	}
 
 	bool String::operator==(const bool b) const
@@ -1777,22 +1830,33 @@ namespace hltypes
 
 	bool String::operator<(const String& string) const
 	{
-		return (strcmp(stdstr::c_str(), string.c_str()) < 0);
+		return (this->_compare(string.data(), (int)string.stdstr::size()) < 0);
 	}
 
 	bool String::operator>(const String& string) const
 	{
-		return (strcmp(stdstr::c_str(), string.c_str()) > 0);
+		return (this->_compare(string.data(), (int)string.stdstr::size()) > 0);
 	}
 
 	bool String::operator<=(const String& string) const
 	{
-		return (strcmp(stdstr::c_str(), string.c_str()) <= 0);
+		return (this->_compare(string.data(), (int)string.stdstr::size()) <= 0);
 	}
 
 	bool String::operator>=(const String& string) const
 	{
-		return (strcmp(stdstr::c_str(), string.c_str()) >= 0);
+		return (this->_compare(string.data(), (int)string.stdstr::size()) >= 0);
+	}
+
+	int String::_compare(const char* string, int length) const
+	{
+		int thisLength = (int)stdstr::size();
+		int result = memcmp(stdstr::data(), string, hmin(thisLength, length));
+		if (result != 0)
+		{
+			return result;
+		}
+		return (thisLength - length);
 	}
 
 	const char* String::cStr() const
@@ -1985,38 +2049,33 @@ namespace hltypes
 
 hltypes::String hvsprintf(const char* format, va_list args)
 {
-	va_list vaCopy; // need to copy args because vsnprintf delets va_args on some platforms, and if we re-call it with a larger buffer, it will fail
-	int size = 256; // safe assumption that most strings will be under 257 characters
 	// not using a static buffer here to assure thread safety
-	char* c = new char[size + 1];
-	c[0] = '\0';
-	int count = 0;
-	int i;
-	for_iterx (i, 0, 8)
+	char buffer[HVSPRINTF_BUFFER_SIZE];
+	va_list vaCopy; // need to copy args because vsnprintf deletes va_args on some platforms, and if we re-call it, it will fail
+	va_copy(vaCopy, args);
+	int count = hltypes::_platformVsnprintf(buffer, HVSPRINTF_BUFFER_SIZE, format, vaCopy);
+	va_end(vaCopy);
+	hltypes::String result;
+	if (count >= 0 && count < HVSPRINTF_BUFFER_SIZE)
+	{
+		result.stdstr::assign(buffer, count);
+		return result;
+	}
+	if (count < 0) // some implementations don't return the required size when the buffer is too small
 	{
-		// due to different (and non-standard) behavior in different implementations, there is one safe byte
 		va_copy(vaCopy, args);
-		count = hltypes::_platformVsnprintf(c, size, format, vaCopy);
+		count = hltypes::_platformVscprintf(format, vaCopy);
 		va_end(vaCopy);
-		if (count >= 0 && count < size)
+		if (count < 0)
 		{
-			c[count] = '\0'; // terminate string
-			break;
+			return result;
 		}
-		size *= 2; // not enough characters, double current buffer
-		delete[] c;
-		c = new char[size + 1];
-		c[0] = '\0';
 	}
-#ifdef _DEBUG
-	if (i >= 8)
-	{
-		delete[] c;
-		throw Exception("Resulting string for hsprintf is longer than 2^16 (65536) characters!");
-	}
-#endif
-	hltypes::String result(c);
-	delete[] c;
+	// the terminating character goes into the String's own terminator slot
+	result.stdstr::resize(count);
+	va_copy(vaCopy, args);
+	hltypes::_platformVsnprintf(&result.stdstr::operator[](0), count + 1, format, vaCopy);
+	va_end(vaCopy);
 	return result;
 }
 
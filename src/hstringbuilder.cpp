@@ -0,0 +1,374 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hexception.h"
+#include "hltypesUtil.h"
+#include "hstring.h"
+#include "hstringbuilder.h"
+#include "platform_internal.h"
+
+#define MIN_CHUNK_CAPACITY 1024
+#define MAX_FIXED_PRECISION 9
+#define MAX_FIXED_VALUE 1.0e15
+#define FORMAT_BUFFER_SIZE 16
+
+typedef std::basic_string<char> stdstr;
+
+static const char* decimalPairs =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+static const char* hexDigits = "0123456789ABCDEF";
+static const uint64_t powersOf10[MAX_FIXED_PRECISION + 1] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL };
+
+namespace hltypes
+{
+	StringBuilder::StringBuilder(int capacity) : chunkCount(1), chunkCapacity(1), dataSize(0)
+	{
+		this->localChunk.data = this->localData;
+		this->localChunk.size = 0;
+		this->localChunk.capacity = HL_STRING_BUILDER_LOCAL_SIZE;
+		this->chunks = &this->localChunk;
+		if (capacity > HL_STRING_BUILDER_LOCAL_SIZE)
+		{
+			// the local chunk is skipped so all data ends up in one continuous chunk
+			this->localChunk.capacity = 0;
+			this->_addChunk(capacity);
+		}
+	}
+
+	StringBuilder::~StringBuilder()
+	{
+		this->clear();
+	}
+
+	StringBuilder::StringBuilder(const StringBuilder& other)
+	{
+		throw ObjectCannotCopyException("hltypes::StringBuilder");
+	}
+
+	StringBuilder& StringBuilder::operator=(StringBuilder& other)
+	{
+		throw ObjectCannotAssignException("hltypes::StringBuilder");
+		return (*this);
+	}
+
+	void StringBuilder::clear()
+	{
+		for_iter (i, 1, this->chunkCount)
+		{
+			free(this->chunks[i].data);
+		}
+		if (this->chunks != &this->localChunk)
+		{
+			free(this->chunks);
+			this->chunks = &this->localChunk;
+		}
+		this->localChunk.size = 0;
+		this->localChunk.capacity = HL_STRING_BUILDER_LOCAL_SIZE;
+		this->chunkCount = 1;
+		this->chunkCapacity = 1;
+		this->dataSize = 0;
+	}
+
+	void StringBuilder::_addChunk(int capacity)
+	{
+		if (this->chunkCount >= this->chunkCapacity)
+		{
+			int newCapacity = this->chunkCapacity * 2 + 2;
+			Chunk* newChunks = (Chunk*)malloc(newCapacity * sizeof(Chunk));
+			memcpy(newChunks, this->chunks, this->chunkCount * sizeof(Chunk));
+			if (this->chunks != &this->localChunk)
+			{
+				free(this->chunks);
+			}
+			this->chunks = newChunks;
+			this->chunkCapacity = newCapacity;
+		}
+		Chunk* chunk = &this->chunks[this->chunkCount];
+		chunk->data = (char*)malloc(capacity);
+		chunk->size = 0;
+		chunk->capacity = capacity;
+		++this->chunkCount;
+	}
+
+	char* StringBuilder::_reserve(int size)
+	{
+		Chunk* chunk = &this->chunks[this->chunkCount - 1];
+		if (chunk->size + size > chunk->capacity)
+		{
+			// chunks grow with the data so the number of chunks stays logarithmic
+			this->_addChunk(hmax(hmax(size, this->dataSize), MIN_CHUNK_CAPACITY));
+			chunk = &this->chunks[this->chunkCount - 1];
+		}
+		char* result = chunk->data + chunk->size;
+		chunk->size += size;
+		this->dataSize += size;
+		return result;
+	}
+
+	StringBuilder& StringBuilder::add(const char c)
+	{
+		*this->_reserve(1) = c;
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const char c, int times)
+	{
+		if (times > 0)
+		{
+			memset(this->_reserve(times), c, times);
+		}
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const char* string)
+	{
+		return this->add(string, (int)strlen(string));
+	}
+
+	StringBuilder& StringBuilder::add(const char* string, int length)
+	{
+		if (length > 0)
+		{
+			memcpy(this->_reserve(length), string, length);
+		}
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const String& string)
+	{
+		return this->add(string.cStr(), string.size());
+	}
+
+	StringBuilder& StringBuilder::add(const bool b)
+	{
+		return (b ? this->add("true", 4) : this->add("false", 5));
+	}
+
+	StringBuilder& StringBuilder::add(const short s)
+	{
+		this->_addDecimal(s < 0 ? (uint64_t)(-(int64_t)s) : (uint64_t)s, s < 0);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const unsigned short s)
+	{
+		this->_addDecimal((uint64_t)s, false);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const int i)
+	{
+		this->_addDecimal(i < 0 ? (uint64_t)(-(int64_t)i) : (uint64_t)i, i < 0);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const unsigned int i)
+	{
+		this->_addDecimal((uint64_t)i, false);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const int64_t i)
+	{
+		// negating in unsigned arithmetic keeps INT64_MIN valid
+		this->_addDecimal(i < 0 ? (uint64_t)0 - (uint64_t)i : (uint64_t)i, i < 0);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const uint64_t i)
+	{
+		this->_addDecimal(i, false);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const float f)
+	{
+		this->_addFixed((double)f, 6);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const float f, int precision)
+	{
+		this->_addFixed((double)f, precision);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const double d)
+	{
+		this->_addFixed(d, 6);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::add(const double d, int precision)
+	{
+		this->_addFixed(d, precision);
+		return (*this);
+	}
+
+	StringBuilder& StringBuilder::addHex(unsigned int value, int minDigits)
+	{
+		char buffer[8];
+		int count = 0;
+		do
+		{
+			buffer[7 - count] = hexDigits[value & 0xF];
+			value >>= 4;
+			++count;
+		} while (value > 0);
+		if (minDigits > count)
+		{
+			this->add('0', minDigits - count);
+		}
+		return this->add(&buffer[8 - count], count);
+	}
+
+	void StringBuilder::_addDecimal(uint64_t value, bool negative)
+	{
+		char buffer[24];
+		char* end = buffer + 24;
+		char* current = end;
+		while (value >= 100)
+		{
+			int index = (int)(value % 100) * 2;
+			value /= 100;
+			current -= 2;
+			current[0] = decimalPairs[index];
+			current[1] = decimalPairs[index + 1];
+		}
+		if (value >= 10)
+		{
+			int index = (int)value * 2;
+			current -= 2;
+			current[0] = decimalPairs[index];
+			current[1] = decimalPairs[index + 1];
+		}
+		else
+		{
+			*--current = (char)('0' + value);
+		}
+		if (negative)
+		{
+			*--current = '-';
+		}
+		this->add(current, (int)(end - current));
+	}
+
+	void StringBuilder::_addFixed(double value, int precision)
+	{
+		precision = hmax(precision, 0);
+		if (precision > MAX_FIXED_PRECISION || !(fabs(value) < MAX_FIXED_VALUE)) // also catches NaN and infinity
+		{
+			this->_addFixedFormatted(value, precision);
+			return;
+		}
+		double scaled = fabs(value) * (double)powersOf10[precision];
+		double integral = floor(scaled);
+		double fraction = scaled - integral;
+		// the multiplication is off by up to half an ulp, so values this close to a tie could round differently than printf which uses the exact value
+		if (fabs(fraction - 0.5) <= scaled * DBL_EPSILON)
+		{
+			this->_addFixedFormatted(value, precision);
+			return;
+		}
+		uint64_t bits = 0;
+		memcpy(&bits, &value, sizeof(value));
+		bool negative = ((bits >> 63) != 0); // printf keeps the sign of -0.0 as well
+		if (fraction > 0.5)
+		{
+			integral += 1.0;
+		}
+		uint64_t total = (uint64_t)integral;
+		uint64_t whole = total / powersOf10[precision];
+		uint64_t decimals = total % powersOf10[precision];
+		this->_addDecimal(whole, negative);
+		if (precision > 0)
+		{
+			char* buffer = this->_reserve(precision + 1);
+			buffer[0] = '.';
+			for (int i = precision; i > 0; --i)
+			{
+				buffer[i] = (char)('0' + decimals % 10);
+				decimals /= 10;
+			}
+		}
+	}
+
+	void StringBuilder::_addFixedFormatted(double value, int precision)
+	{
+		char format[FORMAT_BUFFER_SIZE] = { '\0' };
+		_platformSprintf(format, "%%.%dlf", precision);
+		this->add(hsprintf(format, value));
+	}
+
+	const char* StringBuilder::addFormatText(const char* format)
+	{
+		return this->_addFormatText(format, true);
+	}
+
+	void StringBuilder::addFormatEnd(const char* format)
+	{
+		this->_addFormatText(format, false);
+	}
+
+	StringBuilder& StringBuilder::add(const void* pointer)
+	{
+		return this->add(hsprintf("%p", pointer));
+	}
+
+	const char* StringBuilder::_addFormatText(const char* format, bool placeholders)
+	{
+		const char* current = format;
+		while (true)
+		{
+			if (*current == '\0')
+			{
+				this->add(format, (int)(current - format));
+				return current;
+			}
+			if (current[0] == '{' && current[1] == '}' && placeholders)
+			{
+				this->add(format, (int)(current - format));
+				return (current + 2);
+			}
+			if ((current[0] == '{' && current[1] == '{') || (current[0] == '}' && current[1] == '}'))
+			{
+				this->add(format, (int)(current - format) + 1);
+				current += 2;
+				format = current;
+				continue;
+			}
+			++current;
+		}
+	}
+
+	String StringBuilder::toString() const
+	{
+		String result;
+		result.stdstr::reserve(this->dataSize);
+		for_iter (i, 0, this->chunkCount)
+		{
+			result.stdstr::append(this->chunks[i].data, this->chunks[i].size);
+		}
+		return result;
+	}
+
+}
@@ -0,0 +1,51 @@
+/// @file
+/// @version 4.0
+/// 
+/// @section LICENSE
+/// 
+/// This program is free software; you can redistribute it and/or modify it under
+/// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
+/// 
+/// @section DESCRIPTION
+/// 
+/// Provides access to miniz's inflate state which is only defined in the implementation part of miniz.
+
+#ifdef _ZIPRESOURCE
+#ifndef HLTYPES_MINIZ_INTERNAL_H
+#define HLTYPES_MINIZ_INTERNAL_H
+
+#define MINIZ_HEADER_FILE_ONLY
+#include <miniz.cpp>
+
+// this is owned by hltypes, not by miniz, so the layout below has to be checked whenever miniz is updated
+#if MZ_VERNUM != 0x91F0
+#error "miniz was updated, check if _MinizInflateState still matches inflate_state in miniz.cpp!"
+#endif
+
+namespace hltypes
+{
+	/// @brief Same layout as inflate_state in miniz which is the state behind mz_stream::state of the inflate API.
+	struct _MinizInflateState
+	{
+		miniz::tinfl_decompressor decompressor;
+		miniz::mz_uint dictOffset;
+		miniz::mz_uint dictAvailable;
+		miniz::mz_uint firstCall;
+		miniz::mz_uint hasFlushed;
+		int windowBits;
+		miniz::mz_uint8 dict[TINFL_LZ_DICT_SIZE];
+		miniz::tinfl_status lastStatus;
+	};
+
+	/// @brief Gets the number of input bytes that the decompressor received, but didn't use.
+	/// @param[in] zStream The inflate stream.
+	/// @return Number of unused input bytes.
+	/// @note The decompressor may have buffered a few bytes past the end of the compressed data in its bit buffer.
+	inline int _minizInflateUnusedBytes(miniz::mz_stream* zStream)
+	{
+		return ((int)zStream->avail_in + (int)(((_MinizInflateState*)zStream->state)->decompressor.m_num_bits >> 3));
+	}
+
+}
+#endif
+#endif
@@ -6,21 +6,30 @@
 /// This program is free software; you can redistribute it and/or modify it under
 /// the terms of the BSD license: http://opensource.org/licenses/BSD-3-Clause
 
+#include <errno.h>
 #include <stdio.h>
 
 #ifdef _WIN32
 	#include <direct.h>
+	#include <fcntl.h>
+	#include <io.h>
+	#include <sys/stat.h>
 	#include "msvc_dirent.h"
 	#define WINDOWS_TICK 10000000ULL
 	#define SEC_TO_UNIX_EPOCH 11644473600ULL
 #else
 	#include <stdlib.h>
 	#include <dirent.h>
+	#include <fcntl.h>
+	#include <sys/mman.h>
 	#include <sys/stat.h>
+	#include <sys/time.h>
 	#include <sys/types.h>
 	#include <unistd.h>
-	#if defined(_ANDROID) || defined(__APPLE__)
-		#include <errno.h>
+	#ifdef __linux__
+		#include <sys/sendfile.h>
+		#include <sys/syscall.h>
+		#include <sys/uio.h>
 	#endif
 #endif
 
@@ -29,10 +38,19 @@
 #include "hdir.h"
 #include "hfbase.h"
 #include "hlog.h"
+#include "hltypesUtil.h"
 #include "hplatform.h"
 #include "hstring.h"
 #include "platform_internal.h"
 
+#define COPY_BUFFER_SIZE 1048576
+#define COPY_CHUNK_SIZE 1073741824
+#if defined(__linux__) && !defined(_ANDROID)
+	#define IO_VECTOR_COUNT 1024
+#else
+	#define IO_VECTOR_COUNT 1
+#endif
+
 #if defined(_WIN32) && defined(_MSC_VER) && !defined(_WINRT)
 	#define _WIN32_MKDIR_FULL_PERMISSIONS
 #endif
@@ -121,6 +139,15 @@ namespace hltypes
 		return vsnprintf(buffer, bufferCount, format, args);
 	}
 
+	int _platformVscprintf(const char* format, va_list args)
+	{
+#ifdef _WIN32
+		return _vscprintf(format, args);
+#else
+		return vsnprintf(NULL, 0, format, args);
+#endif
+	}
+
 	String _platformEnv(const String& name)
 	{
 #ifdef _WIN32
@@ -149,9 +176,38 @@ namespace hltypes
 #endif
 	}
 
-	void _platformCloseFile(_platformFile* file)
+	_platformFile* _platformCreateFile(const String& name)
+	{
+		errno = 0;
+#ifdef _WIN32
+		int handle = _wopen(name.wStr().c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE);
+		if (handle < 0)
+		{
+			return NULL;
+		}
+		FILE* file = _fdopen(handle, "wb");
+		if (file == NULL)
+		{
+			_close(handle);
+		}
+#else
+		int handle = open(name.cStr(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+		if (handle < 0)
+		{
+			return NULL;
+		}
+		FILE* file = fdopen(handle, "wb");
+		if (file == NULL)
+		{
+			close(handle);
+		}
+#endif
+		return (_platformFile*)file;
+	}
+
+	bool _platformCloseFile(_platformFile* file)
 	{
-		fclose((FILE*)file);
+		return (fclose((FILE*)file) == 0);
 	}
 
 	int _platformReadFile(void* buffer, int elementSize, int elementCount, _platformFile* file)
@@ -164,6 +220,102 @@ namespace hltypes
 		return (int)fwrite(buffer, elementSize, elementCount, (FILE*)file);
 	}
 
+	static int64_t _transferFileAt(_platformFile* file, const IoVector* vectors, int count, int64_t offset, bool writing)
+	{
+		int64_t result = 0LL;
+#ifdef _WIN32
+		HANDLE handle = (HANDLE)_get_osfhandle(_fileno((FILE*)file));
+		DWORD size = 0;
+		DWORD chunkSize = 0;
+		BOOL success = TRUE;
+		int64_t done = 0LL;
+		unsigned char* data = NULL;
+		OVERLAPPED overlapped;
+		LARGE_INTEGER zero;
+		zero.QuadPart = 0LL;
+		LARGE_INTEGER position;
+		// ReadFile() and WriteFile() move the file pointer even when an offset is used, so it's restored while stdio is locked
+		_lock_file((FILE*)file);
+		SetFilePointerEx(handle, zero, &position, FILE_CURRENT);
+		for_iter (i, 0, count)
+		{
+			data = (unsigned char*)vectors[i].data;
+			done = 0LL;
+			while (success && done < vectors[i].size)
+			{
+				memset(&overlapped, 0, sizeof(OVERLAPPED));
+				overlapped.Offset = (DWORD)((offset + result) & 0xFFFFFFFF);
+				overlapped.OffsetHigh = (DWORD)((offset + result) >> 32);
+				chunkSize = (DWORD)hmin(vectors[i].size - done, (int64_t)COPY_CHUNK_SIZE);
+				size = 0;
+				success = (writing ? WriteFile(handle, &data[done], chunkSize, &size, &overlapped) : ReadFile(handle, &data[done], chunkSize, &size, &overlapped));
+				result += size;
+				done += size;
+				if (size < chunkSize)
+				{
+					success = FALSE;
+				}
+			}
+			if (!success)
+			{
+				break;
+			}
+		}
+		SetFilePointerEx(handle, position, NULL, FILE_BEGIN);
+		_unlock_file((FILE*)file);
+#else
+		int handle = fileno((FILE*)file);
+		struct iovec ioVectors[IO_VECTOR_COUNT];
+		int index = 0;
+		int64_t done = 0LL;
+		int ioCount = 0;
+		ssize_t size = 0;
+		while (index < count)
+		{
+			ioCount = hmin(count - index, IO_VECTOR_COUNT);
+			for_iter (i, 0, ioCount)
+			{
+				ioVectors[i].iov_base = (void*)vectors[index + i].data;
+				ioVectors[i].iov_len = (size_t)vectors[index + i].size;
+			}
+			// skips data of the first buffer that was already transferred
+			ioVectors[0].iov_base = (char*)ioVectors[0].iov_base + done;
+			ioVectors[0].iov_len -= (size_t)done;
+#if IO_VECTOR_COUNT > 1
+			size = (writing ? pwritev(handle, ioVectors, ioCount, offset + result) : preadv(handle, ioVectors, ioCount, offset + result));
+#else
+			size = (writing ? pwrite(handle, ioVectors[0].iov_base, ioVectors[0].iov_len, offset + result) : pread(handle, ioVectors[0].iov_base, ioVectors[0].iov_len, offset + result));
+#endif
+			if (size < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (size < 0 || (size == 0 && ioVectors[0].iov_len > 0))
+			{
+				break;
+			}
+			result += size;
+			done += size;
+			while (index < count && done >= vectors[index].size)
+			{
+				done -= vectors[index].size;
+				++index;
+			}
+		}
+#endif
+		return result;
+	}
+
+	int64_t _platformReadFileAt(_platformFile* file, const IoVector* vectors, int count, int64_t offset)
+	{
+		return _transferFileAt(file, vectors, count, offset, false);
+	}
+
+	int64_t _platformWriteFileAt(_platformFile* file, const IoVector* vectors, int count, int64_t offset)
+	{
+		return _transferFileAt(file, vectors, count, offset, true);
+	}
+
 	int64_t _platformGetFilePosition(_platformFile* file)
 	{
 		fpos_t position = 0;
@@ -174,6 +326,25 @@ namespace hltypes
 		return (int64_t)position;
 	}
 
+	bool _platformFlushFile(_platformFile* file)
+	{
+		return (fflush((FILE*)file) == 0);
+	}
+
+	bool _platformSyncFile(_platformFile* file, bool dataOnly)
+	{
+#ifdef _WIN32
+		return (FlushFileBuffers((HANDLE)_get_osfhandle(_fileno((FILE*)file))) != 0);
+#elif defined(__APPLE__)
+		// fsync() on Apple platforms only hands the data to the drive, F_FULLFSYNC also flushes the drive's cache
+		int handle = fileno((FILE*)file);
+		return (dataOnly ? fsync(handle) == 0 : (fcntl(handle, F_FULLFSYNC) == 0 || fsync(handle) == 0));
+#else
+		int handle = fileno((FILE*)file);
+		return ((dataOnly ? fdatasync(handle) : fsync(handle)) == 0);
+#endif
+	}
+
 	bool _platformSeekFile(_platformFile* file, int64_t size, int64_t position, int64_t offset, StreamBase::SeekMode seekMode)
 	{
 		fpos_t _position = position;
@@ -211,6 +382,37 @@ namespace hltypes
 #endif
 	}
 
+	bool _platformReplaceFile(const String& oldName, const String& newName)
+	{
+#ifdef _WIN32
+#ifndef _WINRT
+		return (MoveFileExW(oldName.wStr().c_str(), newName.wStr().c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0);
+#else
+		// not atomic, but WinRT doesn't allow anything better
+		_wremove(newName.wStr().c_str());
+		return (_wrename(oldName.wStr().c_str(), newName.wStr().c_str()) == 0);
+#endif
+#else
+		// rename() replaces an existing file atomically
+		return (rename(oldName.cStr(), newName.cStr()) == 0);
+#endif
+	}
+
+	bool _platformCopyFilePermissions(const String& oldName, const String& newName)
+	{
+#ifdef _WIN32
+		// permissions are ACLs that are inherited from the directory
+		return true;
+#else
+		struct stat info;
+		if (stat(oldName.cStr(), &info) != 0)
+		{
+			return false;
+		}
+		return (chmod(newName.cStr(), info.st_mode & 07777) == 0);
+#endif
+	}
+
 	bool _platformRemoveFile(const String& name)
 	{
 #ifdef _WIN32
@@ -220,6 +422,24 @@ namespace hltypes
 #endif
 	}
 
+#ifdef _WIN32
+	static int64_t _fileTimeToUnixTime(const FILETIME& time)
+	{
+		ULARGE_INTEGER ull;
+		ull.LowPart = time.dwLowDateTime;
+		ull.HighPart = time.dwHighDateTime;
+		return (int64_t)(ull.QuadPart / WINDOWS_TICK - SEC_TO_UNIX_EPOCH);
+	}
+#else
+	static void _fillFileInfo(FileInfo& info, const struct stat& s)
+	{
+		info.size = (int64_t)s.st_size;
+		info.creationTime = (int64_t)s.st_ctime;
+		info.accessTime = (int64_t)s.st_atime;
+		info.modificationTime = (int64_t)s.st_mtime;
+	}
+#endif
+
 	FileInfo _platformStatFile(const String& name)
 	{
 		FileInfo info;
@@ -228,17 +448,10 @@ namespace hltypes
 		memset(&data, 0, sizeof(WIN32_FILE_ATTRIBUTE_DATA));
 		if (GetFileAttributesExW(name.wStr().c_str(), GetFileExInfoStandard, &data) != 0)
 		{
-			info.size = (int64_t)data.nFileSizeLow;
-			ULARGE_INTEGER ull;
-			ull.LowPart = data.ftCreationTime.dwLowDateTime;
-			ull.HighPart = data.ftCreationTime.dwHighDateTime;
-			info.creationTime = (int64_t)(ull.QuadPart / WINDOWS_TICK - SEC_TO_UNIX_EPOCH);
-			ull.LowPart = data.ftLastAccessTime.dwLowDateTime;
-			ull.HighPart = data.ftLastAccessTime.dwHighDateTime;
-			info.accessTime = (int64_t)(ull.QuadPart / WINDOWS_TICK - SEC_TO_UNIX_EPOCH);
-			ull.LowPart = data.ftLastWriteTime.dwLowDateTime;
-			ull.HighPart = data.ftLastWriteTime.dwHighDateTime;
-			info.modificationTime = (int64_t)(ull.QuadPart / WINDOWS_TICK - SEC_TO_UNIX_EPOCH);
+			info.size = (int64_t)(((uint64_t)data.nFileSizeHigh << 32) | (uint64_t)data.nFileSizeLow);
+			info.creationTime = _fileTimeToUnixTime(data.ftCreationTime);
+			info.accessTime = _fileTimeToUnixTime(data.ftLastAccessTime);
+			info.modificationTime = _fileTimeToUnixTime(data.ftLastWriteTime);
 		}
 #else
 		struct stat s;
@@ -252,12 +465,287 @@ namespace hltypes
 			}
 			throw FileCouldNotOpenException("stat() failed on '" + name + "', file not found!");
 		}
+		_fillFileInfo(info, s);
+#endif
+		return info;
+	}
+
+	bool _platformStatOpenFile(_platformFile* file, FileInfo& info)
+	{
+#ifdef _WIN32
+		struct _stat64 s;
+		if (_fstat64(_fileno((FILE*)file), &s) != 0)
+		{
+			return false;
+		}
 		info.size = (int64_t)s.st_size;
 		info.creationTime = (int64_t)s.st_ctime;
 		info.accessTime = (int64_t)s.st_atime;
 		info.modificationTime = (int64_t)s.st_mtime;
+#else
+		struct stat s;
+		if (fstat(fileno((FILE*)file), &s) != 0)
+		{
+			return false;
+		}
+		_fillFileInfo(info, s);
+#endif
+		return true;
+	}
+
+	void _platformStatFiles(const String* names, int count, FileInfo* results)
+	{
+#ifdef _WIN32
+		for_iter (i, 0, count)
+		{
+			results[i] = _platformStatFile(names[i]);
+		}
+#else
+		// consecutive paths in the same directory are resolved relative to a directory handle, so the directory is only looked up once
+		struct stat s;
+		int dirHandle = -1;
+		const char* dirName = NULL;
+		int dirLength = -2;
+		const char* name = NULL;
+		const char* slash = NULL;
+		const char* baseName = NULL;
+		int length = 0;
+		bool found = false;
+		for_iter (i, 0, count)
+		{
+			name = names[i].cStr();
+			slash = strrchr(name, '/');
+			length = (slash != NULL ? (int)(slash - name) : -1);
+			if (length != dirLength || (length > 0 && strncmp(name, dirName, length) != 0))
+			{
+				if (dirHandle >= 0)
+				{
+					::close(dirHandle);
+				}
+				dirHandle = open((length > 0 ? String(name, length).cStr() : (length == 0 ? "/" : ".")), O_RDONLY | O_DIRECTORY);
+				dirName = name;
+				dirLength = length;
+			}
+			baseName = (slash != NULL ? slash + 1 : name);
+			if (dirHandle >= 0 && *baseName != '\0')
+			{
+				found = (fstatat(dirHandle, baseName, &s, 0) == 0);
+			}
+			else
+			{
+				found = (stat(name, &s) == 0);
+			}
+			if (found)
+			{
+				_fillFileInfo(results[i], s);
+			}
+		}
+		if (dirHandle >= 0)
+		{
+			::close(dirHandle);
+		}
+#endif
+	}
+
+	void* _platformMapFile(const String& name, bool privateCopy, int64_t& outSize, void*& outHandle)
+	{
+		outSize = 0;
+		outHandle = NULL;
+#ifdef _WIN32
+#ifndef _WINRT
+		HANDLE file = CreateFileW(name.wStr().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return NULL;
+		}
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) == 0 || size.QuadPart <= 0 || (uint64_t)size.QuadPart > (uint64_t)((size_t)-1))
+		{
+			CloseHandle(file);
+			return NULL;
+		}
+		HANDLE mapping = CreateFileMappingW(file, NULL, (privateCopy ? PAGE_WRITECOPY : PAGE_READONLY), 0, 0, NULL);
+		CloseHandle(file); // the mapping keeps its own reference to the file
+		if (mapping == NULL)
+		{
+			return NULL;
+		}
+		void* data = MapViewOfFile(mapping, (privateCopy ? FILE_MAP_COPY : FILE_MAP_READ), 0, 0, 0);
+		if (data == NULL)
+		{
+			CloseHandle(mapping);
+			return NULL;
+		}
+		outSize = (int64_t)size.QuadPart;
+		outHandle = mapping;
+		return data;
+#else
+		return NULL; // WinRT can't map arbitrary files
+#endif
+#else
+		int file = open(name.cStr(), O_RDONLY);
+		if (file < 0)
+		{
+			return NULL;
+		}
+		struct stat s;
+		if (fstat(file, &s) != 0 || s.st_size <= 0 || (uint64_t)s.st_size > (uint64_t)((size_t)-1))
+		{
+			::close(file);
+			return NULL;
+		}
+		void* data = mmap(NULL, (size_t)s.st_size, (privateCopy ? PROT_READ | PROT_WRITE : PROT_READ), MAP_PRIVATE, file, 0);
+		::close(file); // the mapping keeps its own reference to the file
+		if (data == MAP_FAILED)
+		{
+			return NULL;
+		}
+		outSize = (int64_t)s.st_size;
+		return data;
+#endif
+	}
+
+	void _platformUnmapFile(void* data, int64_t size, void* handle)
+	{
+#ifdef _WIN32
+#ifndef _WINRT
+		UnmapViewOfFile(data);
+		CloseHandle((HANDLE)handle);
+#endif
+#else
+		(void)handle; // only needed on Windows
+		munmap(data, (size_t)size);
+#endif
+	}
+
+	bool _platformCopyFile(const String& oldName, const String& newName)
+	{
+#ifdef _WIN32
+#ifndef _WINRT
+		return (CopyFileW(oldName.wStr().c_str(), newName.wStr().c_str(), FALSE) != 0);
+#else
+		return SUCCEEDED(CopyFile2(oldName.wStr().c_str(), newName.wStr().c_str(), NULL));
+#endif
+#else
+		int source = open(oldName.cStr(), O_RDONLY);
+		if (source < 0)
+		{
+			return false;
+		}
+		struct stat s;
+		if (fstat(source, &s) != 0)
+		{
+			::close(source);
+			return false;
+		}
+		int destination = open(newName.cStr(), O_WRONLY | O_CREAT | O_TRUNC, s.st_mode & 0777);
+		if (destination < 0)
+		{
+			::close(source);
+			return false;
+		}
+		int64_t remaining = (int64_t)s.st_size;
+		ssize_t copied = 0;
+#ifdef __linux__
+		// the kernel copies without moving the data through user space, copy_file_range() can even share extents on CoW file systems
+		bool copyRange = true;
+		while (remaining > 0)
+		{
+			copied = -1;
+#ifdef SYS_copy_file_range
+			if (copyRange)
+			{
+				copied = (ssize_t)syscall(SYS_copy_file_range, source, NULL, destination, NULL, (size_t)hmin(remaining, (int64_t)COPY_CHUNK_SIZE), 0);
+				if (copied < 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP || errno == EPERM))
+				{
+					copyRange = false;
+				}
+			}
+			if (!copyRange)
+#endif
+			{
+				copied = sendfile(destination, source, NULL, (size_t)hmin(remaining, (int64_t)COPY_CHUNK_SIZE));
+			}
+			if (copied <= 0)
+			{
+				break;
+			}
+			remaining -= copied;
+		}
+#endif
+		if (remaining > 0)
+		{
+			unsigned char* buffer = (unsigned char*)malloc(COPY_BUFFER_SIZE);
+			if (buffer != NULL)
+			{
+				ssize_t written = 0;
+				while (remaining > 0)
+				{
+					copied = read(source, buffer, COPY_BUFFER_SIZE);
+					if (copied <= 0)
+					{
+						break;
+					}
+					written = write(destination, buffer, (size_t)copied);
+					if (written != copied)
+					{
+						break;
+					}
+					remaining -= copied;
+				}
+				free(buffer);
+			}
+		}
+		::close(source);
+		bool result = (::close(destination) == 0);
+		return (result && remaining <= 0);
+#endif
+	}
+
+	bool _platformSetFileTimes(const String& name, const FileInfo& info)
+	{
+#ifdef _WIN32
+#ifndef _WINRT
+		HANDLE file = CreateFileW(name.wStr().c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		FILETIME times[3];
+		int64_t values[3] = {info.creationTime, info.accessTime, info.modificationTime};
+		ULARGE_INTEGER ull;
+		for_iter (i, 0, 3)
+		{
+			ull.QuadPart = ((ULONGLONG)values[i] + SEC_TO_UNIX_EPOCH) * WINDOWS_TICK;
+			times[i].dwLowDateTime = ull.LowPart;
+			times[i].dwHighDateTime = ull.HighPart;
+		}
+		bool result = (SetFileTime(file, &times[0], &times[1], &times[2]) != 0);
+		CloseHandle(file);
+		return result;
+#else
+		return false;
+#endif
+#else
+		// the creation (status change) time is maintained by the system and can't be set
+		struct timeval times[2];
+		times[0].tv_sec = (time_t)info.accessTime;
+		times[0].tv_usec = 0;
+		times[1].tv_sec = (time_t)info.modificationTime;
+		times[1].tv_usec = 0;
+		return (utimes(name.cStr(), times) == 0);
+#endif
+	}
+
+	int _platformGetPageSize()
+	{
+#ifdef _WIN32
+		SYSTEM_INFO info;
+		GetNativeSystemInfo(&info);
+		return (int)info.dwPageSize;
+#else
+		return (int)sysconf(_SC_PAGESIZE);
 #endif
-		return info;
 	}
 
 	_platformDir* _platformOpenDirectory(const String& dirName)
@@ -292,6 +780,100 @@ namespace hltypes
 		return String::fromUnicode(((struct dirent*)entry)->d_name);
 	}
 
+	void _platformGetDirEntryInfo(_platformDir* dir, _platformDirEntry* entry, bool withInfo, DirEntry& result)
+	{
+		result.name = String::fromUnicode(((struct dirent*)entry)->d_name);
+		result.type = DirEntry::Type::Other;
+		result.size = -1LL;
+		result.modificationTime = 0LL;
+		result.symbolicLink = false;
+#ifdef _WIN32
+		// the find data already contains everything
+		WIN32_FIND_DATAW& data = ((struct dirent*)entry)->data;
+		result.type = ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? DirEntry::Type::Directory : DirEntry::Type::File);
+		result.symbolicLink = ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0);
+		if (withInfo)
+		{
+			result.size = (int64_t)(((uint64_t)data.nFileSizeHigh << 32) | (uint64_t)data.nFileSizeLow);
+			ULARGE_INTEGER ull;
+			ull.LowPart = data.ftLastWriteTime.dwLowDateTime;
+			ull.HighPart = data.ftLastWriteTime.dwHighDateTime;
+			result.modificationTime = (int64_t)(ull.QuadPart / WINDOWS_TICK - SEC_TO_UNIX_EPOCH);
+		}
+#else
+		struct dirent* posixEntry = (struct dirent*)entry;
+		bool resolve = true;
+#ifdef DT_UNKNOWN
+		if (posixEntry->d_type == DT_DIR)
+		{
+			result.type = DirEntry::Type::Directory;
+			resolve = false;
+		}
+		else if (posixEntry->d_type == DT_REG)
+		{
+			result.type = DirEntry::Type::File;
+			resolve = false;
+		}
+		else if (posixEntry->d_type == DT_LNK)
+		{
+			result.symbolicLink = true;
+		}
+		else if (posixEntry->d_type != DT_UNKNOWN)
+		{
+			resolve = false;
+		}
+#endif
+		if (!resolve && !withInfo)
+		{
+			return;
+		}
+		struct stat s;
+#ifdef DT_UNKNOWN
+		if (posixEntry->d_type == DT_UNKNOWN)
+#endif
+		{
+			// the file system doesn't report types so links have to be detected separately
+			if (fstatat(dirfd((DIR*)dir), posixEntry->d_name, &s, AT_SYMLINK_NOFOLLOW) == 0 && S_ISLNK(s.st_mode))
+			{
+				result.symbolicLink = true;
+			}
+		}
+		// symbolic links are followed, just like when checking existence
+		if (fstatat(dirfd((DIR*)dir), posixEntry->d_name, &s, 0) != 0)
+		{
+			return;
+		}
+		result.type = (S_ISDIR(s.st_mode) ? DirEntry::Type::Directory : (S_ISREG(s.st_mode) ? DirEntry::Type::File : DirEntry::Type::Other));
+		if (withInfo)
+		{
+			result.size = (int64_t)s.st_size;
+			result.modificationTime = (int64_t)s.st_mtime;
+		}
+#endif
+	}
+
+	bool _platformGetPathType(const String& name, DirEntry::Type& type)
+	{
+		type = DirEntry::Type::Other;
+#ifdef _WIN32
+		WIN32_FILE_ATTRIBUTE_DATA data;
+		memset(&data, 0, sizeof(WIN32_FILE_ATTRIBUTE_DATA));
+		if (GetFileAttributesExW(name.wStr().c_str(), GetFileExInfoStandard, &data) == 0)
+		{
+			return false;
+		}
+		type = ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? DirEntry::Type::Directory : DirEntry::Type::File);
+#else
+		struct stat stats;
+		if (stat(name.cStr(), &stats) != 0)
+		{
+			return false;
+		}
+		type = (S_ISDIR(stats.st_mode) ? DirEntry::Type::Directory : (S_ISREG(stats.st_mode) ? DirEntry::Type::File : DirEntry::Type::Other));
+#endif
+		return true;
+	}
+
 	bool _platformDirectoryExists(const String& dirName)
 	{
 #ifdef _WIN32
@@ -338,6 +920,23 @@ namespace hltypes
 #endif
 	}
 
+	bool _platformSyncDirectory(const String& dirName)
+	{
+#ifdef _WIN32
+		// directories can't be synced on Windows, MOVEFILE_WRITE_THROUGH already takes care of renames
+		return true;
+#else
+		int handle = open((dirName != "" ? dirName : String(".")).cStr(), O_RDONLY);
+		if (handle < 0)
+		{
+			return false;
+		}
+		bool result = (fsync(handle) == 0);
+		::close(handle);
+		return result;
+#endif
+	}
+
 	void _platformChdir(const String& dirName)
 	{
 #ifdef _WIN32
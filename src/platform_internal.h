@@ -13,6 +13,7 @@
 #ifndef HLTYPES_PLATFORM_INTERNAL_H
 #define HLTYPES_PLATFORM_INTERNAL_H
 
+#include "hdir.h"
 #include "hfile.h"
 #include "hstring.h"
 
@@ -32,29 +33,47 @@ namespace hltypes
 
 	int _platformSprintf(char* buffer, const char* format, ...);
 	int _platformVsnprintf(char* buffer, size_t bufferCount, const char* format, va_list args);
+	int _platformVscprintf(const char* format, va_list args);
 
 	String _platformEnv(const String& name);
 	String _platformResourceCwd();
 
 	_platformFile* _platformOpenFile(const String& name, const String& accessMode);
-	void _platformCloseFile(_platformFile* file);
+	_platformFile* _platformCreateFile(const String& name);
+	bool _platformCloseFile(_platformFile* file);
 	int _platformReadFile(void* buffer, int elementSize, int elementCount, _platformFile* file);
 	int _platformWriteFile(const void* buffer, int elementSize, int elementCount, _platformFile* file);
+	int64_t _platformReadFileAt(_platformFile* file, const IoVector* vectors, int count, int64_t offset);
+	int64_t _platformWriteFileAt(_platformFile* file, const IoVector* vectors, int count, int64_t offset);
 	int64_t _platformGetFilePosition(_platformFile* file);
+	bool _platformFlushFile(_platformFile* file);
+	bool _platformSyncFile(_platformFile* file, bool dataOnly);
 	bool _platformSeekFile(_platformFile* file, int64_t size, int64_t position, int64_t offset, StreamBase::SeekMode seekMode);
 	bool _platformFileExists(const String& name);
 	bool _platformRenameFile(const String& oldName, const String& newName);
+	bool _platformReplaceFile(const String& oldName, const String& newName);
+	bool _platformCopyFilePermissions(const String& oldName, const String& newName);
 	bool _platformRemoveFile(const String& name);
 	FileInfo _platformStatFile(const String& name);
+	bool _platformStatOpenFile(_platformFile* file, FileInfo& info);
+	void _platformStatFiles(const String* names, int count, FileInfo* results);
+	void* _platformMapFile(const String& name, bool privateCopy, int64_t& outSize, void*& outHandle);
+	void _platformUnmapFile(void* data, int64_t size, void* handle);
+	bool _platformCopyFile(const String& oldName, const String& newName);
+	bool _platformSetFileTimes(const String& name, const FileInfo& info);
+	int _platformGetPageSize();
 
 	_platformDir* _platformOpenDirectory(const String& dirName);
 	void _platformCloseDirectory(_platformDir* dir);
 	_platformDirEntry* _platformReadDirectory(_platformDir* dir);
 	String _platformGetDirEntryName(_platformDirEntry* entry);
+	void _platformGetDirEntryInfo(_platformDir* dir, _platformDirEntry* entry, bool withInfo, DirEntry& result);
 	bool _platformDirectoryExists(const String& dirName);
+	bool _platformGetPathType(const String& name, DirEntry::Type& type);
 	bool _platformCreateDirectory(const String& dirName);
 	bool _platformRenameDirectory(const String& oldName, const String& newName);
 	bool _platformRemoveDirectory(const String& dirName);
+	bool _platformSyncDirectory(const String& dirName);
 
 	void _platformChdir(const String& dirName);
 	String _platformCwd();
@@ -8,28 +8,269 @@
 
 #ifdef _ZIPRESOURCE
 #include <stdio.h>
-#define MINIZ_HEADER_FILE_ONLY
-#include <miniz.cpp>
 
 #include "harray.h"
+#include "hdeflatestream.h"
+#include "hexception.h"
 #include "hfbase.h"
+#include "hfile.h"
+#include "hltypesUtil.h"
 #include "hmap.h"
 #include "hmutex.h"
 #include "hrdir.h"
 #include "hresource.h"
-#include "hstream.h"
+#include "hsbase.h"
 #include "hstring.h"
+#include "miniz_internal.h"
 #include "platform_internal.h"
 #include "zipaccess.h"
 
 #include "hlog.h"
 
 #define FILENAME_BUFFER 8192
+#define LOCAL_HEADER_SIZE 30
+#define LOCAL_HEADER_SIGNATURE 0x04034B50
+#define METHOD_STORED 0
+#define CHECKPOINT_INTERVAL (1024 * 1024)
+#define MAX_CHECKPOINTS 32
 
 namespace hltypes
 {
 	namespace zip
 	{
+		static unsigned int _readUint16Le(const unsigned char* data)
+		{
+			return ((unsigned int)data[0] | ((unsigned int)data[1] << 8));
+		}
+
+		static unsigned int _readUint32Le(const unsigned char* data)
+		{
+			return ((unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24));
+		}
+
+		// utility class that reads the raw data of a file within an archive file with positional reads on the shared archive file handle
+		class EntryDataStream : public StreamBase
+		{
+		public:
+			EntryDataStream(File* file, int64_t offset, int64_t size) : StreamBase(), file(file), offset(offset), streamPosition(0LL)
+			{
+				this->dataSize = size;
+			}
+
+		protected:
+			File* file;
+			int64_t offset;
+			int64_t streamPosition;
+
+			void _updateDataSize()
+			{
+			}
+
+			inline String _descriptor() const { return "zip entry"; }
+
+			int _read(void* buffer, int count)
+			{
+				count = (int)hmin((int64_t)count, this->dataSize - this->streamPosition);
+				if (count <= 0)
+				{
+					return 0;
+				}
+				int result = (int)this->file->readAt(this->offset + this->streamPosition, buffer, count);
+				if (result > 0)
+				{
+					this->streamPosition += result;
+				}
+				return hmax(result, 0);
+			}
+
+			int _write(const void*, int)
+			{
+				throw FileNotWriteableException(this->_descriptor());
+			}
+
+			bool _isOpen() const
+			{
+				return (this->file != NULL);
+			}
+
+			int64_t _position() const
+			{
+				return this->streamPosition;
+			}
+
+			bool _seek(int64_t offset, SeekMode seekMode)
+			{
+				int64_t target = offset;
+				if (seekMode == SeekMode::Current)
+				{
+					target = this->streamPosition + offset;
+				}
+				else if (seekMode == SeekMode::End)
+				{
+					target = this->dataSize + offset;
+				}
+				this->streamPosition = hclamp(target, (int64_t)0, this->dataSize);
+				return true;
+			}
+
+		};
+
+		// utility class that inflates a file within an archive file while it's being read
+		class EntryInflateStream : public DeflateStream
+		{
+		public:
+			EntryInflateStream(StreamBase* stream, int64_t uncompressedSize, unsigned int expectedCrc) : DeflateStream(stream, Mode::Decompress, 0, HL_DEFLATE_BUFFER_SIZE, false),
+				uncompressedSize(uncompressedSize), expectedCrc(expectedCrc), crc(0), checksumPosition(0LL), checkpointInterval(CHECKPOINT_INTERVAL)
+			{
+				this->_initialize();
+			}
+
+			~EntryInflateStream()
+			{
+				foreach (Checkpoint, it, this->checkpoints)
+				{
+					free((*it).state);
+				}
+			}
+
+		protected:
+			// the decompressor state at some point so decompression can be continued from there instead of from the beginning
+			struct Checkpoint
+			{
+				int64_t position;
+				int64_t compressedPosition;
+				_MinizInflateState* state;
+			};
+
+			int64_t uncompressedSize;
+			unsigned int expectedCrc;
+			unsigned int crc;
+			int64_t checksumPosition;
+			Array<Checkpoint> checkpoints;
+			int64_t checkpointInterval;
+
+			inline String _descriptor() const { return "zip entry"; }
+
+			int _windowBits() const
+			{
+				return -MZ_DEFAULT_WINDOW_BITS;
+			}
+
+			void _readTrailer()
+			{
+				int64_t size = this->windowPosition + this->windowSize;
+				// the checksum is only complete if all data was actually decompressed, seeking from a checkpoint skips data
+				if (size != this->uncompressedSize || (this->checksumPosition == size && this->crc != this->expectedCrc))
+				{
+					throw Exception("Data in " + this->_descriptor() + " is corrupted, size or checksum mismatch!");
+				}
+			}
+
+			void _updateChecksum(const unsigned char* data, int size)
+			{
+				// data that was already processed before seeking back is skipped
+				int64_t offset = this->checksumPosition - (this->windowPosition + this->windowSize);
+				if (offset >= 0 && offset < (int64_t)size)
+				{
+					this->crc = (unsigned int)miniz::mz_crc32(this->crc, &data[offset], (size_t)(size - offset));
+					this->checksumPosition += size - offset;
+				}
+			}
+
+			void _decompress()
+			{
+				DeflateStream::_decompress();
+				int64_t position = this->windowPosition + this->windowSize;
+				if (this->finished || position - (this->checkpoints.size() > 0 ? this->checkpoints.last().position : (int64_t)0) < this->checkpointInterval)
+				{
+					return;
+				}
+				miniz::mz_stream* zStream = (miniz::mz_stream*)this->zStream;
+				Checkpoint checkpoint;
+				checkpoint.position = position;
+				checkpoint.compressedPosition = this->stream->position() - zStream->avail_in;
+				checkpoint.state = (_MinizInflateState*)malloc(sizeof(_MinizInflateState));
+				if (checkpoint.state == NULL)
+				{
+					return;
+				}
+				memcpy(checkpoint.state, zStream->state, sizeof(_MinizInflateState));
+				this->checkpoints += checkpoint;
+				if (this->checkpoints.size() > MAX_CHECKPOINTS)
+				{
+					// memory stays bounded by keeping every other checkpoint and checkpointing half as often
+					Array<Checkpoint> kept;
+					for_iter (i, 0, this->checkpoints.size())
+					{
+						if (i % 2 == 0)
+						{
+							kept += this->checkpoints[i];
+						}
+						else
+						{
+							free(this->checkpoints[i].state);
+						}
+					}
+					this->checkpoints = kept;
+					this->checkpointInterval *= 2;
+				}
+			}
+
+			bool _seek(int64_t offset, SeekMode seekMode)
+			{
+				// the size is known so the data doesn't have to be decompressed to the end
+				int64_t target = offset;
+				if (seekMode == SeekMode::Current)
+				{
+					target = this->streamPosition + offset;
+				}
+				else if (seekMode == SeekMode::End)
+				{
+					target = this->uncompressedSize + offset;
+				}
+				target = hclamp(target, (int64_t)0, this->uncompressedSize);
+				this->_restoreCheckpoint(target);
+				return DeflateStream::_seek(target, SeekMode::Start);
+			}
+
+			void _restoreCheckpoint(int64_t target)
+			{
+				Checkpoint* checkpoint = NULL;
+				for_iter (i, 0, this->checkpoints.size())
+				{
+					if (this->checkpoints[i].position > target)
+					{
+						break;
+					}
+					checkpoint = &this->checkpoints[i];
+				}
+				// seeking back without a checkpoint makes DeflateStream restart decompression from the beginning
+				if (checkpoint == NULL)
+				{
+					return;
+				}
+				// also used when seeking forward over data that was decompressed before
+				if (target >= this->windowPosition && checkpoint->position <= this->windowPosition + this->windowSize)
+				{
+					return;
+				}
+				if (!this->stream->seek(checkpoint->compressedPosition, SeekMode::Start))
+				{
+					return;
+				}
+				miniz::mz_stream* zStream = (miniz::mz_stream*)this->zStream;
+				memcpy(zStream->state, checkpoint->state, sizeof(_MinizInflateState));
+				zStream->next_in = this->inputBuffer;
+				zStream->avail_in = 0;
+				this->finished = false;
+				this->windowPosition = checkpoint->position;
+				this->windowSize = 0;
+				this->streamPosition = checkpoint->position;
+				this->dataSize = checkpoint->position;
+			}
+
+		};
+
 		// utility class that handles open archive files
 		class ArchiveFileHandle
 		{
@@ -38,10 +279,11 @@ namespace hltypes
 			String filename;
 			String cwd;
 			miniz::mz_zip_archive* zipArchive;
+			File* file;
 			Array<String> internalFiles;
 			Array<Resource*> accessingResources;
 
-			ArchiveFileHandle(const String& path, const String& filename, const String& cwd) : zipArchive(NULL)
+			ArchiveFileHandle(const String& path, const String& filename, const String& cwd) : zipArchive(NULL), file(NULL)
 			{
 				this->path = path;
 				this->filename = filename;
@@ -73,6 +315,22 @@ namespace hltypes
 						hlog::write(logTag, "Failed mounting zip file: " + zipFilename);
 						return false;
 					}
+					// the data of files is read through a separate handle, because miniz's own file access isn't thread-safe
+					this->file = new File();
+					try
+					{
+						this->file->open(zipFilename);
+					}
+					catch (_Exception& e)
+					{
+						hlog::write(logTag, "Failed mounting zip file: " + e.getMessage());
+						delete this->file;
+						this->file = NULL;
+						miniz::mz_zip_reader_end(this->zipArchive);
+						delete this->zipArchive;
+						this->zipArchive = NULL;
+						return false;
+					}
 				}
 				return true;
 			}
@@ -84,6 +342,8 @@ namespace hltypes
 					miniz::mz_zip_reader_end(this->zipArchive);
 					delete this->zipArchive;
 					this->zipArchive = NULL;
+					delete this->file;
+					this->file = NULL;
 					return true;
 				}
 				return false;
@@ -96,12 +356,25 @@ namespace hltypes
 		{
 		public:
 			ArchiveFileHandle* archive;
-			Stream* stream;
+			StreamBase* dataStream;
+			StreamBase* stream;
+			int64_t size;
 
-			FileHandle(ArchiveFileHandle* archive, Stream* stream)
+			FileHandle(ArchiveFileHandle* archive, StreamBase* dataStream, StreamBase* stream, int64_t size)
 			{
 				this->archive = archive;
+				this->dataStream = dataStream;
 				this->stream = stream;
+				this->size = size;
+			}
+
+			~FileHandle()
+			{
+				if (this->stream != this->dataStream)
+				{
+					delete this->stream;
+				}
+				delete this->dataStream;
 			}
 
 		};
@@ -156,6 +429,33 @@ namespace hltypes
 			}
 		}
 
+		FileHandle* _fopen(ArchiveFileHandle* archive, const miniz::mz_zip_archive_file_stat& stat)
+		{
+			unsigned char header[LOCAL_HEADER_SIZE];
+			if (archive->file->readAt((int64_t)stat.m_local_header_ofs, header, LOCAL_HEADER_SIZE) != LOCAL_HEADER_SIZE || _readUint32Le(header) != LOCAL_HEADER_SIGNATURE)
+			{
+				return NULL;
+			}
+			int64_t offset = (int64_t)stat.m_local_header_ofs + LOCAL_HEADER_SIZE + _readUint16Le(&header[26]) + _readUint16Le(&header[28]);
+			EntryDataStream* dataStream = new EntryDataStream(archive->file, offset, (int64_t)stat.m_comp_size);
+			if (stat.m_method == METHOD_STORED)
+			{
+				return new FileHandle(archive, dataStream, dataStream, (int64_t)stat.m_uncomp_size);
+			}
+			EntryInflateStream* stream = NULL;
+			try
+			{
+				stream = new EntryInflateStream(dataStream, (int64_t)stat.m_uncomp_size, stat.m_crc32);
+			}
+			catch (_Exception& e)
+			{
+				hlog::write(logTag, e.getMessage());
+				delete dataStream;
+				return NULL;
+			}
+			return new FileHandle(archive, dataStream, stream, (int64_t)stat.m_uncomp_size);
+		}
+
 		FileInfo _finfo(ArchiveFileHandle* archiveFile, const String& filename)
 		{
 			FileInfo info;
@@ -214,34 +514,34 @@ namespace hltypes
 			{
 				return NULL;
 			}
-			int size = (int)_finfo(archive, realFilename).size;
-			if (size >= 0)
+			miniz::mz_zip_archive_file_stat stat;
+			int index = miniz::mz_zip_reader_locate_file(archive->zipArchive, realFilename.cStr(), "", miniz::MZ_ZIP_FLAG_CASE_SENSITIVE);
+			if (index < 0 || !miniz::mz_zip_reader_file_stat(archive->zipArchive, index, &stat) || (stat.m_method != METHOD_STORED && stat.m_method != MZ_DEFLATED))
 			{
-				Stream* stream = new Stream(size);
-				stream->prepareManualWriteRaw(size);
-				if (miniz::mz_zip_reader_extract_file_to_mem(archive->zipArchive, realFilename.cStr(), (unsigned char*)(*stream), size, 0) != MZ_FALSE)
-				{
-					FileHandle* fileHandle = new FileHandle(archive, stream);
-					archive->accessingResources += resource;
-					lock.release();
-					stream->rewind();
-					return fileHandle;
-				}
-				delete stream;
+				_aclose(archive);
+				return NULL;
 			}
-			_aclose(archive);
-			return NULL;
+			archive->accessingResources += resource;
+			lock.release();
+			// data is read and decompressed on demand so opening doesn't block other Resources and doesn't need memory for the whole file
+			FileHandle* fileHandle = _fopen(archive, stat);
+			if (fileHandle == NULL)
+			{
+				lock.acquire(&accessMutex);
+				archive->accessingResources -= resource;
+				_aclose(archive);
+			}
+			return fileHandle;
 		}
 
 		void fclose(Resource* resource, void* file)
 		{
 			FileHandle* fileHandle = (FileHandle*)file;
-			delete fileHandle->stream;
-			Mutex::ScopeLock lock(&accessMutex);
-			fileHandle->archive->accessingResources -= resource;
-			_aclose(fileHandle->archive);
-			lock.release();
+			ArchiveFileHandle* archive = fileHandle->archive;
 			delete fileHandle;
+			Mutex::ScopeLock lock(&accessMutex);
+			archive->accessingResources -= resource;
+			_aclose(archive);
 		}
 
 		bool fseek(void* file, int64_t offset, StreamBase::SeekMode mode)
@@ -276,7 +576,7 @@ namespace hltypes
 
 		int64_t fsize(void* file)
 		{
-			return ((FileHandle*)file)->stream->size();
+			return ((FileHandle*)file)->size;
 		}
 
 		FileInfo finfo(const String& filename)
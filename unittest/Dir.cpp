@@ -9,6 +9,7 @@
 #include "hdir.h"
 #include "hexception.h"
 #include "hfile.h"
+#include "hpathcache.h"
 #include "hstring.h"
 
 HL_UT_TEST_CLASS(Dir)
@@ -81,16 +82,152 @@ HL_UT_TEST_CLASS(Dir)
 		hstr dirname2 = "testdir2/testdir3";
 		hdir::create(dirname + "/" + dirname2 + "/");
 		hfile::create(dirname + "/testdir2/test.txt");
-		hfile::create(dirname + "/" + dirname2 + "/test.txt");
+		hfile::hwrite(dirname + "/" + dirname2 + "/test.txt", "This is a copy test.");
 		HL_UT_ASSERT(hdir::exists(dirname + "/" + dirname2), "");
 		hstr newdir = "dir";
 		hdir::remove(newdir + "/" + dirname + "/");
-		hdir::copy(dirname, newdir + "/" + dirname);
+		HL_UT_ASSERT(hdir::copy(dirname, newdir + "/" + dirname), "");
 		HL_UT_ASSERT(hdir::exists(dirname), "");
 		HL_UT_ASSERT(hdir::exists(dirname + "/" + dirname2), "");
 		HL_UT_ASSERT(hdir::exists(newdir + "/" + dirname), "");
 		HL_UT_ASSERT(hdir::exists(newdir + "/" + dirname + "/" + dirname2), "");
+		HL_UT_ASSERT(hfile::exists(newdir + "/" + dirname + "/testdir2/test.txt"), "");
+		HL_UT_ASSERT(hfile::hread(newdir + "/" + dirname + "/" + dirname2 + "/test.txt") == "This is a copy test.", "");
+		HL_UT_ASSERT(!hdir::copy(dirname, newdir + "/" + dirname), "");
 		hdir::remove(dirname);
 		hdir::remove(newdir + "/" + dirname);
 	}
+
+	HL_UT_TEST_FUNCTION(staticScan)
+	{
+		hstr dirname = "testdir";
+		hdir::create(dirname + "/testdir2");
+		hfile::hwrite(dirname + "/test.txt", "This is a scan test.");
+		harray<hdirentry> entries = hdir::scan(dirname, true);
+		HL_UT_ASSERT(entries.size() == 2, "");
+		foreach (hdirentry, it, entries)
+		{
+			if ((*it).name == "testdir2")
+			{
+				HL_UT_ASSERT((*it).isDirectory(), "");
+			}
+			else
+			{
+				HL_UT_ASSERT((*it).name == "test.txt", "");
+				HL_UT_ASSERT((*it).isFile(), "");
+				HL_UT_ASSERT((*it).size == 20LL, "");
+				HL_UT_ASSERT((*it).modificationTime > 0LL, "");
+			}
+		}
+		HL_UT_ASSERT(hdir::files(dirname) == harray<hstr>("test.txt"), "");
+		HL_UT_ASSERT(hdir::directories(dirname) == harray<hstr>("testdir2"), "");
+		HL_UT_ASSERT(hdir::entries(dirname).size() == 4, "");
+		HL_UT_ASSERT(hdir::scan(dirname + "/missing").size() == 0, "");
+		hdir::remove(dirname);
+	}
+
+	static bool _walkStop(const hstr& path, const hdirentry& entry, void* userData)
+	{
+		++(*(int*)userData);
+		return false;
+	}
+
+	HL_UT_TEST_FUNCTION(staticWalk)
+	{
+		hstr dirname = "testdir";
+		hdir::create(dirname + "/a/b/c");
+		hfile::create(dirname + "/root.txt");
+		hfile::create(dirname + "/a/image.PNG");
+		hfile::create(dirname + "/a/b/data.bin");
+		hfile::create(dirname + "/a/b/c/deep.txt");
+		hdirwalkoptions options;
+		harray<hstr> paths = hdir::walk(dirname, options);
+		HL_UT_ASSERT(paths.size() == 4, "");
+		HL_UT_ASSERT(paths.has(dirname + "/a/b/c/deep.txt"), "");
+		options.maxDepth = 1;
+		paths = hdir::walk(dirname, options);
+		HL_UT_ASSERT(paths.sorted().joined(",") == "testdir/a/image.PNG,testdir/root.txt", "");
+		options.maxDepth = -1;
+		options.patterns += "*.txt";
+		paths = hdir::walk(dirname, options);
+		HL_UT_ASSERT(paths.sorted().joined(",") == "testdir/a/b/c/deep.txt,testdir/root.txt", "");
+		options.patterns.clear();
+		options.extensions += "png";
+		HL_UT_ASSERT(hdir::walk(dirname, options).joined(",") == "testdir/a/image.PNG", "");
+		options.extensions.clear();
+		options.files = false;
+		options.directories = true;
+		options.threadCount = 4;
+		paths = hdir::walk(dirname, options);
+		HL_UT_ASSERT(paths.sorted().joined(",") == "testdir/a,testdir/a/b,testdir/a/b/c", "");
+		options.files = true;
+		paths = hdir::walk(dirname, options);
+		HL_UT_ASSERT(paths.size() == 7, "");
+		int count = 0;
+		options.threadCount = 1;
+		HL_UT_ASSERT(!hdir::walk(dirname, options, &_walkStop, &count), "");
+		HL_UT_ASSERT(count == 1, "");
+		HL_UT_ASSERT(hdir::walk(dirname + "/missing", options).size() == 0, "");
+		hdir::remove(dirname);
+	}
+
+	HL_UT_TEST_FUNCTION(pathCache)
+	{
+		hstr filename = "testdir/cache.txt";
+		hdir::remove("testdir");
+		hpathcache::setTimeToLive(0.0f);
+		hpathcache::setEnabled(true);
+		hpathcache::resetCounters();
+		HL_UT_ASSERT(!hfile::exists(filename), "");
+		hdir::create("testdir");
+		hfile::hwrite(filename, "This is a cache test.");
+		HL_UT_ASSERT(hfile::exists(filename), "");
+		HL_UT_ASSERT(hfile::exists(filename), "");
+		HL_UT_ASSERT(hdir::exists("testdir"), "");
+		HL_UT_ASSERT(hdir::files("testdir").size() == 1, "");
+		HL_UT_ASSERT(hdir::files("testdir").size() == 1, "");
+		HL_UT_ASSERT(hpathcache::getHits() >= 2, "");
+		HL_UT_ASSERT(hpathcache::getMisses() >= 2, "");
+		// changes that bypass hltypes are only noticed after invalidation
+		remove(filename.cStr());
+		HL_UT_ASSERT(hfile::exists(filename), "");
+		hpathcache::invalidate(filename);
+		HL_UT_ASSERT(!hfile::exists(filename), "");
+		HL_UT_ASSERT(hdir::files("testdir").size() == 0, "");
+		hfile::create(filename);
+		HL_UT_ASSERT(hfile::exists(filename), "");
+		HL_UT_ASSERT(hfile::rename(filename, "testdir/cache2.txt"), "");
+		HL_UT_ASSERT(!hfile::exists(filename), "");
+		HL_UT_ASSERT(hdir::files("testdir").size() == 1, "");
+		hdir::remove("testdir");
+		HL_UT_ASSERT(!hdir::exists("testdir"), "");
+		HL_UT_ASSERT(!hfile::exists("testdir/cache2.txt"), "");
+		hpathcache::setEnabled(false);
+		hpathcache::setTimeToLive(HL_PATH_CACHE_TIME_TO_LIVE);
+	}
+
+	HL_UT_TEST_FUNCTION(staticPaths)
+	{
+		HL_UT_ASSERT(hdir::normalize("a/b/../c/./d") == "a/c/d", "");
+		HL_UT_ASSERT(hdir::normalize("a//b\\c/") == "a/b/c", "");
+		HL_UT_ASSERT(hdir::normalize("../a/../..") == "../..", "");
+		HL_UT_ASSERT(hdir::normalize("a/..") == ".", "");
+		HL_UT_ASSERT(hdir::normalize("") == "", "");
+		HL_UT_ASSERT(hdir::systemize("a\\b//c") == "a/b/c", "");
+		HL_UT_ASSERT(hdir::joinPath("a/", "/b") == "a/b", "");
+		HL_UT_ASSERT(hdir::joinPath("a", "b") == "a/b", "");
+		HL_UT_ASSERT(hdir::baseName("a/b/c.txt") == "c.txt", "");
+		HL_UT_ASSERT(hdir::baseName("a/b/") == "b", "");
+		HL_UT_ASSERT(hdir::baseDir("a/b/c.txt") == "a/b", "");
+		HL_UT_ASSERT(hdir::baseDir("c.txt") == ".", "");
+		char buffer[32] = "x/./y/../z//file.txt";
+		int size = hdir::normalize(buffer, -1);
+		HL_UT_ASSERT(size == 12 && hstr(buffer) == "x/z/file.txt", "");
+		size = hdir::joinPath(buffer, 32, buffer, "more");
+		HL_UT_ASSERT(size == 17 && hstr(buffer) == "x/z/file.txt/more", "");
+		HL_UT_ASSERT(hdir::joinPath(buffer, 18, buffer, "x") == -1, "");
+		int length = 0;
+		const char* name = hdir::baseName(buffer, size, length);
+		HL_UT_ASSERT(hstr(name, length) == "more", "");
+	}
 }
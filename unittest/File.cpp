@@ -6,9 +6,19 @@
 #endif
 
 #include "harray.h"
+#include "hasyncfile.h"
+#include "hatomicfile.h"
+#include "hdir.h"
 #include "hexception.h"
 #include "hfile.h"
+#include "hgzipstream.h"
+#include "hltypesUtil.h"
+#include "hmappedfile.h"
+#include "hmutex.h"
+#include "hresource.h"
+#include "hstream.h"
 #include "hstring.h"
+#include "hthread.h"
 
 HL_UT_TEST_CLASS(File)
 {
@@ -33,6 +43,90 @@ HL_UT_TEST_CLASS(File)
 		HL_UT_ASSERT(text == "This is a test.22", "write()");
 	}
 
+	HL_UT_TEST_FUNCTION(info)
+	{
+		hstr filename = "test_info.txt";
+		hfile f;
+		f.open(filename, hfaccess::Write);
+		f.write("This is a test.");
+		hfinfo info = f.info();
+		HL_UT_ASSERT(info.size == 15 && info.modificationTime == hfile::hinfo(filename).modificationTime, "");
+		f.close();
+		harray<hstr> filenames;
+		hdir::create("test_info");
+		for_iter (i, 0, 600)
+		{
+			filenames += hsprintf("test_info/%d.txt", i);
+			hfile::hwrite(filenames.last(), hstr(i));
+		}
+		filenames.insertAt(300, filename);
+		filenames += "test_info/does_not_exist.txt";
+		filenames += "does_not_exist/file.txt";
+		harray<hfinfo> infos = hfile::hinfo(filenames);
+		HL_UT_ASSERT(infos.size() == 603 && infos[0].size == 1 && infos[300].size == 15 && infos[301].size == 3 && infos[601].size == -1 && infos[602].size == -1, "");
+		harray<hfinfo> parallelInfos = hfile::hinfo(filenames, 4);
+		HL_UT_ASSERT(parallelInfos.size() == 603 && parallelInfos[300].size == 15 && parallelInfos[600].size == 3 && parallelInfos[602].size == -1, "");
+		hdir::remove("test_info");
+		hfile::remove(filename);
+	}
+
+	HL_UT_TEST_FUNCTION(positional)
+	{
+		hstr filename = "test_positional.txt";
+		hfile f;
+		f.open(filename, hfaccess::ReadWriteCreate);
+		f.write("0123456789");
+		char buffer[16] = {0};
+		HL_UT_ASSERT(f.readAt(3, buffer, 4) == 4 && hstr(buffer, 4) == "3456" && f.position() == 10, "readAt()");
+		HL_UT_ASSERT(f.readAt(8, buffer, 4) == 2 && hstr(buffer, 2) == "89", "readAt()");
+		HL_UT_ASSERT(f.writeAt(2, "ab", 2) == 2 && f.position() == 10 && f.size() == 10, "writeAt()");
+		HL_UT_ASSERT(f.writeAt(12, "XY", 2) == 2 && f.size() == 14, "writeAt()");
+		char first[3] = {0};
+		char second[5] = {0};
+		harray<hiovector> vectors;
+		vectors += hiovector(first, 3);
+		vectors += hiovector(second, 5);
+		f.seek(1, hseek::Start);
+		HL_UT_ASSERT(f.readv(vectors) == 8 && hstr(first, 3) == "1ab" && hstr(second, 5) == "45678" && f.position() == 9, "readv()");
+		HL_UT_ASSERT(f.read(1) == "9", "");
+		HL_UT_ASSERT(f.writev(vectors) == 8 && f.position() == 18 && f.size() == 18, "writev()");
+		HL_UT_ASSERT(f.readAt(0LL, vectors) == 8 && hstr(first, 3) == "01a", "readAt()");
+		f.close();
+		HL_UT_ASSERT(hfile::hread(filename) == "01ab4567891ab45678", "");
+		hfile::remove(filename);
+	}
+
+	HL_UT_TEST_FUNCTION(atomicWrite)
+	{
+		hstr filename = "test_atomic.txt";
+		hfile::hwrite(filename, "old");
+		HL_UT_ASSERT(hfile::writeAtomic(filename, "This is a test.") && hfile::hread(filename) == "This is a test.", "");
+		hatomicfile f(filename);
+		f.write("discarded");
+		HL_UT_ASSERT(f.getTargetFilename() == filename && hfile::exists(f.getFilename()), "");
+		hstr tempFilename = f.getFilename();
+		f.discard();
+		HL_UT_ASSERT(!hfile::exists(tempFilename) && hfile::hread(filename) == "This is a test.", "discard()");
+		f.open(filename);
+		f.write("committed");
+		HL_UT_ASSERT(hfile::hread(filename) == "This is a test.", "");
+		HL_UT_ASSERT(f.commit(hatomicfile::SyncMode::Full) && hfile::hread(filename) == "committed", "commit()");
+		harray<hatomicfile*> files;
+		for_iter (i, 0, 10)
+		{
+			files += new hatomicfile(hsprintf("test_atomic/%d.cfg", i));
+			files[i]->write(hstr(i));
+		}
+		HL_UT_ASSERT(hatomicfile::commit(files), "commit(files)");
+		HL_UT_ASSERT(hdir::files("test_atomic").size() == 10 && hfile::hread("test_atomic/7.cfg") == "7", "commit(files)");
+		foreach (hatomicfile*, it, files)
+		{
+			delete (*it);
+		}
+		hdir::remove("test_atomic");
+		hfile::remove(filename);
+	}
+
 	HL_UT_TEST_FUNCTION(readLine)
 	{
 		hstr filename = "test.txt";
@@ -229,6 +323,20 @@ HL_UT_TEST_CLASS(File)
 		double d = f.loadDouble();
 		bool b = f.loadBool();
 		f.close();
+		HL_UT_ASSERT(!hfile::copy(old_filename, new_filename), "");
+		f.open(old_filename, hfaccess::Write);
+		for_iter (j, 0, 100000)
+		{
+			f.dump(j);
+		}
+		f.close();
+		HL_UT_ASSERT(hfile::copy(old_filename, new_filename, true, true), "");
+		hfinfo oldInfo = hfile::hinfo(old_filename);
+		hfinfo newInfo = hfile::hinfo(new_filename);
+		HL_UT_ASSERT(newInfo.size == 400000 && newInfo.modificationTime == oldInfo.modificationTime, "");
+		f.open(new_filename);
+		HL_UT_ASSERT(f.seek(-4, hseek::End) && f.loadInt32() == 99999, "");
+		f.close();
 		hfile::remove(old_filename);
 		hfile::remove(new_filename);
 		HL_UT_ASSERT(i == 1234, "");
@@ -238,4 +346,336 @@ HL_UT_TEST_CLASS(File)
 		HL_UT_ASSERT(d == 1.23456789999999, "");
 		HL_UT_ASSERT(!b, "");
 	}
+
+	HL_UT_TEST_FUNCTION(sizeTracking)
+	{
+		hstr filename = "test.txt";
+		hfile f;
+		f.open(filename, hfaccess::Write);
+		for_iter (i, 0, 1000)
+		{
+			f.dump(i);
+		}
+		HL_UT_ASSERT(f.size() == 4000 && f.position() == 4000, "");
+		f.seek(8, hseek::Start);
+		f.dump(-1);
+		HL_UT_ASSERT(f.size() == 4000 && f.position() == 12, "");
+		f.seek(0, hseek::End);
+		f.write("end");
+		HL_UT_ASSERT(f.size() == 4003 && f.position() == 4003, "");
+		f.open(filename, hfaccess::ReadAppend);
+		HL_UT_ASSERT(f.size() == 4003, "");
+		f.seek(8, hseek::Start);
+		HL_UT_ASSERT(f.loadInt32() == -1 && f.position() == 12, "");
+		f.seek(0); // switching from reading to writing requires a seek
+		f.write("!");
+		HL_UT_ASSERT(f.size() == 4004 && f.position() == 4004, "");
+		f.close();
+		HL_UT_ASSERT(hfile::hread(filename).endsWith("end!"), "");
+		HL_UT_ASSERT(hfile::hinfo(filename).size == 4004, "");
+		hfile::remove(filename);
+	}
+
+	HL_UT_TEST_FUNCTION(buffered)
+	{
+		hstr filename = "test.txt";
+		hfile f;
+		f.setBufferSize(64);
+		f.open(filename, hfaccess::ReadWriteCreate);
+		for_iter (i, 0, 100)
+		{
+			f.dump(i);
+		}
+		HL_UT_ASSERT(f.size() == 400 && f.position() == 400, "");
+		f.flush();
+		HL_UT_ASSERT(hfile::hinfo(filename).size == 400, "");
+		f.seek(8, hseek::Start);
+		HL_UT_ASSERT(f.loadInt32() == 2 && f.loadInt32() == 3 && f.position() == 16, "");
+		f.seek(-8);
+		HL_UT_ASSERT(f.loadInt32() == 2 && f.position() == 12, "");
+		f.dump(-1);
+		HL_UT_ASSERT(f.position() == 16 && f.loadInt32() == 4, "");
+		f.seek(12, hseek::Start);
+		HL_UT_ASSERT(f.loadInt32() == -1, "");
+		unsigned char data[200];
+		HL_UT_ASSERT(f.readRaw(data, 200) == 200 && data[0] == 4 && f.position() == 216, "");
+		f.seek(0, hseek::End);
+		f.write("end");
+		HL_UT_ASSERT(f.size() == 403 && f.position() == 403, "");
+		f.open(filename, hfaccess::Append);
+		f.write("!!");
+		HL_UT_ASSERT(f.size() == 405 && f.position() == 405, "");
+		f.close();
+		HL_UT_ASSERT(hfile::hread(filename).endsWith("end!!"), "");
+		hfile copy;
+		copy.setBufferSize(16);
+		copy.open("test2.txt", hfaccess::Write);
+		f.open(filename);
+		f.seek(4, hseek::Start);
+		HL_UT_ASSERT(copy.writeRaw(f) == 401 && f.position() == 4, "");
+		copy.open("test2.txt");
+		HL_UT_ASSERT(copy.size() == 401 && hcrc32(&copy) == hcrc32(&f), "");
+		copy.close();
+		f.close();
+		hfile::remove("test2.txt");
+		hfile::remove(filename);
+	}
+
+	HL_UT_TEST_FUNCTION(mapped)
+	{
+		hstr filename = "test.txt";
+		hfile::hwrite(filename, "This is a test.");
+		hmappedfile f;
+		f.open(filename);
+		HL_UT_ASSERT(f.size() == 15 && f.isNullTerminated(), "");
+		HL_UT_ASSERT(hstr((const char*)f, 4) == "This" && f[-1] == '.', "");
+		HL_UT_ASSERT(f.read(5) == "This " && f.position() == 5, "");
+		HL_UT_ASSERT(hcrc32(&f) == hcrc32((const unsigned char*)"is a test.", 10), "");
+		HL_UT_ASSERT(f.seek(-5, hseek::End) && f.read() == "test.", "");
+		HL_UT_ASSERT(f.seek(10) && f.position() == 25 && f.read() == "", "");
+		HL_UT_ASSERT(f.seek(10, hseek::End) && f.read(5) == "" && f.position() == 25, "");
+		HL_UT_ASSERT(!f.seek(-100) && f.position() == 25, "");
+		bool exception = false;
+		try
+		{
+			f.write("x");
+		}
+		catch (hexception&)
+		{
+			exception = true;
+		}
+		HL_UT_ASSERT(exception, "");
+		f.open(filename, true);
+		f.getData()[0] = 't';
+		HL_UT_ASSERT(f.read(4) == "this", "");
+		f.close();
+		HL_UT_ASSERT(hfile::hread(filename) == "This is a test.", "");
+		hfile::createNew(filename);
+		f.open(filename);
+		HL_UT_ASSERT(f.size() == 0 && f.isNullTerminated() && f.read() == "", "");
+		f.close();
+		hfile::remove(filename);
+	}
+
+	static int asyncCallbacks;
+	static hmutex asyncMutex;
+
+	static void asyncCallback(hasyncrequest* request)
+	{
+		hmutex::ScopeLock lock(&asyncMutex);
+		++asyncCallbacks;
+	}
+
+	static void asyncDeleteCallback(hasyncrequest* request)
+	{
+		delete request;
+		asyncCallback(NULL);
+	}
+
+	static bool asyncWaitCallbacks(int count)
+	{
+		hmutex::ScopeLock lock;
+		for_iter (i, 0, 1000)
+		{
+			lock.acquire(&asyncMutex);
+			if (asyncCallbacks >= count)
+			{
+				return true;
+			}
+			lock.release();
+			hthread::sleep(10.0f);
+		}
+		return false;
+	}
+
+	HL_UT_TEST_FUNCTION(async)
+	{
+		asyncCallbacks = 0;
+		hstr filename = "test.txt";
+		hasyncrequest* request = hfile::hwriteAsync(filename, "This is a test.", &asyncCallback);
+		HL_UT_ASSERT(request->wait() && request->isCompleted() && hfile::hread(filename) == "This is a test.", "");
+		delete request;
+		request = hfile::happendAsync(filename, "\nline 2", &asyncCallback);
+		request->wait();
+		delete request;
+		harray<hstr> filenames;
+		filenames += filename;
+		filenames += "does_not_exist.txt";
+		filenames += filename;
+		harray<hasyncrequest*> requests = hasyncfile::readAsync(filenames, &asyncCallback);
+		hasyncfile::wait(requests);
+		HL_UT_ASSERT(requests[0]->isCompleted() && requests[0]->getStream().read() == "This is a test.\nline 2", "");
+		HL_UT_ASSERT(requests[1]->getState() == hasyncrequest::State::Failed && requests[1]->getErrorMessage() != "", "");
+		HL_UT_ASSERT(requests[2]->isCompleted() && requests[2]->getStream().size() == 22 && asyncWaitCallbacks(5), "");
+		foreach (hasyncrequest*, it, requests)
+		{
+			delete (*it);
+		}
+		hfile::hreadAsync(filename, &asyncDeleteCallback);
+		HL_UT_ASSERT(asyncWaitCallbacks(6), "");
+		hasyncfile::finalize();
+		hasyncfile::setThreadCount(1);
+		request = hfile::hreadAsync(filename);
+		filenames.clear();
+		filenames.add(filename, 100);
+		requests = hasyncfile::readAsync(filenames);
+		HL_UT_ASSERT(hasyncfile::cancel(requests) > 0 && requests.last()->getState() == hasyncrequest::State::Cancelled, "");
+		HL_UT_ASSERT(request->wait() && request->getStream().readLine() == "This is a test.", "");
+		delete request;
+		foreach (hasyncrequest*, it, requests)
+		{
+			delete (*it);
+		}
+		hasyncfile::finalize();
+		hasyncfile::setThreadCount(HL_ASYNC_FILE_THREAD_COUNT);
+		hfile::remove(filename);
+	}
+
+#ifdef _ZIPRESOURCE
+	static void _zipAdd(hstream& archive, hstream& directory, chstr name, hstream& content, bool deflate)
+	{
+		hstream gzipped;
+		hgzipstream* gzip = new hgzipstream(&gzipped, hgzipstream::Mode::Compress);
+		content.rewind();
+		gzip->writeRaw(content);
+		delete gzip;
+		// gzip data is raw deflate data between a 10 byte header and an 8 byte trailer that starts with the CRC
+		gzipped.seek(-8, hseek::End);
+		unsigned int crc = gzipped.loadUint32();
+		unsigned int compressedSize = (deflate ? (unsigned int)gzipped.size() - 18 : (unsigned int)content.size());
+		unsigned short method = (deflate ? 8 : 0);
+		unsigned int offset = (unsigned int)archive.size();
+		archive.dump((unsigned int)0x04034B50);
+		archive.dump((unsigned short)20); // version needed
+		archive.dump((unsigned short)0); // flags
+		archive.dump(method);
+		archive.dump((unsigned int)0); // time and date
+		archive.dump(crc);
+		archive.dump(compressedSize);
+		archive.dump((unsigned int)content.size());
+		archive.dump((unsigned short)name.size());
+		archive.dump((unsigned short)0); // extra field size
+		archive.write(name);
+		if (deflate)
+		{
+			gzipped.seek(10, hseek::Start);
+			archive.writeRaw(gzipped, compressedSize);
+		}
+		else
+		{
+			content.rewind();
+			archive.writeRaw(content);
+		}
+		directory.dump((unsigned int)0x02014B50);
+		directory.dump((unsigned short)20); // version made by
+		directory.dump((unsigned short)20); // version needed
+		directory.dump((unsigned short)0); // flags
+		directory.dump(method);
+		directory.dump((unsigned int)0); // time and date
+		directory.dump(crc);
+		directory.dump(compressedSize);
+		directory.dump((unsigned int)content.size());
+		directory.dump((unsigned short)name.size());
+		directory.dump((unsigned int)0); // extra field and comment size
+		directory.dump((unsigned int)0); // disk number and internal attributes
+		directory.dump((unsigned int)0); // external attributes
+		directory.dump(offset);
+		directory.write(name);
+	}
+
+	static bool _zipCompare(chstr name, hstream& content)
+	{
+		hresource file;
+		file.open(name);
+		content.rewind();
+		if (file.size() != content.size() || file.read() != content.read())
+		{
+			return false;
+		}
+		unsigned char buffer[4096];
+		int64_t position = 0;
+		int size = 0;
+		for_iter (i, 0, 200)
+		{
+			// forward, backward and far seeks in every seek mode
+			position = hrand((int)content.size() + 1);
+			if (i % 3 == 0)
+			{
+				file.seek(position, hseek::Start);
+			}
+			else if (i % 3 == 1)
+			{
+				file.seek(position - file.position(), hseek::Current);
+			}
+			else
+			{
+				file.seek(position - content.size(), hseek::End);
+			}
+			size = (int)hmin((int64_t)hrand(sizeof(buffer) + 1), content.size() - position);
+			if (file.position() != position || file.readRaw(buffer, size) != size || memcmp(buffer, &content[position], size) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	HL_UT_TEST_FUNCTION(zipResource)
+	{
+		hstream large;
+		for_iter (i, 0, 200000)
+		{
+			large.write(hsprintf("%d:%d\n", i, hrand(1000000)));
+		}
+		hstream stored;
+		for_iter (i, 0, 100000)
+		{
+			stored.dump((unsigned char)hrand(256));
+		}
+		hstream empty;
+		hstream archive;
+		hstream directory;
+		_zipAdd(archive, directory, "large.txt", large, true);
+		_zipAdd(archive, directory, "stored.bin", stored, false);
+		_zipAdd(archive, directory, "empty.txt", empty, true);
+		unsigned int directoryOffset = (unsigned int)archive.size();
+		directory.rewind();
+		archive.writeRaw(directory);
+		archive.dump((unsigned int)0x06054B50);
+		archive.dump((unsigned int)0); // disk numbers
+		archive.dump((unsigned short)3);
+		archive.dump((unsigned short)3);
+		archive.dump((unsigned int)directory.size());
+		archive.dump(directoryOffset);
+		archive.dump((unsigned short)0); // comment size
+		hstr filename = "test.zip";
+		hfile file;
+		file.open(filename, hfaccess::Write);
+		archive.rewind();
+		file.writeRaw(archive);
+		file.close();
+		HL_UT_ASSERT(hresource::mountArchive("", filename), "");
+		HL_UT_ASSERT(_zipCompare("large.txt", large) && _zipCompare("stored.bin", stored) && _zipCompare("empty.txt", empty), "");
+		hresource::unmountArchive("");
+		// flipping a byte in the compressed data has to be detected
+		((unsigned char*)archive)[30 + 9 + 1000] ^= 0xFF;
+		file.open(filename, hfaccess::Write);
+		archive.rewind();
+		file.writeRaw(archive);
+		file.close();
+		HL_UT_ASSERT(hresource::mountArchive("", filename), "");
+		bool exception = false;
+		try
+		{
+			hresource::hread("large.txt");
+		}
+		catch (hexception&)
+		{
+			exception = true;
+		}
+		HL_UT_ASSERT(exception, "");
+		hresource::unmountArchive("");
+		hfile::remove(filename);
+	}
+#endif
 }
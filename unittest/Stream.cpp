@@ -6,8 +6,14 @@
 #endif
 
 #include "harray.h"
+#include "hdeflatestream.h"
+#include "hencoding.h"
 #include "hexception.h"
+#include "hgzipstream.h"
+#include "hlinereader.h"
+#include "hsegmentedstream.h"
 #include "hstream.h"
+#include "hstreamview.h"
 #include "hstring.h"
 
 HL_UT_TEST_CLASS(Stream)
@@ -141,4 +147,321 @@ HL_UT_TEST_CLASS(Stream)
 		HL_UT_ASSERT(d == 1.23456789999999, "");
 		HL_UT_ASSERT(!b, "");
 	}
+
+	HL_UT_TEST_FUNCTION(encoding)
+	{
+		hstream s;
+		s.write("prefix:foobar");
+		s.seek(7, hseek::Start);
+		HL_UT_ASSERT(hhexEncode(&s) == "666F6F626172", "");
+		HL_UT_ASSERT(hbase64Encode(&s, 4) == "Zm9vYg==", "");
+		HL_UT_ASSERT(hbase64Encode((hltypes::StreamBase*)&s) == "Zm9vYmFy", "");
+		HL_UT_ASSERT(s.position() == 7, "");
+		hstream d;
+		d.write("x");
+		HL_UT_ASSERT(hbase64Decode(hstr("Zm9vYmFy"), &d) && hhexDecode(hstr("2122"), &d), "");
+		HL_UT_ASSERT(d.size() == 9 && d.position() == 9, "");
+		HL_UT_ASSERT(!hbase64Decode(hstr("Zm9*"), &d) && d.size() == 9 && d.position() == 9, "");
+		d.seek(1, hseek::Start);
+		HL_UT_ASSERT(!hhexDecode(hstr("41424g"), &d) && d.size() == 9 && d.position() == 1, "");
+		d.rewind();
+		HL_UT_ASSERT(d.read() == "xfoobar!\"", "");
+		d.seek(7, hseek::Start);
+		HL_UT_ASSERT(hhexDecode(hstr("414243"), &d) && d.size() == 10 && d.position() == 10, "");
+		d.rewind();
+		HL_UT_ASSERT(d.read() == "xfoobarABC", "");
+	}
+
+	HL_UT_TEST_FUNCTION(lineReader)
+	{
+		hstream s;
+		s.write("first\r\n\n");
+		s.write(hstr('x', 1000));
+		s.write("\nlast");
+		s.rewind();
+		hlinereader reader(&s, "\n", 16);
+		hstr line;
+		HL_UT_ASSERT(reader.next(line) && line == "first", "");
+		HL_UT_ASSERT(reader.next(line) && line == "", "");
+		HL_UT_ASSERT(reader.position() == 8, "");
+		const char* data = NULL;
+		int size = 0;
+		HL_UT_ASSERT(reader.next(data, size) && size == 1000 && hstr(data, size) == hstr('x', 1000), "");
+		HL_UT_ASSERT(reader.next(line) && line == "last", "");
+		HL_UT_ASSERT(!reader.next(line) && reader.position() == s.size(), "");
+		hstream t;
+		t.write("a--b---c");
+		t.rewind();
+		hlinereader dashReader(&t, "--", 1);
+		HL_UT_ASSERT(dashReader.next(line) && line == "a", "");
+		HL_UT_ASSERT(dashReader.next(line) && line == "b", "");
+		HL_UT_ASSERT(dashReader.next(line) && line == "-c", "");
+		HL_UT_ASSERT(!dashReader.next(line), "");
+		t.clear();
+		t.write("a\r\nb\n");
+		t.rewind();
+		harray<hstr> lines = t.readLines();
+		HL_UT_ASSERT(lines.size() == 3 && lines[0] == "a" && lines[1] == "b" && lines[2] == "", "");
+		t.write("c");
+		t.rewind();
+		lines = t.readLines();
+		HL_UT_ASSERT(lines.size() == 3 && lines[2] == "c", "");
+	}
+
+	HL_UT_TEST_FUNCTION(arrays)
+	{
+		hstream s;
+		float floats[4] = { 1.0f, -2.5f, 3.25f, 1000000.0f };
+		short shorts[3] = { -1, 2, 30000 };
+		HL_UT_ASSERT(s.dumpArray(floats, 4) == 4 && s.dumpArray(shorts, 3) == 3, "");
+		harray<int> ints;
+		ints += 7;
+		ints += -8;
+		ints += 2000000000;
+		s.dumpArray(ints);
+		HL_UT_ASSERT(s.size() == 16 + 6 + 4 + 12, "");
+		s.rewind();
+		HL_UT_ASSERT(s.loadFloat() == 1.0f, "");
+		s.rewind();
+		float loadedFloats[4] = { 0.0f };
+		short loadedShorts[3] = { 0 };
+		harray<int> loadedInts;
+		HL_UT_ASSERT(s.loadArray(loadedFloats, 4) == 4 && memcmp(floats, loadedFloats, sizeof(floats)) == 0, "");
+		HL_UT_ASSERT(s.loadArray(loadedShorts, 3) == 3 && memcmp(shorts, loadedShorts, sizeof(shorts)) == 0, "");
+		HL_UT_ASSERT(s.loadArray(loadedInts) == 3 && loadedInts == ints, "");
+		s.seek(-8);
+		HL_UT_ASSERT(s.loadArray(loadedShorts, 3) == 3 && loadedShorts[0] == -8 && loadedShorts[1] == -1, "");
+		HL_UT_ASSERT(s.loadArray(loadedShorts, 3) == 1 && s.eof(), "");
+		// a corrupted size doesn't allocate memory for data that isn't there
+		s.clear();
+		s.dump(0x7FFFFFFF);
+		s.dumpArray((const int*)ints, 3);
+		s.rewind();
+		HL_UT_ASSERT(s.loadArray(loadedInts) == 3 && loadedInts == ints, "");
+		harray<int> manyInts;
+		for_iter (i, 0, 50000)
+		{
+			manyInts += i;
+		}
+		s.clear();
+		s.dumpArray(manyInts);
+		s.rewind();
+		HL_UT_ASSERT(s.loadArray(loadedInts) == 50000 && loadedInts == manyInts, "");
+	}
+
+	HL_UT_TEST_FUNCTION(compact)
+	{
+		hstream s;
+		s.dumpVarint(0ULL);
+		s.dumpVarint(127ULL);
+		s.dumpVarint(300ULL);
+		s.dumpVarint(0xFFFFFFFFFFFFFFFFULL);
+		HL_UT_ASSERT(s.size() == 1 + 1 + 2 + 10, "");
+		s.dumpSignedVarint(-1LL);
+		s.dumpSignedVarint(63LL);
+		s.dumpSignedVarint(-64LL);
+		s.dumpSignedVarint((int64_t)(-0x7FFFFFFFFFFFFFFFLL - 1));
+		HL_UT_ASSERT(s.size() == 14 + 1 + 1 + 1 + 10, "");
+		s.dumpCompactString("short");
+		s.dumpCompactString(hstr('x', 200));
+		HL_UT_ASSERT(s.size() == 27 + 6 + 202, "");
+		bool flags[10] = { true, false, true, true, false, false, false, true, false, true };
+		s.dumpBitfield(flags, 10);
+		HL_UT_ASSERT(s.size() == 235 + 2, "");
+		s.rewind();
+		HL_UT_ASSERT(s.loadVarint() == 0ULL && s.loadVarint() == 127ULL && s.loadVarint() == 300ULL, "");
+		HL_UT_ASSERT(s.loadVarint() == 0xFFFFFFFFFFFFFFFFULL, "");
+		HL_UT_ASSERT(s.loadSignedVarint() == -1LL && s.loadSignedVarint() == 63LL && s.loadSignedVarint() == -64LL, "");
+		HL_UT_ASSERT(s.loadSignedVarint() == (int64_t)(-0x7FFFFFFFFFFFFFFFLL - 1), "");
+		HL_UT_ASSERT(s.loadCompactString() == "short" && s.loadCompactString() == hstr('x', 200), "");
+		bool loadedFlags[10] = { false };
+		HL_UT_ASSERT(s.loadBitfield(loadedFlags, 10) == 10 && memcmp(flags, loadedFlags, sizeof(flags)) == 0 && s.eof(), "");
+		s.clear();
+		s.dumpVarint(300ULL);
+		s.truncate(1);
+		s.rewind();
+		bool exception = false;
+		try
+		{
+			s.loadVarint();
+		}
+		catch (hexception&)
+		{
+			exception = true;
+		}
+		HL_UT_ASSERT(exception, "truncated varint");
+		s.clear();
+		s.write(hstr((char)0x80, 11));
+		s.rewind();
+		exception = false;
+		try
+		{
+			s.loadCompactString();
+		}
+		catch (hexception&)
+		{
+			exception = true;
+		}
+		HL_UT_ASSERT(exception, "overlong varint");
+	}
+
+	HL_UT_TEST_FUNCTION(segmented)
+	{
+		hsegstream s(64);
+		for_iter (i, 0, 100)
+		{
+			s.dump(i);
+		}
+		HL_UT_ASSERT(s.size() == 400 && s.position() == 400, "");
+		HL_UT_ASSERT(s.getSegmentCount() == 7 && s.getSegmentDataSize(5) == 64 && s.getSegmentDataSize(6) == 16, "");
+		s.seek(60, hseek::Start);
+		HL_UT_ASSERT(s.loadInt32() == 15 && s.loadInt32() == 16, "");
+		s.seek(-6);
+		s.dump(-1);
+		s.rewind();
+		hstream flat;
+		HL_UT_ASSERT(s.flatten(flat) && flat.size() == 400, "");
+		flat.seek(62, hseek::Start);
+		HL_UT_ASSERT(flat.loadInt32() == -1 && flat.seek(68, hseek::Start) && flat.loadInt32() == 17, "");
+		unsigned char data[400];
+		s.flatten(data);
+		HL_UT_ASSERT(memcmp(data, (unsigned char*)flat, 400) == 0, "");
+		hstream reserved(10000);
+		HL_UT_ASSERT(s.flatten(reserved) && reserved.size() == 400 && reserved.getCapacity() == 10000, "");
+		flat.rewind();
+		hsegstream copy(100);
+		HL_UT_ASSERT(copy.writeRaw((hsbase&)flat) == 400 && flat.position() == 0, "");
+		copy.rewind();
+		flat.seek(4, hseek::Start);
+		HL_UT_ASSERT(copy.loadInt32() == 0 && hcrc32(&copy) == hcrc32(&flat), "");
+		HL_UT_ASSERT(s.truncate(130) && s.getSegmentCount() == 3 && s.size() == 130 && s.position() == 0, "");
+		s.seek(0, hseek::End);
+		s.dump(1234);
+		s.seek(-4);
+		HL_UT_ASSERT(s.loadInt32() == 1234 && s.size() == 134, "");
+		s.clear();
+		HL_UT_ASSERT(s.size() == 0 && s.getSegmentCount() == 0, "");
+	}
+
+	HL_UT_TEST_FUNCTION(largeSizes)
+	{
+		int64_t size = 300000LL;
+		hstream s(size);
+		HL_UT_ASSERT(s.fill(0x5A, size) == size && s.size() == size && s[size - 1] == 0x5A, "");
+		s.seek(1000, hseek::Start);
+		s.dump((unsigned int)0xDEADBEEF);
+		s.rewind();
+		hsegstream segmented(4096);
+		HL_UT_ASSERT(segmented.writeRaw(s) == size && s.position() == 0, "");
+		segmented.rewind();
+		// the StreamBase version reads in blocks while the Stream version uses the data directly
+		HL_UT_ASSERT(hcrc32(&segmented) == hcrc32(&s) && hcrc32((hsbase*)&s) == hcrc32((unsigned char*)s, size), "");
+		HL_UT_ASSERT(segmented.position() == 0 && hcrc32(&segmented, 1004LL) == hcrc32((unsigned char*)s, 1004LL), "");
+		unsigned char* data = (unsigned char*)malloc((size_t)size);
+		HL_UT_ASSERT(s.readRaw(data, size + 10) == size && memcmp(data, (unsigned char*)s, (size_t)size) == 0, "");
+		free(data);
+	}
+
+	HL_UT_TEST_FUNCTION(ownership)
+	{
+		unsigned char* data = (unsigned char*)malloc(32);
+		memcpy(data, "abcdef", 6);
+		hstream s;
+		s.adopt(data, 6, 32);
+		HL_UT_ASSERT((unsigned char*)s == data && s.size() == 6 && s.position() == 0, "");
+		HL_UT_ASSERT(s.read(3) == "abc", "");
+		s.write("XYZ");
+		HL_UT_ASSERT((unsigned char*)s == data && s.size() == 6, "");
+		hstream other;
+		other.write("12");
+		s.swap(other);
+		HL_UT_ASSERT((unsigned char*)other == data && other.size() == 6 && other.position() == 6, "");
+		HL_UT_ASSERT(s.size() == 2 && s.position() == 2, "");
+		unsigned char* released = other.release();
+		HL_UT_ASSERT(released == data && other.size() == 0 && other.position() == 0, "");
+		other.write("ok");
+		HL_UT_ASSERT(other.size() == 2, "");
+		hstreamview view(released, 6);
+		HL_UT_ASSERT(view.size() == 6 && view.read(2) == "ab" && view[-1] == 'Z', "");
+		HL_UT_ASSERT(view.seek(10) && view.position() == 6 && view.read() == "", "");
+		bool exception = false;
+		try
+		{
+			view.write("x");
+		}
+		catch (hexception&)
+		{
+			exception = true;
+		}
+		HL_UT_ASSERT(exception, "");
+		free(released);
+		hstreamview streamView(s);
+		HL_UT_ASSERT((const unsigned char*)streamView == (unsigned char*)s && streamView.read() == "12", "");
+	}
+
+	HL_UT_TEST_FUNCTION(compression)
+	{
+#ifdef _ZIPRESOURCE
+		hstream compressed;
+		hdeflatestream* deflate = new hdeflatestream(&compressed, hdeflatestream::Mode::Compress, HL_DEFLATE_BEST_LEVEL, 1024);
+		for_iter (i, 0, 2000)
+		{
+			deflate->writeLine(hsprintf("line %d", i));
+		}
+		int64_t uncompressedSize = deflate->size();
+		delete deflate;
+		HL_UT_ASSERT(compressed.size() > 0 && compressed.size() < uncompressedSize / 4, "");
+		compressed.rewind();
+		deflate = new hdeflatestream(&compressed, hdeflatestream::Mode::Decompress, HL_DEFLATE_DEFAULT_LEVEL, 1024);
+		HL_UT_ASSERT(deflate->readLine() == "line 0" && deflate->readLine() == "line 1", "");
+		HL_UT_ASSERT(deflate->seek(-10, hseek::End) && deflate->readLine() == "line 1999" && deflate->eof(), "");
+		HL_UT_ASSERT(deflate->size() == uncompressedSize && deflate->isFinished() && compressed.eof(), "");
+		HL_UT_ASSERT(deflate->seek(7, hseek::Start) && deflate->readLine() == "line 1", "");
+		delete deflate;
+		compressed.clear();
+		hgzipstream* gzip = new hgzipstream(&compressed, hgzipstream::Mode::Compress, HL_DEFLATE_FASTEST_LEVEL);
+		gzip->setAutoFlush(true);
+		gzip->write("first");
+		int64_t flushedSize = compressed.size();
+		compressed.rewind();
+		hgzipstream partial(&compressed, hgzipstream::Mode::Decompress);
+		partial.setAllowTruncated(true);
+		HL_UT_ASSERT(partial.read() == "first", "");
+		compressed.seek(0, hseek::End);
+		gzip->write(" second");
+		delete gzip;
+		HL_UT_ASSERT(compressed[0] == 0x1F && compressed[1] == 0x8B && compressed.size() > flushedSize, "");
+		compressed.rewind();
+		gzip = new hgzipstream(&compressed, hgzipstream::Mode::Decompress);
+		HL_UT_ASSERT(gzip->read() == "first second" && gzip->size() == 12, "");
+		delete gzip;
+		hstream truncated;
+		truncated.writeRaw((unsigned char*)compressed, (int)compressed.size() - 10);
+		truncated.rewind();
+		bool exception = false;
+		try
+		{
+			hgzipstream incomplete(&truncated, hgzipstream::Mode::Decompress);
+			incomplete.read();
+		}
+		catch (hexception&)
+		{
+			exception = true;
+		}
+		HL_UT_ASSERT(exception, "");
+		((unsigned char*)compressed)[compressed.size() - 6] ^= 0xFF;
+		compressed.rewind();
+		exception = false;
+		try
+		{
+			hgzipstream corrupted(&compressed, hgzipstream::Mode::Decompress);
+			corrupted.read();
+		}
+		catch (hexception&)
+		{
+			exception = true;
+		}
+		HL_UT_ASSERT(exception, "");
+#endif
+	}
 }
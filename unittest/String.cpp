@@ -6,7 +6,12 @@
 #endif
 
 #include "harray.h"
+#include "hatom.h"
+#include "hencoding.h"
+#include "hmap.h"
 #include "hstring.h"
+#include "hstringbuilder.h"
+#include "hstringkey.h"
 
 HL_UT_TEST_CLASS(String)
 {
@@ -377,6 +382,9 @@ HL_UT_TEST_CLASS(String)
 		hstr s1 = "this is a test";
 		HL_UT_ASSERT(s1.startsWith("this"), "startsWith1");
 		HL_UT_ASSERT(!s1.startsWith("something"), "startsWith2");
+		HL_UT_ASSERT(s1.startsWith(HL_LITERAL("this is")), "startsWith3");
+		HL_UT_ASSERT(!s1.startsWith(HL_LITERAL("this is a test, longer")), "startsWith4");
+		HL_UT_ASSERT(s1.startsWith(hstr("this")) && s1.startsWith(""), "startsWith5");
 	}
 
 	HL_UT_TEST_FUNCTION(endsWith)
@@ -384,6 +392,21 @@ HL_UT_TEST_CLASS(String)
 		hstr s1 = "this is a test";
 		HL_UT_ASSERT(s1.endsWith("test"), "endsWith1");
 		HL_UT_ASSERT(!s1.endsWith("something"), "endsWith2");
+		HL_UT_ASSERT(s1.endsWith(HL_LITERAL("a test")), "endsWith3");
+		HL_UT_ASSERT(!s1.endsWith(HL_LITERAL("longer than this is a test")), "endsWith4");
+		HL_UT_ASSERT(s1.endsWith(hstr("test")) && s1.endsWith(""), "endsWith5");
+	}
+
+	HL_UT_TEST_FUNCTION(comparison)
+	{
+		hstr s1 = "abc";
+		hstr s2 = "abcd";
+		hstr s3 = hstr("abc\0d", 5);
+		HL_UT_ASSERT(s1 < s2 && s2 > s1 && s1 <= s2 && s2 >= s1, "comparison1");
+		HL_UT_ASSERT(hstr("abd") > s2 && s1 <= hstr("abc") && s1 >= hstr("abc"), "comparison2");
+		HL_UT_ASSERT(s1 == "abc" && s1 != "ab" && s1 != "abcd" && s1 != "", "comparison3");
+		HL_UT_ASSERT(s3 != s1 && s3 != "abc" && s1 < s3, "comparison4");
+		HL_UT_ASSERT(s1.hash() == hstr("abc").hash() && s1.hash() != s2.hash(), "comparison5");
 	}
 
 	HL_UT_TEST_FUNCTION(contains)
@@ -460,12 +483,131 @@ HL_UT_TEST_CLASS(String)
 		HL_UT_ASSERT(s1.toHex() == "7468697320697320612074657374", "hex3");
 		HL_UT_ASSERT(s2.isHex(), "hex4");
 		HL_UT_ASSERT(s2.unhex() == 0x74657374, "hex5");
+		HL_UT_ASSERT(hstr("\x80\xFF\x01").toHex() == "80FF01", "hex6");
+		HL_UT_ASSERT(hstr("7fFe").unhex() == 0x7FFE && hstr("7x").unhex() == 0, "hex7");
+	}
+
+	HL_UT_TEST_FUNCTION(encoding)
+	{
+		hstr binary("te\0st\xFF", 6);
+		hstr decoded;
+		HL_UT_ASSERT(hhexEncode(binary) == "7465007374FF", "hexEncode");
+		HL_UT_ASSERT(hhexDecode(hstr("7465007374ff"), decoded) && decoded == binary, "hexDecode1");
+		HL_UT_ASSERT(!hhexDecode(hstr("746"), decoded) && !hhexDecode(hstr("7g"), decoded), "hexDecode2");
+		HL_UT_ASSERT(hbase64Encode(hstr("")) == "" && hbase64Encode(hstr("f")) == "Zg==" && hbase64Encode(hstr("fo")) == "Zm8=", "base64Encode1");
+		HL_UT_ASSERT(hbase64Encode(hstr("foo")) == "Zm9v" && hbase64Encode(hstr("foobar")) == "Zm9vYmFy", "base64Encode2");
+		HL_UT_ASSERT(hbase64Decode(hstr("Zm9vYg=="), decoded) && decoded == "foob", "base64Decode1");
+		HL_UT_ASSERT(hbase64Decode(hstr("Zm9vYmE"), decoded) && decoded == "fooba", "base64Decode2");
+		HL_UT_ASSERT(hbase64Decode(hbase64Encode(binary), decoded) && decoded == binary, "base64Decode3");
+		HL_UT_ASSERT(!hbase64Decode(hstr("Zm9vY"), decoded) && !hbase64Decode(hstr("Zm9*"), decoded) && !hbase64Decode(hstr("Zg="), decoded), "base64Decode4");
+		HL_UT_ASSERT(hpercentEncode(hstr("a b/c~d-e.f_g")) == "a%20b%2Fc~d-e.f_g", "percentEncode1");
+		HL_UT_ASSERT(hpercentEncode(hstr("\xC3\xA4")) == "%C3%A4", "percentEncode2");
+		HL_UT_ASSERT(hpercentDecode(hstr("a%20b%2fc+d"), decoded) && decoded == "a b/c+d", "percentDecode1");
+		HL_UT_ASSERT(!hpercentDecode(hstr("abc%%"), decoded) && !hpercentDecode(hstr("a%2"), decoded) && !hpercentDecode(hstr("%zz"), decoded), "percentDecode2");
+		char buffer[16] = { '\0' };
+		HL_UT_ASSERT(hhexEncode((const unsigned char*)"\x12\xAB", 2, buffer) == 4 && hstr(buffer) == "12AB", "rawBuffer");
 	}
 
 	HL_UT_TEST_FUNCTION(formatting)
 	{
 		hstr text = hsprintf("This is a %d %s %4.2f %s.", 15, "formatted", 3.14f, "text");
 		HL_UT_ASSERT(text == "This is a 15 formatted 3.14 text.", "hsprintf");
+		hstr longText('x', 100000);
+		text = hsprintf("<%s>", longText.cStr());
+		HL_UT_ASSERT(text.size() == 100002 && text.startsWith("<x") && text.endsWith("x>"), "hsprintf long");
+		text = hformat("This is a {} {} {} {}.", 15, "formatted", 3.14f, hstr("text"));
+		HL_UT_ASSERT(text == "This is a 15 formatted 3.140000 text.", "hformat1");
+		text = hformat("{{}} {} }}{{", true);
+		HL_UT_ASSERT(text == "{} true }{", "hformat2");
+		int value = 0;
+		text = hformat("{} {}", &value, (void*)NULL);
+		HL_UT_ASSERT(text == hsprintf("%p %p", &value, (void*)NULL), "hformat3");
+	}
+
+	HL_UT_TEST_FUNCTION(builder)
+	{
+		hstrbuilder builder;
+		builder.add("abc").add('d').add(hstr("ef")).add('-', 3);
+		HL_UT_ASSERT(builder.toString() == "abcdef---", "builder1");
+		builder.clear();
+		builder.add(-15).add(' ').add(42u).add(' ').add((int64_t)-9223372036854775807LL - 1).add(' ').add(true);
+		HL_UT_ASSERT(builder.toString() == "-15 42 -9223372036854775808 true", "builder2");
+		builder.clear();
+		builder.add(3.14f, 2).add(' ').add(-0.5).add(' ').add(0.125, 2).add(' ').add(2.0, 0);
+		HL_UT_ASSERT(builder.toString() == hsprintf("%.2f %f %.2f %.0f", 3.14f, -0.5, 0.125, 2.0), "builder3");
+		builder.clear();
+		builder.add(-104.848465, 5);
+		HL_UT_ASSERT(builder.toString() == hsprintf("%.5f", -104.848465), "builder3 tie");
+		bool same = true;
+		double value = 0.0;
+		// simple LCG so every run checks the same values
+		unsigned int seed = 12345;
+		unsigned int numerator = 0;
+		for_iter (i, 0, 20000)
+		{
+			seed = seed * 1103515245 + 12345;
+			numerator = seed % 2000000000;
+			seed = seed * 1103515245 + 12345;
+			value = ((int)numerator - 1000000000) / (double)((seed >> 8) % 1000000 + 1);
+			builder.clear();
+			builder.add(value, i % 10);
+			if (builder.toString() != hsprintf("%.*f", i % 10, value))
+			{
+				same = false;
+				break;
+			}
+		}
+		HL_UT_ASSERT(same, "builder3 printf");
+		builder.clear();
+		builder.addHex(0xAB, 4).add(' ').addHex(0);
+		HL_UT_ASSERT(builder.toString() == "00AB 0", "builder4");
+		builder.clear();
+		hstr expected;
+		for_iter (i, 0, 1000)
+		{
+			builder.add(i).add(',');
+			expected += hstr(i) + ",";
+		}
+		HL_UT_ASSERT(builder.size() == expected.size(), "builder5");
+		HL_UT_ASSERT(builder.toString() == expected, "builder6");
+		harray<int> values;
+		values += 1;
+		values += 2;
+		values += 3;
+		HL_UT_ASSERT(values.joined(", ") == "1, 2, 3", "builder7");
+	}
+
+	HL_UT_TEST_FUNCTION(stringKey)
+	{
+		hmap<hstrkey, int> a;
+		a["first"] = 1;
+		a[hstr("second")] = 2;
+		a["third"] = 3;
+		HL_UT_ASSERT(a.size() == 3, "");
+		HL_UT_ASSERT(a["first"] == 1 && a["second"] == 2 && a["third"] == 3, "");
+		HL_UT_ASSERT(a.hasKey("second") && !a.hasKey("fourth"), "");
+		HL_UT_ASSERT(hstrkey("second") == hstrkey(hstr("second")), "");
+		HL_UT_ASSERT(hstrkey("second").getString() == "second", "");
+	}
+
+	HL_UT_TEST_FUNCTION(atom)
+	{
+		hatom a1 = "identifier";
+		hatom a2 = hstr("identifier");
+		hatom a3("identifier-other", 10);
+		hatom a4 = "other";
+		HL_UT_ASSERT(a1 == a2 && a1 == a3, "atom1");
+		HL_UT_ASSERT(a1.cStr() == a2.cStr(), "atom2");
+		HL_UT_ASSERT(a1 != a4 && a1.hash() == a3.hash(), "atom3");
+		HL_UT_ASSERT(a1.toString() == "identifier" && a1.size() == 10, "atom4");
+		HL_UT_ASSERT(hatom().isEmpty() && hatom("") == hatom(), "atom5");
+		hatom found;
+		HL_UT_ASSERT(hatom::find("identifier", found) && found == a1, "atom6");
+		HL_UT_ASSERT(!hatom::find("never interned atom", found), "atom7");
+		hmap<hatom, int> values;
+		values[a1] = 1;
+		values[a4] = 2;
+		HL_UT_ASSERT(values[hatom("identifier")] == 1 && values[hatom("other")] == 2, "atom8");
 	}
 
-}
\ No newline at end of file
+}